@@ -18,9 +18,7 @@ layout(binding = 5) uniform sampler2D refractionTexture;
 
 
 struct EntityData {
-    vec4 pos;
-    vec4 rot;
-    vec4 scale;
+    mat4 model;         // World matrix, composed on the CPU by TransformSystem
     vec4 sphereBounds;
     vec4 albedoTint;
     vec4 pbrParams;
@@ -28,8 +26,7 @@ struct EntityData {
     vec4 volumeColor;
     vec4 advancedPbr;  
     vec4 extendedPbr;
-    vec4 padding1;
-    vec4 padding2;
+    vec4 drawParams;
 };
 
 layout(std430, set = 0, binding = 2) readonly buffer ObjectBuffer { 
@@ -56,11 +53,26 @@ layout(set = 0, binding = 3) uniform GlobalUniforms {
     vec4 skyColor;
     vec4 groundColor;
     
-    // --- POINT LIGHTS ---
-    vec4 pointLightParams; // x = count (No stray 'int' variables here!)
-    PointLight pointLights[16];
+    // --- CLUSTERED LIGHTS ---
+    vec4 clusterParams;     // x = near, y = slices / log(far / near), z = visible lights
+    uvec4 clusterGrid;      // xyz = clusters across, down and in depth
 } global;
 
+// --- CLUSTERED POINT LIGHTS ---
+layout(std430, set = 0, binding = 11) readonly buffer LightBuffer { PointLight lights[]; };
+layout(std430, set = 0, binding = 12) readonly buffer ClusterBuffer { uvec2 clusterRanges[]; };   // x = first entry, y = count
+layout(std430, set = 0, binding = 13) readonly buffer ClusterLightBuffer { uint clusterLights[]; };
+
+// Froxel of a world position: screen tile from its clip position, depth slice from clip.w
+uint ClusterIndex(vec3 worldPos) {
+    vec4 clip = global.viewProj * vec4(worldPos, 1.0);
+    float depth = max(clip.w, global.clusterParams.x);
+    vec2 uv = clamp(clip.xy / depth * 0.5 + 0.5, vec2(0.0), vec2(0.9999));
+    uvec2 tile = uvec2(uv * vec2(global.clusterGrid.xy));
+    uint slice = uint(clamp(log(depth / global.clusterParams.x) * global.clusterParams.y, 0.0, float(global.clusterGrid.z - 1u)));
+    return (slice * global.clusterGrid.y + tile.y) * global.clusterGrid.x + tile.x;
+}
+
 // Exponential Height Fog MATH
 vec3 ApplyFog(vec3 rgb, float dist, float worldZ) {
     float fogDensity = global.fogColor.a;
@@ -345,13 +357,15 @@ void main() {
 
     // --- 2. POINT LIGHTS (GGX + CLEARCOAT) ---
     vec3 pointLightAccum = vec3(0.0);
-    int pLightCount = int(global.pointLightParams.x);
-
-    for(int i = 0; i < pLightCount; i++) {
-        vec3 lightPos = global.pointLights[i].positionAndRadius.xyz;
-        float radius = global.pointLights[i].positionAndRadius.w;
-        vec3 lightColor = global.pointLights[i].colorAndIntensity.xyz;
-        float intensity = global.pointLights[i].colorAndIntensity.w;
+    uvec2 cluster = clusterRanges[ClusterIndex(fragPos)];
+
+    // Only the lights binned into this fragment's cluster
+    for(uint c = 0u; c < cluster.y; c++) {
+        PointLight light = lights[clusterLights[cluster.x + c]];
+        vec3 lightPos = light.positionAndRadius.xyz;
+        float radius = light.positionAndRadius.w;
+        vec3 lightColor = light.colorAndIntensity.xyz;
+        float intensity = light.colorAndIntensity.w;
 
         vec3 L_pt = lightPos - fragPos;
         float dist_pt = length(L_pt);
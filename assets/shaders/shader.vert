@@ -20,18 +20,15 @@ layout(location = 7) out vec2 fragTexCoord1;
 
 // --- UPDATED SSBO STRUCT ---
 struct EntityData {
-    vec4 pos;
-    vec4 rot;
-    vec4 scale;
+    mat4 model;         // World matrix, composed on the CPU by TransformSystem
     vec4 sphereBounds;
     vec4 albedoTint;
     vec4 pbrParams;
     vec4 volumeParams;
     vec4 volumeColor;
     vec4 advancedPbr;  
-    vec4 padding0;
-    vec4 padding1;
-    vec4 padding2;
+    vec4 extendedPbr;
+    vec4 drawParams;
 };
 
 // --- BINDING 2: The Object Buffer ---
@@ -39,11 +36,6 @@ layout(std430, set = 0, binding = 2) readonly buffer ObjectBuffer {
     EntityData entities[];
 };
 
-struct PointLight {
-    vec4 positionAndRadius;
-    vec4 colorAndIntensity;
-};
-
 layout(set = 0, binding = 3) uniform GlobalUniforms {
     mat4 viewProj;
     mat4 view;
@@ -59,51 +51,22 @@ layout(set = 0, binding = 3) uniform GlobalUniforms {
     vec4 skyColor;
     vec4 groundColor;
     
-    // --- POINT LIGHTS ---
-    vec4 pointLightParams; // x = count
-    PointLight pointLights[16];
+    // --- CLUSTERED LIGHTS ---
+    vec4 clusterParams;     // x = near, y = slices / log(far / near), z = visible lights
+    uvec4 clusterGrid;      // xyz = clusters across, down and in depth
 } global;
 
-// --- TINY PUSH CONSTANT ---
-layout(push_constant) uniform Constants {
-    uint entityIndex;
-} PushConsts;
-
-// --- HELPER: Build Matrix on GPU ---
-mat4 buildMatrix(vec3 p, vec3 r, vec3 s) {
-    // Precompute Trig for rotation (Euler angles in radians)
-    float cx = cos(r.x); float sx = sin(r.x);
-    float cy = cos(r.y); float sy = sin(r.y);
-    float cz = cos(r.z); float sz = sin(r.z);
-
-    // Rotation Matrix (Z * Y * X order to match GLM)
-    mat3 rotMat;
-    rotMat[0] = vec3(cy*cz, cy*sz, -sy);
-    rotMat[1] = vec3(cz*sx*sy - cx*sz, cx*cz + sx*sy*sz, cy*sx);
-    rotMat[2] = vec3(cx*cz*sy + sx*sz, -cz*sx + cx*sy*sz, cx*cy);
-
-    // Combine Scale -> Rotation -> Translation
-    mat4 m = mat4(1.0);
-    
-    // Columns (Vectors)
-    m[0] = vec4(rotMat[0] * s.x, 0.0);
-    m[1] = vec4(rotMat[1] * s.y, 0.0);
-    m[2] = vec4(rotMat[2] * s.z, 0.0);
-    m[3] = vec4(p, 1.0);
-
-    return m;
-}
+// --- BINDING 10: Instance rows ---
+// One entity row per instance: CPU batches fill the front, the GPU culler the rest
+layout(std430, set = 0, binding = 10) readonly buffer InstanceBuffer {
+    uint instanceRows[];
+};
 
 void main() {
-    uint id = PushConsts.entityIndex;
+    uint id = instanceRows[gl_InstanceIndex];
     
-    // 1. Fetch raw pos/rot/scale from SSBO
-    vec3 p = entities[id].pos.xyz;
-    vec3 r = entities[id].rot.xyz;
-    vec3 s = entities[id].scale.xyz;
-
-    // 2. Build Matrix on the fly
-    mat4 model = buildMatrix(p, r, s);
+    // 1-2. World matrix comes ready-made from the SSBO
+    mat4 model = entities[id].model;
     
     // 3. Standard Transform
     vec4 worldPos = model * vec4(inPosition, 1.0);
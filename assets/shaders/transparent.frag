@@ -17,9 +17,7 @@ layout(binding = 4) uniform sampler2DArrayShadow shadowMap;
 layout(binding = 5) uniform sampler2D refractionTexture;
 
 struct EntityData {
-    vec4 pos;
-    vec4 rot;
-    vec4 scale;
+    mat4 model;         // World matrix, composed on the CPU by TransformSystem
     vec4 sphereBounds;
     vec4 albedoTint;
     vec4 pbrParams;
@@ -27,19 +25,13 @@ struct EntityData {
     vec4 volumeColor;
     vec4 advancedPbr;  
     vec4 extendedPbr;
-    vec4 padding1;
-    vec4 padding2;
+    vec4 drawParams;
 };
 
 layout(std430, set = 0, binding = 2) readonly buffer ObjectBuffer { 
     EntityData entities[];
 };
 
-struct PointLight {
-    vec4 positionAndRadius;
-    vec4 colorAndIntensity;
-};
-
 layout(set = 0, binding = 3) uniform GlobalUniforms {
     mat4 viewProj;
     mat4 view;
@@ -54,8 +46,9 @@ layout(set = 0, binding = 3) uniform GlobalUniforms {
     vec4 fogParams;
     vec4 skyColor;
     vec4 groundColor;
-    vec4 pointLightParams;
-    PointLight pointLights[16];
+    // --- CLUSTERED LIGHTS ---
+    vec4 clusterParams;     // x = near, y = slices / log(far / near), z = visible lights
+    uvec4 clusterGrid;      // xyz = clusters across, down and in depth
 } global;
 
 vec2 EquirectangularUV(vec3 v) {
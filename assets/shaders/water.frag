@@ -14,9 +14,9 @@ layout(binding = 0) uniform sampler2D texSampler[100];
 layout(binding = 1) uniform samplerCube skyTexture;
 
 struct EntityData {
-    vec4 pos; vec4 rot; vec4 scale; vec4 sphereBounds;
+    mat4 model; vec4 sphereBounds;
     vec4 albedoTint; vec4 pbrParams; vec4 volumeParams; vec4 volumeColor;
-    vec4 advancedPbr; vec4 extendedPbr; vec4 padding1; vec4 padding2;
+    vec4 advancedPbr; vec4 extendedPbr; vec4 drawParams;
 };
 layout(std430, set = 0, binding = 2) readonly buffer ObjectBuffer { EntityData entities[]; };
 
@@ -28,8 +28,6 @@ layout(set = 0, binding = 3) uniform GlobalUniforms {
 
 layout(binding = 5) uniform sampler2D refractionMap;
 
-layout(push_constant) uniform Constants { uint entityIndex; } PushConsts;
-
 void main() {
     EntityData ent = entities[inEntityIndex];
     float roughness = ent.pbrParams.x;
@@ -15,9 +15,9 @@ layout(location = 4) out vec4 fragClipSpace; // CRITICAL FOR REFRACTION
 layout(location = 6) out flat int outEntityIndex;
 
 struct EntityData {
-    vec4 pos; vec4 rot; vec4 scale; vec4 sphereBounds;
+    mat4 model; vec4 sphereBounds;
     vec4 albedoTint; vec4 pbrParams; vec4 volumeParams; vec4 volumeColor;
-    vec4 advancedPbr; vec4 extendedPbr; vec4 padding1; vec4 padding2;
+    vec4 advancedPbr; vec4 extendedPbr; vec4 drawParams;
 };
 layout(std430, set = 0, binding = 2) readonly buffer ObjectBuffer { EntityData entities[]; };
 
@@ -27,31 +27,11 @@ layout(set = 0, binding = 3) uniform GlobalUniforms {
     vec4 params; vec4 fogColor; vec4 fogParams; vec4 skyColor; vec4 groundColor;
 } global;
 
-layout(push_constant) uniform Constants { uint entityIndex; } PushConsts;
-
-mat4 buildMatrix(vec3 p, vec3 r, vec3 s) {
-    float cx = cos(r.x); float sx = sin(r.x);
-    float cy = cos(r.y); float sy = sin(r.y);
-    float cz = cos(r.z); float sz = sin(r.z);
-    mat3 rotMat;
-    rotMat[0] = vec3(cy*cz, cy*sz, -sy);
-    rotMat[1] = vec3(cz*sx*sy - cx*sz, cx*cz + sx*sy*sz, cy*sx);
-    rotMat[2] = vec3(cx*cz*sy + sx*sz, -cz*sx + cx*sy*sz, cx*cy);
-    mat4 m = mat4(1.0);
-    m[0] = vec4(rotMat[0] * s.x, 0.0);
-    m[1] = vec4(rotMat[1] * s.y, 0.0);
-    m[2] = vec4(rotMat[2] * s.z, 0.0);
-    m[3] = vec4(p, 1.0);
-    return m;
-}
+layout(std430, set = 0, binding = 10) readonly buffer InstanceBuffer { uint instanceRows[]; };
 
 void main() {
-    uint id = PushConsts.entityIndex;
-    vec3 p = entities[id].pos.xyz;
-    vec3 r = entities[id].rot.xyz;
-    vec3 s = entities[id].scale.xyz;
-
-    mat4 model = buildMatrix(p, r, s);
+    uint id = instanceRows[gl_InstanceIndex];
+    mat4 model = entities[id].model;
     float time = global.params.x;
 
     // --- PLANETARY WAVES ---
@@ -7,8 +7,11 @@
 #include "servers/physics/PhysicsServer.hpp"
 #include "scene/components/TransformComponent.hpp"
 #include "scene/components/MeshRendererComponent.hpp"
+#include "scene/TransformSystem.hpp"
 #include "tiny_gltf.h"
 #include "deps/xatlas.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
@@ -93,22 +96,28 @@ namespace Crescendo {
 
     }
 
-    void AssetLoader::loadModel(RenderingServer* renderer, const std::string& filePath, Scene* scene) {
+    CBaseEntity* AssetLoader::loadModel(RenderingServer* renderer, const std::string& filePath, Scene* scene) {
         std::ifstream f(filePath.c_str());
         if (!f.good()) {
             std::cerr << "[Error] File not found: " << filePath << std::endl;
-            return;
+            return nullptr;
         }
 
         if (filePath.find(".glb") != std::string::npos || filePath.find(".gltf") != std::string::npos) {
-            loadGLTF(renderer, filePath, scene); 
+            // Headless: no uploads, the entities still get their transforms, bounds and colliders
+            if (!renderer) return loadGLTF(nullptr, filePath, scene);
+
+            // Uploads and table growth can't overlap the render thread recording a frame
+            std::lock_guard<std::mutex> resources(renderer->resourceMutex);
+            return loadGLTF(renderer, filePath, scene); 
         } else if (filePath.find(".obj") != std::string::npos) {
             std::cout << "[Loader] OBJ loading not yet refactored." << std::endl;
         }
+        return nullptr;
     }
 
-    void AssetLoader::loadGLTF(RenderingServer* renderer, const std::string& filePath, Scene* scene) {
-        if (scene == nullptr) return;
+    CBaseEntity* AssetLoader::loadGLTF(RenderingServer* renderer, const std::string& filePath, Scene* scene) {
+        if (scene == nullptr) return nullptr;
 
         tinygltf::Model model;
         tinygltf::TinyGLTF loader;
@@ -118,7 +127,7 @@ namespace Crescendo {
                    loader.LoadBinaryFromFile(&model, &err, &warn, filePath) : 
                    loader.LoadASCIIFromFile(&model, &err, &warn, filePath);
 
-        if (!ret) { std::cerr << "[GLTF Error] " << err << std::endl; return; }
+        if (!ret) { std::cerr << "[GLTF Error] " << err << std::endl; return nullptr; }
 
         std::string baseDir = "";
         size_t lastSlash = filePath.find_last_of("/\\");
@@ -220,44 +229,47 @@ namespace Crescendo {
                 std::string meshKey = baseDir + "_mesh_" + std::to_string(i) + "_" + std::to_string(j); 
 
                 // --- VMA UPLOAD ---
-                MeshResource newMesh{};
-                newMesh.name = meshKey;
-                newMesh.indexCount = static_cast<uint32_t>(indices.size());
-                newMesh.vertexBuffer = renderer->createVertexBuffer(vertices);
-                newMesh.indexBuffer = renderer->createIndexBuffer(indices);
-
-                size_t globalIndex = renderer->meshes.size();
-                renderer->meshes.push_back(std::move(newMesh));
-                renderer->meshMap[meshKey] = globalIndex;
+                if (renderer) {
+                    MeshResource newMesh{};
+                    newMesh.name = meshKey;
+                    newMesh.indexCount = static_cast<uint32_t>(indices.size());
+                    newMesh.geometry = renderer->uploadGeometry(vertices, indices);
+                    newMesh.bounds = MeshBounds::FromVertices(vertices);
+
+                    size_t globalIndex = renderer->meshes.size();
+                    renderer->meshes.push_back(std::move(newMesh));
+                    renderer->meshMap[meshKey] = globalIndex;
+                }
 
                 rawMeshes[meshKey] = {vertices, indices};
             }
         }
 
+        CBaseEntity* firstRoot = nullptr;
         const auto& gltfScene = model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
         for (int nodeIdx : gltfScene.nodes) {
             // stop fucking breaking god damnit
-            processGLTFNode(renderer, model, model.nodes[nodeIdx], nullptr, baseDir, filePath, scene, glm::mat4(1.0f), rawMeshes);
+            CBaseEntity* root = processGLTFNode(renderer, model, model.nodes[nodeIdx], nullptr, baseDir, filePath, scene, glm::mat4(1.0f), rawMeshes);
+            if (!firstRoot) firstRoot = root;
         }
+        return firstRoot;
     }
 
-    void AssetLoader::processGLTFNode(RenderingServer* renderer, tinygltf::Model& model, tinygltf::Node& node, CBaseEntity* parent, const std::string& baseDir, const std::string& filePath, Scene* scene, glm::mat4 parentMatrix, RawMeshMap& rawMeshes) {
-        if (!scene) return; 
+    CBaseEntity* AssetLoader::processGLTFNode(RenderingServer* renderer, tinygltf::Model& model, tinygltf::Node& node, CBaseEntity* parent, const std::string& baseDir, const std::string& filePath, Scene* scene, glm::mat4 parentMatrix, RawMeshMap& rawMeshes) {
+        if (!scene) return nullptr; 
 
         CBaseEntity* newEnt = scene->CreateEntity("prop_static"); 
         newEnt->targetName = node.name; 
-        newEnt->textureID = 0; 
+        newEnt->Material().textureID = 0; 
         
         newEnt->modelPath = filePath;
 
         newEnt->AddComponent<Crescendo::TransformComponent>();
         newEnt->AddComponent<Crescendo::MeshRendererComponent>();
 
-        // Classic Hierarchy Parenting
+        // Classic Hierarchy Parenting. The node's TRS stays local, TransformSystem composes the world matrix.
         if (parent) {
-            newEnt->moveParent = parent;
-            parent->children.push_back(newEnt);
-            newEnt->origin = parent->origin; 
+            scene->SetParent(newEnt, parent);
         }
 
         glm::vec3 translation(0.0f);
@@ -275,9 +287,9 @@ namespace Crescendo {
             if (node.scale.size() == 3) scale = glm::vec3(node.scale[0], node.scale[1], node.scale[2]);
         }
 
-        newEnt->origin += translation;
-        newEnt->scale = scale;
-        newEnt->angles = glm::degrees(glm::eulerAngles(rotation)); 
+        newEnt->SetOrigin(translation);
+        newEnt->SetScale(scale);
+        newEnt->SetAngles(glm::degrees(glm::eulerAngles(rotation))); 
 
         if (node.mesh > -1) {
             const tinygltf::Mesh& mesh = model.meshes[node.mesh];
@@ -286,22 +298,19 @@ namespace Crescendo {
                 const auto& primitive = mesh.primitives[i];
                 CBaseEntity* targetEnt = (i == 0) ? newEnt : scene->CreateEntity("prop_submesh");
 
+                // Extra primitives ride on the node with an identity local transform
                 if (i > 0) {
-                    targetEnt->moveParent = newEnt;
-                    newEnt->children.push_back(targetEnt);
-                    targetEnt->origin = newEnt->origin; 
-                    targetEnt->angles = newEnt->angles;
-                    targetEnt->scale = newEnt->scale;
+                    scene->SetParent(targetEnt, newEnt);
                 }
 
                 if (primitive.material >= 0) {
                     const tinygltf::Material& mat = model.materials[primitive.material];
                     
-                    targetEnt->roughness = (float)mat.pbrMetallicRoughness.roughnessFactor;
-                    targetEnt->metallic = (float)mat.pbrMetallicRoughness.metallicFactor;
+                    targetEnt->Material().roughness = (float)mat.pbrMetallicRoughness.roughnessFactor;
+                    targetEnt->Material().metallic = (float)mat.pbrMetallicRoughness.metallicFactor;
 
                     if (mat.pbrMetallicRoughness.baseColorFactor.size() == 4) {
-                        targetEnt->albedoColor = glm::vec3(
+                        targetEnt->Material().albedoColor = glm::vec3(
                             (float)mat.pbrMetallicRoughness.baseColorFactor[0],
                             (float)mat.pbrMetallicRoughness.baseColorFactor[1],
                             (float)mat.pbrMetallicRoughness.baseColorFactor[2]
@@ -309,7 +318,7 @@ namespace Crescendo {
                     }
 
                     int texIndex = mat.pbrMetallicRoughness.baseColorTexture.index;
-                    if (texIndex >= 0) {
+                    if (texIndex >= 0 && renderer) {
                         const tinygltf::Texture& tex = model.textures[texIndex];
                         const tinygltf::Image& img = model.images[tex.source];
                         
@@ -318,7 +327,7 @@ namespace Crescendo {
                         else texKey = "EMBEDDED_" + std::to_string(tex.source) + "_" + node.name;
                         
                         if (renderer->textureMap.find(texKey) != renderer->textureMap.end()) {
-                            targetEnt->textureID = renderer->textureMap[texKey];
+                            targetEnt->Material().textureID = renderer->textureMap[texKey];
                         } else {
                             int newID = static_cast<int>(renderer->textureMap.size()) + 1;
                             if (newID < renderer->MAX_TEXTURES) {
@@ -338,7 +347,7 @@ namespace Crescendo {
                                     renderer->textureBank[newID] = std::move(newTex);
                                     renderer->textureMap[texKey] = newID;
                                     renderer->cache.textures[texKey] = newID; 
-                                    targetEnt->textureID = newID;
+                                    targetEnt->Material().textureID = newID;
 
                                     // --- THE FIX: Loop over frames using 'frame', not 'i'! ---
                                     for (size_t frame = 0; frame < renderer->descriptorSets.size(); frame++) {
@@ -362,20 +371,30 @@ namespace Crescendo {
                         }
                     }
                 } else {
-                    targetEnt->textureID = 0;
+                    targetEnt->Material().textureID = 0;
                 }
                 
                 std::string meshKey = normalizePath(baseDir) + "_mesh_" + std::to_string(node.mesh) + "_" + std::to_string(i); 
-                if (renderer->meshMap.find(meshKey) != renderer->meshMap.end()) {
-                    targetEnt->modelIndex = renderer->meshMap[meshKey];
+                // Every primitive loaded above has its raw copy, uploaded or not
+                auto raw = rawMeshes.find(meshKey);
+                if (raw != rawMeshes.end()) {
+                    if (renderer) targetEnt->modelIndex = renderer->meshMap[meshKey];
+
+                    // Local bounding sphere for the spatial index, the same one the uploaded mesh carries
+                    MeshBounds bounds = MeshBounds::FromVertices(raw->second.first);
+                    if (bounds.IsValid()) targetEnt->SetLocalBounds(bounds.sphere);
+
+                    if (scene->physics) {
+                        // Colliders live in world space, resolve the parent chain now rather than waiting a frame
+                        glm::mat4 world = TransformSystem::ComputeWorldMatrix(targetEnt);
+                        glm::vec3 worldScale(glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])));
 
-                    if (scene->physics && rawMeshes.find(meshKey) != rawMeshes.end()) {
                         scene->physics->CreateMeshCollider(
-                            targetEnt->index, 
-                            rawMeshes[meshKey].first, 
-                            rawMeshes[meshKey].second, 
-                            targetEnt->origin, 
-                            targetEnt->scale
+                            targetEnt, 
+                            raw->second.first, 
+                            raw->second.second, 
+                            glm::vec3(world[3]), 
+                            worldScale
                         );
                     }
                 }
@@ -386,5 +405,7 @@ namespace Crescendo {
             // --- FIX: Add filePath to the recursive call ---
             processGLTFNode(renderer, model, model.nodes[childId], newEnt, baseDir, filePath, scene, glm::mat4(1.0f), rawMeshes);
         }
+
+        return newEnt;
     }
 }
\ No newline at end of file
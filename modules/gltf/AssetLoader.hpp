@@ -17,12 +17,14 @@ namespace Crescendo {
 
     class AssetLoader {
     public:
-        static void loadModel(RenderingServer* renderer, const std::string& filePath, Scene* scene);
+        // Returns the first root entity created for the file (nullptr on failure).
+        // Slots are recycled, so callers must not assume it landed at entities.back().
+        static CBaseEntity* loadModel(RenderingServer* renderer, const std::string& filePath, Scene* scene);
 
     private:
-        static void loadGLTF(RenderingServer* renderer, const std::string& filePath, Scene* scene);
+        static CBaseEntity* loadGLTF(RenderingServer* renderer, const std::string& filePath, Scene* scene);
         
         // <-- UPDATE THIS SIGNATURE: Add the 'rawMeshes' map at the end
-        static void processGLTFNode(RenderingServer* renderer, tinygltf::Model& model, tinygltf::Node& node, CBaseEntity* parent, const std::string& baseDir, const std::string& filePath, Scene* scene, glm::mat4 parentMatrix, RawMeshMap& rawMeshes);
+        static CBaseEntity* processGLTFNode(RenderingServer* renderer, tinygltf::Model& model, tinygltf::Node& node, CBaseEntity* parent, const std::string& baseDir, const std::string& filePath, Scene* scene, glm::mat4 parentMatrix, RawMeshMap& rawMeshes);
     };
 }
\ No newline at end of file
@@ -1,13 +1,13 @@
 #include "OctreeNode.hpp"
 #include "TerrainManager.hpp"
 
-#include "servers/rendering/RenderingServer.hpp"
+#include "servers/rendering/IRenderer.hpp"
 #include <algorithm> 
 
 
 namespace Crescendo::Terrain { 
     
-    bool OctreeNode::CheckForFinishedMeshes(Crescendo::RenderingServer* renderer, Crescendo::Scene* scene, const glm::vec3& chunkOrigin) {
+    bool OctreeNode::CheckForFinishedMeshes(Crescendo::IRenderer* renderer, Crescendo::Scene* scene, const glm::vec3& chunkOrigin) {
         if (isGenerating && pendingBakeResult.valid()) {
             if (pendingBakeResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
                 
@@ -15,8 +15,7 @@ namespace Crescendo::Terrain {
                 
                 if (result.hasMesh) {
                     // Hand the fully built GPU mesh to the renderer (Instant!)
-                    renderer->meshes.push_back(std::move(result.generatedMesh));
-                    meshID = static_cast<int>(renderer->meshes.size() - 1);
+                    meshID = renderer->adoptMesh(std::move(result.generatedMesh));
                     
                     // Note: We don't call CreateTerrainCollider here anymore! 
                     // The background thread already did it, and the collision is active.
@@ -5,7 +5,7 @@
 #include <array>
 #include <future>
 
-#include "servers/rendering/RenderingServer.hpp"
+#include "servers/rendering/IRenderer.hpp"
 
 namespace Crescendo { class Scene; }
 
@@ -40,7 +40,7 @@ namespace Crescendo::Terrain {
             return false;
         }
 
-        bool CheckForFinishedMeshes(Crescendo::RenderingServer* renderer, Crescendo::Scene* scene, const glm::vec3& chunkOrigin);
+        bool CheckForFinishedMeshes(Crescendo::IRenderer* renderer, Crescendo::Scene* scene, const glm::vec3& chunkOrigin);
         void Update(const glm::vec3& localCameraPos, float splitThreshold, TerrainManager* manager);
         void Merge(TerrainManager* manager);
                 
@@ -0,0 +1,88 @@
+#include "PlanetStreaming.hpp"
+#include "OctreeNode.hpp"
+#include "TerrainManager.hpp"
+
+#include "scene/Scene.hpp"
+#include "scene/components/ProceduralPlanetComponent.hpp"
+#include "servers/physics/PhysicsServer.hpp"
+#include "servers/rendering/Vertex.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+
+namespace Crescendo::Terrain {
+
+    void StreamPlanets(Scene& scene, IRenderer& renderer, const glm::vec3& viewerPosition) {
+        PROFILE_SCOPE("Terrain::StreamPlanets");
+        for (ProceduralPlanetComponent* planet : scene.storage.Components<ProceduralPlanetComponent>()) {
+            CBaseEntity* ent = planet->owner;
+            if (!ent || !planet->rootNode || !planet->chunkManager) continue;
+
+            glm::vec3 localViewer = viewerPosition - ent->WorldPosition();
+
+            // 1. Cull the tree and queue up missing chunks
+            planet->rootNode->Update(localViewer, planet->lodSplitThreshold, planet->chunkManager.get());
+
+            // 2. Sort the queue so chunks closest to the viewer generate FIRST
+            auto& queue = planet->chunkManager->chunkQueue;
+            std::sort(queue.begin(), queue.end(), [&](OctreeNode* a, OctreeNode* b) {
+                float distA = glm::length(localViewer - a->center);
+                float distB = glm::length(localViewer - b->center);
+                return distA > distB; // > Descending order: Furthest at front, Closest at back
+            });
+
+            // 3. Process the Bake Queue (Launch Async Threads!)
+            int chunksLaunched = 0;
+            while (!queue.empty() && chunksLaunched < 1) {
+                auto* node = queue.back(); // Grab the closest chunk (O(1) fast!)
+                queue.pop_back();          // Instantly remove it from the back
+
+                // Mark as generating so we don't accidentally queue it again
+                node->isGenerating = true;
+
+                TerrainComputePush pushData{};
+                pushData.chunkOrigin = node->center - glm::vec3(node->size / 2.0f);
+                pushData.chunkSize = node->size;
+                pushData.planetCenter = glm::vec3(0.0f);
+                pushData.planetRadius = planet->settings.radius;
+                pushData.amplitude = planet->settings.amplitude;
+                pushData.frequency = planet->settings.frequency;
+                pushData.octaves = planet->settings.octaves;
+                pushData.resolution = 32;
+                pushData.lod = node->lod;
+
+                bool needsCollision = (node->lod <= 1);
+
+                // --- THE TRULY ASYNC LAUNCH ---
+                IRenderer* baker = &renderer;
+                PhysicsServer* physicsServer = scene.physics; // Grab the pointer for the background thread
+
+                // Low priority on the shared workers: bakes fill idle cores but never delay frame work
+                node->pendingBakeResult = JobSystem::Get().Async([baker, pushData, needsCollision, physicsServer]() -> ChunkBakeResult {
+
+                    // 1. Mesh generation (GPU compute, or the CPU generator when headless)
+                    PROFILE_PHASE(phase, "Terrain Bake");
+                    ChunkBakeResult result = baker->buildChunkMesh(pushData, needsCollision);
+
+                    // 2. Jolt Physics (Runs in background!)
+                    if (needsCollision && result.hasMesh && physicsServer) {
+                        phase.Next("Terrain Collider");
+                        int stride = sizeof(Vertex) / sizeof(float);
+                        result.physicsBodyID = physicsServer->CreateTerrainCollider(result.collisionVerts, result.collisionIndices, pushData.chunkOrigin, stride);
+
+                        // OPTIMIZATION: Clear the heavy RAM arrays since Jolt has the data now!
+                        result.collisionVerts.clear();
+                        result.collisionIndices.clear();
+                    }
+
+                    return result; // Hand the completely finished package back
+                }, JobPriority::Low);
+
+                chunksLaunched++;
+            }
+
+            // 4. Check for ANY finished background threads and integrate them!
+            planet->rootNode->CheckForFinishedMeshes(&renderer, &scene, planet->rootNode->center - glm::vec3(planet->rootNode->size / 2.0f));
+        }
+    }
+}
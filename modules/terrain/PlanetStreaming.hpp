@@ -0,0 +1,21 @@
+#pragma once
+#include <glm/glm.hpp>
+
+namespace Crescendo {
+    class Scene;
+    class IRenderer;
+}
+
+namespace Crescendo::Terrain {
+
+    // =========================================================
+    // PLANET STREAMING
+    // Refines every procedural planet's octree around the viewer,
+    // launches the closest missing chunk as a background bake and
+    // hands finished chunks to the renderer. Only goes through
+    // IRenderer, so a headless server streams (and builds colliders)
+    // exactly like the editor does.
+    // =========================================================
+
+    void StreamPlanets(Scene& scene, IRenderer& renderer, const glm::vec3& viewerPosition);
+}
@@ -23,6 +23,8 @@ namespace Crescendo {
             config.shadowBiasSlope    = tbl["Shadows"]["bias_slope"].value_or(config.shadowBiasSlope);
             config.shadowDistance     = tbl["Shadows"]["shadow_distance"].value_or(config.shadowDistance);
             config.cascadeSplitLambda = tbl["Shadows"]["cascade_split"].value_or(config.cascadeSplitLambda);
+            config.shadowCacheMargin  = tbl["Shadows"]["cache_margin"].value_or(config.shadowCacheMargin);
+            config.shadowCacheSunAngle = tbl["Shadows"]["cache_sun_angle"].value_or(config.shadowCacheSunAngle);
 
             // read sun colors
             if (auto sunArr = tbl["Environment"]["sun_color"].as_array()) {
@@ -32,6 +34,14 @@ namespace Crescendo {
             }
             config.sunIntensity = tbl["Environment"]["sun_intensity"].value_or(config.sunIntensity);
 
+            // read simulation
+            config.tickRate         = tbl["Simulation"]["tick_rate"].value_or(config.tickRate);
+            config.maxTicksPerFrame = tbl["Simulation"]["max_ticks_per_frame"].value_or(config.maxTicksPerFrame);
+            config.renderThread     = tbl["Simulation"]["render_thread"].value_or(config.renderThread);
+
+            // read server
+            config.serverTickRate = tbl["Server"]["tick_rate"].value_or(config.serverTickRate);
+
             std::cout << "[Config] Successfully loaded: " << filepath << std::endl;
         }
         catch (const toml::parse_error& err) {
@@ -54,11 +64,21 @@ namespace Crescendo {
                 { "bias_constant", config.shadowBiasConstant },
                 { "bias_slope", config.shadowBiasSlope },
                 { "shadow_distance", config.shadowDistance },
-                { "cascade_split", config.cascadeSplitLambda }
+                { "cascade_split", config.cascadeSplitLambda },
+                { "cache_margin", config.shadowCacheMargin },
+                { "cache_sun_angle", config.shadowCacheSunAngle }
             }},
             { "Environment", toml::table{
                 { "sun_intensity", config.sunIntensity },
                 { "sun_color", toml::array{config.sunColor.r, config.sunColor.g, config.sunColor.b} }
+            }},
+            { "Simulation", toml::table{
+                { "tick_rate", config.tickRate },
+                { "max_ticks_per_frame", config.maxTicksPerFrame },
+                { "render_thread", config.renderThread }
+            }},
+            { "Server", toml::table{
+                { "tick_rate", config.serverTickRate }
             }}
         };
 
@@ -16,9 +16,19 @@ namespace Crescendo {
         float shadowBiasSlope = 1.75f;
         float cascadeSplitLambda = 0.95f;
         float shadowDistance = 150.0f;
+        float shadowCacheMargin = 0.15f;    // Cascade padding the camera can drift through before a cached cascade is refit
+        float shadowCacheSunAngle = 0.1f;   // Degrees the sun can turn before the cached cascades are redrawn
 
         glm::vec3 sunColor = glm::vec3(1.0f, 0.95f, 0.9f);
         float sunIntensity = 5.0f;
+
+        // Simulation Settings
+        float tickRate = 60.0f;         // Fixed simulation ticks per second, rendering runs as fast as it can
+        int maxTicksPerFrame = 5;       // Past this the simulation slows down instead of catching up
+        bool renderThread = true;       // Record frame N on its own thread while frame N+1 simulates
+
+        // Server Settings (headless)
+        float serverTickRate = 30.0f;   // Ticks per second with no renderer to pace against
     };
 
     class ConfigManager {
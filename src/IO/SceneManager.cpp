@@ -83,10 +83,12 @@ void SceneManager::InstantiatePrefab(std::shared_ptr<Scene> prefabScene, const g
     // A simple copy routine. You will iterate over the prefab's entities
     // and duplicate them into the activeScene, applying the position offset.
     for (const auto& entity : prefabScene->entities) {
+        if (!entity) continue; // Freed slot
+
         CBaseEntity* newEnt = activeScene->CreateEntity(entity->targetName);
-        newEnt->origin = entity->origin + position;
-        newEnt->angles = entity->angles;
-        newEnt->scale = entity->scale;
+        newEnt->SetOrigin(entity->Origin() + position);
+        newEnt->SetAngles(entity->Angles());
+        newEnt->SetScale(entity->Scale());
         
         // Note: You will need to write a deep copy function for components here 
         // depending on how the ECS stores component data.
@@ -5,7 +5,9 @@
 #include "servers/physics/PhysicsServer.hpp"
 #include "deps/json/json.hpp"
 #include <fstream>
+#include <unordered_map>
 #include <iostream>
+#include <utility>
 
 using json = nlohmann::json;
 
@@ -24,29 +26,34 @@ namespace Crescendo {
         for (auto* ent : m_Scene->entities) {
             if (!ent) continue;
 
+            // Read through const, saving shouldn't flag every row for the renderer
+            const MaterialData& material = std::as_const(*ent).Material();
+
             json entityJson;
+            entityJson["ID"]                            = ent->handle.index;
+            entityJson["Parent"]                        = ent->moveParent ? (int64_t)ent->moveParent->handle.index : -1;
             entityJson["TargetName"]                    = ent->targetName;
             entityJson["ClassName"]                     = ent->className;
             entityJson["ModelIndex"]                    = ent->modelIndex;
-            entityJson["TextureID"]                     = ent->textureID;
+            entityJson["TextureID"]                     = material.textureID;
 
             // Transform
-            entityJson["Transform"]["Position"]         = { ent->origin.x, ent->origin.y, ent->origin.z };
-            entityJson["Transform"]["Rotation"]         = { ent->angles.x, ent->angles.y, ent->angles.z };
-            entityJson["Transform"]["Scale"]            = { ent->scale.x, ent->scale.y, ent->scale.z };
+            entityJson["Transform"]["Position"]         = { ent->Origin().x, ent->Origin().y, ent->Origin().z };
+            entityJson["Transform"]["Rotation"]         = { ent->Angles().x, ent->Angles().y, ent->Angles().z };
+            entityJson["Transform"]["Scale"]            = { ent->Scale().x, ent->Scale().y, ent->Scale().z };
 
             // PBR Material
-            entityJson["Material"]["Roughness"]         = ent->roughness;
-            entityJson["Material"]["Metallic"]          = ent->metallic;
-            entityJson["Material"]["Emission"]          = ent->emission;
-            entityJson["Material"]["NormalStrength"]    = ent->normalStrength;
+            entityJson["Material"]["Roughness"]         = material.roughness;
+            entityJson["Material"]["Metallic"]          = material.metallic;
+            entityJson["Material"]["Emission"]          = material.emission;
+            entityJson["Material"]["NormalStrength"]    = material.normalStrength;
 
             // Volume / Glass   
-            entityJson["Volume"]["Transmission"]        = ent->transmission;
-            entityJson["Volume"]["Thickness"]           = ent->thickness;
-            entityJson["Volume"]["AttDistance"]         = ent->attenuationDistance;
-            entityJson["Volume"]["IOR"]                 = ent->ior;
-            entityJson["Volume"]["AttColor"]            = { ent->attenuationColor.r, ent->attenuationColor.g, ent->attenuationColor.b };
+            entityJson["Volume"]["Transmission"]        = material.transmission;
+            entityJson["Volume"]["Thickness"]           = material.thickness;
+            entityJson["Volume"]["AttDistance"]         = material.attenuationDistance;
+            entityJson["Volume"]["IOR"]                 = material.ior;
+            entityJson["Volume"]["AttColor"]            = { material.attenuationColor.r, material.attenuationColor.g, material.attenuationColor.b };
 
             entitiesArray.push_back(entityJson);
         }
@@ -83,8 +90,17 @@ namespace Crescendo {
 
     // 1. Clear the current scene
     m_Scene->Clear(); 
+    SceneAllocationStats before = m_Scene->AllocationStats();
+
+    auto& entities = inData["Entities"];
 
-    auto entities = inData["Entities"];
+    // Saved IDs are slot indices from the old session; remap them to the new handles
+    std::unordered_map<int64_t, EntityHandle> idRemap;
+    std::vector<std::pair<EntityHandle, int64_t>> pendingParents;
+    if (entities.is_array()) {
+        idRemap.reserve(entities.size());
+        pendingParents.reserve(entities.size());
+    }
     if (entities.is_array()) {
         for (auto& item : entities) {
             // 2. Extract the model path and class info
@@ -97,8 +113,7 @@ namespace Crescendo {
             // This ensures Jolt generates the Mesh Collider for surfing!
             if (!modelPath.empty()) {
                 // AssetLoader handles: mesh upload, texture binding, and Jolt collider creation
-                AssetLoader::loadModel(m_Renderer, modelPath, m_Scene); 
-                ent = m_Scene->entities.back(); // Grab the one we just loaded
+                ent = AssetLoader::loadModel(m_Renderer, modelPath, m_Scene); 
             } else {
                 // If it's a light or empty, just create it
                 ent = m_Scene->CreateEntity(className);
@@ -106,21 +121,25 @@ namespace Crescendo {
 
             if (!ent) continue;
 
+            if (item.contains("ID")) idRemap[item.value("ID", (int64_t)-1)] = ent->handle;
+            int64_t parentID = item.value("Parent", (int64_t)-1);
+            if (parentID >= 0) pendingParents.push_back({ ent->handle, parentID });
+
             // 4. Restore the Metadata
             ent->targetName = item.value("TargetName", "Unnamed Entity");
-            ent->textureID  = item.value("TextureID", 0);
+            ent->Material().textureID  = item.value("TextureID", 0);
 
             // 5. Restore the Transform (Safely)
             if (item.contains("Transform")) {
                 auto& t = item["Transform"];
                 if (t.contains("Position") && t["Position"].is_array()) {
-                    ent->origin = glm::vec3(t["Position"][0], t["Position"][1], t["Position"][2]);
+                    ent->SetOrigin(glm::vec3(t["Position"][0], t["Position"][1], t["Position"][2]));
                 }
                 if (t.contains("Rotation") && t["Rotation"].is_array()) {
-                    ent->angles = glm::vec3(t["Rotation"][0], t["Rotation"][1], t["Rotation"][2]);
+                    ent->SetAngles(glm::vec3(t["Rotation"][0], t["Rotation"][1], t["Rotation"][2]));
                 }
                 if (t.contains("Scale") && t["Scale"].is_array()) {
-                    ent->scale  = glm::vec3(t["Scale"][0], t["Scale"][1], t["Scale"][2]);
+                    ent->SetScale(glm::vec3(t["Scale"][0], t["Scale"][1], t["Scale"][2]));
                 }
             }
 
@@ -130,37 +149,53 @@ namespace Crescendo {
                 
                 // Only try to read Albedo if it actually exists in the file!
                 if (m.contains("Albedo") && m["Albedo"].is_array()) {
-                    ent->albedoColor = glm::vec3(m["Albedo"][0], m["Albedo"][1], m["Albedo"][2]);
+                    ent->Material().albedoColor = glm::vec3(m["Albedo"][0], m["Albedo"][1], m["Albedo"][2]);
                 }
                 
-                ent->roughness      = m.value("Roughness", 1.0f);
-                ent->metallic       = m.value("Metallic", 0.0f);
-                ent->emission       = m.value("Emission", 0.0f);
-                ent->normalStrength = m.value("NormalStrength", 0.0f);
+                ent->Material().roughness      = m.value("Roughness", 1.0f);
+                ent->Material().metallic       = m.value("Metallic", 0.0f);
+                ent->Material().emission       = m.value("Emission", 0.0f);
+                ent->Material().normalStrength = m.value("NormalStrength", 0.0f);
             }
 
             // 7. Restore Volume / Glass (Safely)
             if (item.contains("Volume")) {
                 auto& v = item["Volume"];
-                ent->transmission        = v.value("Transmission", 0.0f);
-                ent->thickness           = v.value("Thickness", 1.0f);
-                ent->attenuationDistance = v.value("AttDistance", 1.0f);
-                ent->ior                 = v.value("IOR", 1.5f);
+                ent->Material().transmission        = v.value("Transmission", 0.0f);
+                ent->Material().thickness           = v.value("Thickness", 1.0f);
+                ent->Material().attenuationDistance = v.value("AttDistance", 1.0f);
+                ent->Material().ior                 = v.value("IOR", 1.5f);
                 
                 if (v.contains("AttColor") && v["AttColor"].is_array()) {
-                    ent->attenuationColor = glm::vec3(v["AttColor"][0], v["AttColor"][1], v["AttColor"][2]);
+                    ent->Material().attenuationColor = glm::vec3(v["AttColor"][0], v["AttColor"][1], v["AttColor"][2]);
                 }
             }
 
             // 8. CRITICAL: Update the Physics Server
             // This teleports the Jolt body to the saved position/rotation
             if (m_Scene->physics) {
-                m_Scene->physics->ResetBody(ent->index, ent->origin, ent->angles);
+                m_Scene->physics->ResetBody(ent->handle, ent->Origin(), ent->Angles());
             }
         }
     }
 
-    std::cout << "[Serializer] Successfully loaded " << entities.size() << " entities." << std::endl;
+    // 9. Re-link the hierarchy now that every saved ID has a live handle
+    for (const auto& [childHandle, parentID] : pendingParents) {
+        auto it = idRemap.find(parentID);
+        if (it == idRemap.end()) continue;
+
+        CBaseEntity* child = m_Scene->GetEntity(childHandle);
+        CBaseEntity* parent = m_Scene->GetEntity(it->second);
+        if (!child || !parent || child->moveParent) continue;
+
+        m_Scene->SetParent(child, parent);
+    }
+
+    SceneAllocationStats after = m_Scene->AllocationStats();
+    std::cout << "[Serializer] Successfully loaded " << entities.size() << " entities ("
+              << (after.entities.acquires - before.entities.acquires) << " entity / "
+              << (after.components.acquires - before.components.acquires) << " component slots, "
+              << (after.HeapAllocations() - before.HeapAllocations()) << " pool heap allocations)." << std::endl;
     return true;
 }
 }
\ No newline at end of file
@@ -139,10 +139,10 @@ namespace Crescendo {
             JPH::Vec3 jPos = wheelMat.GetTranslation();
             JPH::Quat jRot = wheelMat.GetRotation().GetQuaternion();
 
-            wheels[i]->origin = glm::vec3(jPos.GetX(), jPos.GetY(), jPos.GetZ());
+            wheels[i]->SetOrigin(glm::vec3(jPos.GetX(), jPos.GetY(), jPos.GetZ()));
             
             glm::quat q(jRot.GetW(), jRot.GetX(), jRot.GetY(), jRot.GetZ());
-            wheels[i]->angles = glm::degrees(glm::eulerAngles(q));
+            wheels[i]->SetAngles(glm::degrees(glm::eulerAngles(q)));
         }
     }
 }
\ No newline at end of file
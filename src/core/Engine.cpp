@@ -1,5 +1,10 @@
 #include "Engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
 #include <iostream>
+#include <utility>
 
 #include <Jolt/Core/IssueReporting.h>
 #include "Jolt/Core/Memory.h"
@@ -7,28 +12,53 @@
 #include "scene/BaseEntity.hpp"
 #include "servers/networking/NetworkingServer.hpp"
 #include "modules/gltf/AssetLoader.hpp"
+#include "scene/TransformSystem.hpp"
+#include "scene/components/TransformComponent.hpp"
+#include "scene/components/MeshRendererComponent.hpp"
+#include "scene/components/PointLightComponent.hpp"
+#include "scene/components/ProceduralPlanetComponent.hpp"
+#include "scene/components/PlanetManagerComponent.hpp"
+#include "modules/terrain/TerrainManager.hpp"
+#include "modules/terrain/PlanetStreaming.hpp"
 // --- THE RHI SWITCH ---
 #ifdef __EMSCRIPTEN__
     #include "servers/rendering/webgl/WebRenderer.hpp"
 #else
     #include "servers/rendering/RenderingServer.hpp"
+    #include "servers/rendering/NullRenderer.hpp"
 #endif
 
 #include "IO/SceneManager.hpp"
+#include "IO/SceneSerializer.hpp"
+#include "IO/ConfigManager.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
 
 namespace Crescendo {
 
+    namespace {
+        // Set from SIGINT/SIGTERM, a headless run has no window to close
+        volatile std::sig_atomic_t stopRequested = 0;
+        void RequestStop(int) { stopRequested = 1; }
+    }
+
     Engine::Engine() : isRunning(false) {}
     Engine::~Engine() {
         Shutdown();
     }
 
-    bool Engine::Initialize(const char* title, int width, int height) {
+    bool Engine::Initialize(const char* title, int width, int height, const LaunchOptions& options) {
+        launch = options;
+        PROFILE_THREAD("Main");
 
         JPH::RegisterDefaultAllocator();
         JPH::Factory::sInstance = new JPH::Factory();
+
+        // One worker pool for physics, transforms, systems and terrain streaming
+        JobSystem::Get();
         
-        if (!displayServer.initialize(title, width, height)) return false;
+        // Headless never touches SDL video, so it runs on machines without a display or GPU
+        if (!launch.headless && !displayServer.initialize(title, width, height)) return false;
 
         // --- PLATFORM RENDERER INJECTION ---
         #ifdef __EMSCRIPTEN__
@@ -38,17 +68,52 @@ namespace Crescendo {
                 if (!renderer->initialize(&displayServer)) return false;
                 sceneManager = std::make_unique<SceneManager>(nullptr);
         #else
+            if (launch.headless) {
+                renderer = std::make_unique<NullRenderer>();
+                if (!renderer->initialize(nullptr)) return false;
+                sceneManager = std::make_unique<SceneManager>(nullptr);
+            } else {
                 renderer = std::make_unique<RenderingServer>();
                 if (!renderer->initialize(&displayServer)) return false;
                 sceneManager = std::make_unique<SceneManager>(static_cast<RenderingServer*>(renderer.get()));
+            }
         #endif
         
         // Start Physics 
         physicsServer.Initialize();
         scene.physics = &physicsServer;
 
+        // Start Scripting + gameplay systems
+        scriptSystem.Initialize();
+        RegisterSystems();
+
+        // Fixed simulation rate, rendering is uncapped
+        EngineConfig config = ConfigManager::loadConfig("conf/engine_settings.toml");
+        float tickRate = config.tickRate;
+        uint32_t maxTicksPerFrame = static_cast<uint32_t>(std::max(1, config.maxTicksPerFrame));
+        if (launch.headless) tickRate = launch.tickRate > 0.0f ? launch.tickRate : config.serverTickRate;
+
+        // A replay runs at the rate, and in the scene, it was captured with
+        if (!launch.replayPath.empty()) {
+            if (!inputRecorder.LoadReplay(launch.replayPath)) return false;
+            tickRate = inputRecorder.Header().tickRate;
+            maxTicksPerFrame = inputRecorder.Header().maxTicksPerFrame;
+            if (launch.scenePath.empty()) launch.scenePath = inputRecorder.Header().scenePath;
+            if (launch.timingsPath.empty()) launch.timingsPath = std::filesystem::path(launch.replayPath).replace_extension(".csv").string();
+        }
+
+        simClock.SetRate(tickRate);
+        simClock.SetMaxTicksPerFrame(maxTicksPerFrame);
+        scene.time.tickRate = simClock.Rate();
+        std::cout << "[Engine] Simulation at " << simClock.Rate() << " Hz." << std::endl;
+
+        // Record frame N while frame N+1 simulates
+        #ifndef __EMSCRIPTEN__
+                pipelinedRendering = config.renderThread && !launch.headless;
+        #endif
+
         // Start Audio
-        if (audioServer.Initialize()) {
+        if (!launch.headless && audioServer.Initialize()) {
             audioServer.LoadAmbientSound("assets/audio/wind.mp3", 0.5f);
         }
 
@@ -59,19 +124,71 @@ namespace Crescendo {
         // Spawn Sky Entity
         CBaseEntity* skyEnt = scene.CreateEntity("env_sky");
         skyEnt->targetName = "Procedural Sky";
-        skyEnt->angles = glm::vec3(45.0f, -30.0f, 0.0f);
-        skyEnt->albedoColor = glm::vec3(0.5f, 0.7f, 1.0f);      // Zenith
-        skyEnt->attenuationColor = glm::vec3(0.0f, 0.0f, 0.0f); // Horizon
+        skyEnt->SetAngles(glm::vec3(45.0f, -30.0f, 0.0f));
+        skyEnt->Material().albedoColor = glm::vec3(0.5f, 0.7f, 1.0f);      // Zenith
+        skyEnt->Material().attenuationColor = glm::vec3(0.0f, 0.0f, 0.0f); // Horizon
+
+        camera.SetPosition(glm::vec3(0.0f, -10.0f, 5.0f)); 
+        camera.SetRotation(glm::vec3(0.0f, 90.0f, 0.0f)); 
+
+        if (!launch.scenePath.empty()) {
+            SceneSerializer serializer(&scene, sceneManager->GetRenderer());
+            if (!serializer.Deserialize(launch.scenePath)) return false;
+        }
+
+        // A server is always playing, there's no editor to press Play in
+        if (launch.headless) {
+            if (launch.spawnPlanet) SpawnBenchmarkPlanet();
+            currentState = EngineState::Playing;
+        }
+
+        // --- RECORD / REPLAY ---
+        if (!launch.recordPath.empty()) {
+            InputCaptureHeader header;
+            header.tickRate = simClock.Rate();
+            header.maxTicksPerFrame = maxTicksPerFrame;
+            header.scenePath = launch.scenePath;
+            if (!inputRecorder.StartRecording(launch.recordPath, header)) return false;
+        }
+        if (!launch.timingsPath.empty() && !frameTimings.Open(launch.timingsPath)) return false;
                 
         isRunning = true;
         return true;
     }
 
     void Engine::Run() {
+        if (launch.headless) {
+            RunHeadless();
+            return;
+        }
+
+        if (pipelinedRendering) {
+            renderPackets.Reopen();
+            renderThread = std::thread(&Engine::RenderLoop, this);
+            std::cout << "[Engine] Rendering on its own thread." << std::endl;
+        }
+
+        auto lastFrame = std::chrono::steady_clock::now();
         while (isRunning) {
+            auto now = std::chrono::steady_clock::now();
+            double frameSeconds = std::chrono::duration<double>(now - lastFrame).count();
+            lastFrame = now;
+            PROFILE_FRAME();
+
             ProcessEvents();
-            Update();
+            Update(frameSeconds);
+            if (!isRunning) break;
+
+            auto updated = std::chrono::steady_clock::now();
             Render();
+
+            if (frameTimings.IsOpen()) {
+                auto done = std::chrono::steady_clock::now();
+                frameTimings.Write(scene.time.tick, scene.time.ticksLastFrame,
+                                   std::chrono::duration<double, std::milli>(updated - now).count(),
+                                   std::chrono::duration<double, std::milli>(done - updated).count(),
+                                   std::chrono::duration<double, std::milli>(done - now).count());
+            }
         }
         
     }
@@ -80,13 +197,145 @@ namespace Crescendo {
         displayServer.poll_events(isRunning);
     }
 
-    void Engine::Update() {
-        float dt = 1.0f / 60.0f; 
-        Input::Update();
+    // =========================================================
+    // INPUT RECORD / REPLAY
+    // A record is taken before anything in the frame reacts to it:
+    // the state the editor left, the camera pose before mouse look,
+    // and the raw input. Replaying puts exactly that back and feeds
+    // the captured wall time to the fixed-step clock, so the frame
+    // runs the same ticks on any machine.
+    // =========================================================
+    bool Engine::BeginInputFrame(double& frameSeconds) {
+        if (inputRecorder.IsReplaying()) {
+            const InputFrame* frame = inputRecorder.Next();
+            if (!frame) {
+                std::cout << "[Engine] Replay finished." << std::endl;
+                isRunning = false;
+                return false;
+            }
+
+            Input::Inject(frame->keys, frame->mouseRelX, frame->mouseRelY, frame->mouseButtons);
+            currentState = frame->state;
+            camera.SetPosition(frame->cameraPosition);
+            camera.SetRotation(glm::vec3(frame->cameraPitch, frame->cameraYaw, 0.0f));
+            frameSeconds = frame->frameSeconds;
+
+            // Recording a replay again gives a second capture to diff against the first
+            if (inputRecorder.IsRecording()) capturedInput = *frame;
+            return true;
+        }
+
+        if (!launch.headless) Input::Update();
+
+        if (inputRecorder.IsRecording()) {
+            capturedInput.frameSeconds = frameSeconds;
+            capturedInput.state = currentState;
+            capturedInput.cameraPosition = camera.GetPosition();
+            capturedInput.cameraYaw = camera.Yaw;
+            capturedInput.cameraPitch = camera.Pitch;
+            capturedInput.mouseRelX = Input::mouseRelX;
+            capturedInput.mouseRelY = Input::mouseRelY;
+            capturedInput.mouseButtons = Input::MouseButtons();
+            Input::PressedKeys(capturedInput.keys);
+        }
+        return true;
+    }
+
+    void Engine::EndInputFrame(uint32_t ticks) {
+        if (inputRecorder.IsReplaying()) inputRecorder.CheckTicks(ticks);
+
+        if (inputRecorder.IsRecording()) {
+            capturedInput.ticks = ticks;
+            inputRecorder.Record(capturedInput);
+        }
+    }
+
+    // =========================================================
+    // HEADLESS LOOP
+    // No frames to pace against, so the loop sleeps until the next
+    // tick is due instead of spinning. Update still does everything
+    // else a frame does: ticks, transforms and terrain streaming.
+    // =========================================================
+    void Engine::RunHeadless() {
+        stopRequested = 0;
+        std::signal(SIGINT, RequestStop);
+        std::signal(SIGTERM, RequestStop);
+
+        std::cout << "[Engine] Headless at " << simClock.Rate() << " Hz";
+        if (launch.maxTicks > 0) std::cout << " for " << launch.maxTicks << " ticks";
+        std::cout << "." << std::endl;
+
+        uint64_t firstTick = scene.time.tick;
+        tickMsTotal = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        auto lastFrame = start;
+
+        while (isRunning && !stopRequested) {
+            auto now = std::chrono::steady_clock::now();
+            double frameSeconds = std::chrono::duration<double>(now - lastFrame).count();
+            lastFrame = now;
+            PROFILE_FRAME();
+
+            Update(frameSeconds);
+            if (!isRunning) break;
+
+            if (frameTimings.IsOpen()) {
+                double updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - now).count();
+                frameTimings.Write(scene.time.tick, scene.time.ticksLastFrame, updateMs, 0.0, updateMs);
+            }
+
+            if (launch.maxTicks > 0 && scene.time.tick - firstTick >= launch.maxTicks) break;
+
+            // A replay runs flat out, the capture already says how much time each frame covered
+            if (inputRecorder.IsReplaying()) continue;
+
+            double untilNextTick = (1.0 - simClock.Alpha()) * simClock.Step();
+            std::this_thread::sleep_for(std::chrono::duration<double>(untilNextTick));
+        }
+
+        uint64_t ticks = scene.time.tick - firstTick;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[Engine] Headless run: " << ticks << " ticks in " << seconds << " s, "
+                  << (ticks > 0 ? tickMsTotal / ticks : 0.0) << " ms per tick." << std::endl;
+    }
+
+    // =========================================================
+    // GAMEPLAY SYSTEMS
+    // Registration order is execution order for systems that conflict.
+    // Everything that doesn't conflict shares a stage and runs in parallel.
+    // =========================================================
+    void Engine::RegisterSystems() {
+        // Think() can touch anything on any entity, so it gets a stage to itself
+        scene.systems.AddSystem("Entity Think", ACCESS_EVERYTHING, ACCESS_EVERYTHING,
+            [this]() { return scene.entities.size(); },
+            [this](size_t begin, size_t end, float dt) {
+                for (size_t i = begin; i < end; i++) {
+                    if (CBaseEntity* ent = scene.entities[i]) ent->Think(dt);
+                }
+            }, false);
+
+        // One Lua state, so scripts run as a single task
+        scene.systems.AddSystem("Lua Scripts", ACCESS_SCRIPT_STATE | ACCESS_ENTITY_TRANSFORM, ACCESS_SCRIPT_STATE | ACCESS_ENTITY_TRANSFORM,
+            [this]() { return scene.entities.size(); },
+            [this](size_t begin, size_t end, float dt) {
+                for (size_t i = begin; i < end; i++) {
+                    CBaseEntity* ent = scene.entities[i];
+                    if (ent && ent->hasScript) scriptSystem.RunEntityScript(ent, dt);
+                }
+            }, false);
+
+        // Component updates only touch their own type, so these all share one stage
+        scene.systems.AddComponentUpdate<TransformComponent>(scene.storage, "Transform Components");
+        scene.systems.AddComponentUpdate<MeshRendererComponent>(scene.storage, "Mesh Renderers");
+        scene.systems.AddComponentUpdate<PointLightComponent>(scene.storage, "Point Lights");
+        scene.systems.AddComponentUpdate<ProceduralPlanetComponent>(scene.storage, "Procedural Planets");
+        scene.systems.AddComponentUpdate<PlanetManagerComponent>(scene.storage, "Planet Managers");
+    }
+
+    void Engine::Update(double frameSeconds) {
+        PROFILE_SCOPE("Engine::Update");
+        if (!BeginInputFrame(frameSeconds)) return;
        
-        // Temporarily cast back to RenderingServer to grab the camera
-        auto& cam = static_cast<RenderingServer*>(renderer.get())->mainCamera;
-        
         // NOTE: Editor Camera movement was DELETED from here!
         // It is now handled exclusively inside EditorUI::Prepare() so it respects the console.
 
@@ -99,72 +348,49 @@ namespace Crescendo {
             std::cout << "[Engine] Play Mode: Saving initial state..." << std::endl;
             
             // --- NEW: INITIALIZE SPATIAL AUDIO FOR THIS RUN ---
-            audioServer.ClearSpatialEmitters(); // Wipe any leftovers
+            if (!launch.headless) audioServer.ClearSpatialEmitters(); // Wipe any leftovers
+
+            glm::vec3 spawnLocation = camera.GetPosition(); 
+            simClock.Reset();
 
-            glm::vec3 spawnLocation = cam.GetPosition(); 
+            // Taken before anything below touches the scene. Rows are only copied as play writes them.
+            scene.BeginSnapshot();
+            physicsServer.SaveState();
             
             for (auto* ent : scene.entities) {
-                if (ent) {
-                    ent->savedOrigin = ent->origin;
-                    ent->savedAngles = ent->angles;
-                    ent->savedScale = ent->scale; 
-                    
-                    // IF THE ENTITY IS A SOUND SOURCE, LOAD IT!
-                    // This line should now compile perfectly in Engine.cpp
-                    if (ent->className == "env_sound") {
-                        audioServer.LoadSpatialEmitter(ent->assetPath, ent->origin, ent->emission);
-                    }
-
-                    if (ent->targetName == "SpawnPoint") {
-                        spawnLocation = ent->origin + glm::vec3(0, 0, 1.0f); 
-                        ent->scale = glm::vec3(0.0f); // Turn spawner invisible
-                    }
+                if (ent && ent->targetName == "SpawnPoint") {
+                    spawnLocation = ent->Origin() + glm::vec3(0, 0, 1.0f); 
+                    ent->SetScale(glm::vec3(0.0f)); // Turn spawner invisible
                 }
             }
             
-            activePlayer = new FPSController();
-            activePlayer->Initialize(&physicsServer, spawnLocation);
-
-            // Spawn Player model
-            size_t priorCount = scene.entities.size();
-            // load the model directly into the scene
-            Crescendo::AssetLoader::loadModel(static_cast<RenderingServer*>(renderer.get()), "assets/systemsymbols/defaultplayer.glb", &scene);
-
-            if (scene.entities.size() > priorCount) {
-                localPlayerModel = scene.entities[priorCount];
-                localPlayerModel->targetName = "LocalPlayer";
-
-                // Auto flag it for enet
-                localPlayerModel->syncTransform = true;
-                localPlayerModel->networkID = 1;
+            // IF THE ENTITY IS A SOUND SOURCE, LOAD IT!
+            if (!launch.headless) {
+                for (auto* ent : scene.EntitiesOfClass(CLASS_ENV_SOUND)) {
+                    audioServer.LoadSpatialEmitter(ent->assetPath, ent->Origin(), std::as_const(*ent).Material().emission);
+                }
             }
+            
+            // A dedicated server has no local player, clients bring their own
+            if (!launch.headless) SpawnLocalPlayer(spawnLocation);
         }
         // 2. Returning to Editor (From either Playing OR Paused)
         else if (currentState == EngineState::Editor && previousState != EngineState::Editor) {
             std::cout << "[Engine] Editor Mode: Restoring scene..." << std::endl;
-            for (auto* ent : scene.entities) {
-                if (ent) {
-                    ent->origin = ent->savedOrigin;
-                    ent->angles = ent->savedAngles;
-                    ent->scale = ent->savedScale; 
-                    
-                    physicsServer.ResetBody(ent->index, ent->origin, ent->angles);
-                }
-            }
 
             if (activePlayer) {
                 delete activePlayer;
                 activePlayer = nullptr;
             }
 
-            if (localPlayerModel) {
-                scene.DeleteEntity(localPlayerModel->index);
-                localPlayerModel = nullptr;
-            }
+            // The player model was spawned during play, the restore deletes it with everything else
+            localPlayerModel = EntityHandle{};
+            scene.RestoreSnapshot();
+            physicsServer.RestoreState(&scene);
         }
         
         // 3. Handle Mouse Locking & Audio
-        if (currentState != previousState) {
+        if (currentState != previousState && !launch.headless) {
             if (currentState == EngineState::Playing) {
                 SDL_SetRelativeMouseMode(SDL_TRUE); 
                 audioServer.PlayAmbientSound();
@@ -179,81 +405,193 @@ namespace Crescendo {
         previousState = currentState;
 
         // =========================================================
-        // PLAY MODE: FPS Controller Physics & Network
+        // PLAY MODE: fixed-rate simulation
         // =========================================================
+        uint32_t ticks = 0;
         if (currentState == EngineState::Playing) {
+            // Mouse look runs per frame so it stays as responsive as the render rate.
+            // Add the minus sign to -Input::mouseRelX to fix the inverted left/right panning!
+            camera.Rotate((float)-Input::mouseRelX, (float)-Input::mouseRelY);
+
+            ticks = simClock.Advance(frameSeconds);
+            auto tickStart = std::chrono::high_resolution_clock::now();
+            for (uint32_t i = 0; i < ticks; i++) {
+                Tick(static_cast<float>(simClock.Step()));
+            }
+
+            if (ticks > 0) {
+                double tickMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tickStart).count() / ticks;
+                scene.time.tickMs = scene.time.tickMs * 0.95 + tickMs * 0.05;
+                tickMsTotal += tickMs * ticks;
+            }
+            scene.time.ticksLastFrame = ticks;
+            scene.time.alpha = simClock.Alpha();
+
+            // The camera rides the interpolated player, not the last tick
+            if (activePlayer) camera.SetPosition(glm::mix(playerPrevPosition, playerPosition, scene.time.alpha));
+        } else {
+            // Editor and Paused draw the latest state as is
+            scene.time.ticksLastFrame = 0;
+            scene.time.alpha = 1.0f;
+        }
+        EndInputFrame(ticks);
+        scene.time.frameMs = scene.time.frameMs * 0.95 + frameSeconds * 1000.0 * 0.05;
+
+        // --- WORLD TRANSFORMS ---
+        // Once per tick, at the end of Tick. Editor and Paused run no ticks, so their frames take
+        // that one run here; only dirty subtrees are touched, so it's free when nothing moved.
+        if (currentState != EngineState::Playing) TransformSystem::Update(scene);
+
+        // --- TERRAIN STREAMING ---
+        // Planets refine around the camera and pick up finished bakes, with or without a GPU
+        Terrain::StreamPlanets(scene, *renderer, camera.GetPosition());
+
+        // ---3D Audio Listener (spatial)
+        // Bind the audioservers ears to our cameras exact position and rotation.
+        if (!launch.headless) audioServer.UpdateListener(camera.Position, camera.Front, camera.Up);
+    }
+
+    void Engine::SpawnLocalPlayer(const glm::vec3& spawnLocation) {
+        activePlayer = new FPSController();
+        activePlayer->Initialize(&physicsServer, spawnLocation);
+        playerPrevPosition = playerPosition = activePlayer->GetPosition();
+
+        // Spawn Player model
+        // load the model directly into the scene
+        CBaseEntity* playerModel = Crescendo::AssetLoader::loadModel(sceneManager->GetRenderer(), "assets/systemsymbols/defaultplayer.glb", &scene);
+
+        if (playerModel) {
+            localPlayerModel = playerModel->handle;
+            playerModel->targetName = "LocalPlayer";
+
+            // Auto flag it for enet
+            // Hand-picked, below the range named entities hash into
+            playerModel->SetNetworkID(1);
+            playerModel->GetNetworkLink()->syncTransform = true;
+        }
+    }
+
+    // Same planet the editor's "Procedural Planet" menu creates, minus the
+    // atmosphere and ocean meshes. The camera sits just above the surface
+    // so the octree refines all the way down.
+    void Engine::SpawnBenchmarkPlanet() {
+        CBaseEntity* planet = scene.CreateEntity("prop_dynamic");
+        planet->targetName = "Voxel Planet";
+        planet->AddComponent<TransformComponent>();
+
+        ProceduralPlanetComponent* planetComp = planet->AddComponent<ProceduralPlanetComponent>();
+        planetComp->settings.radius = 3000.0f;
+        planetComp->settings.amplitude = 150.0f;
+        planetComp->settings.frequency = 0.002f;
+        planetComp->lodSplitThreshold = 1.1f;
+        planetComp->rootNode = std::make_unique<Crescendo::Terrain::OctreeNode>(glm::vec3(0.0f), planetComp->settings.radius * 2.2f, 6);
+        planetComp->chunkManager = std::make_unique<Crescendo::Terrain::TerrainManager>();
+
+        camera.SetPosition(planet->Origin() + glm::vec3(0.0f, 0.0f, planetComp->settings.radius + planetComp->settings.amplitude));
+        std::cout << "[Engine] Benchmark planet spawned, radius " << planetComp->settings.radius << "." << std::endl;
+    }
+
+    // =========================================================
+    // SIMULATION TICK
+    // Everything that advances the game runs here at the fixed rate:
+    // player, gameplay systems, physics and network sync.
+    // =========================================================
+    void Engine::Tick(float dt) {
+        PROFILE_SCOPE("Engine::Tick");
+        scene.time.tick++;
+
+        if (activePlayer) {
+            glm::vec3 forward = glm::vec3(camera.Front.x, camera.Front.y, 0.0f);
+            if (glm::length(forward) > 0.001f) forward = glm::normalize(forward);
             
-            if (activePlayer) {
-                glm::vec3 forward = glm::vec3(cam.Front.x, cam.Front.y, 0.0f);
-                if (glm::length(forward) > 0.001f) forward = glm::normalize(forward);
-                
-                glm::vec3 right = glm::vec3(cam.Right.x, cam.Right.y, 0.0f);
-                if (glm::length(right) > 0.001f) right = glm::normalize(right);
+            glm::vec3 right = glm::vec3(camera.Right.x, camera.Right.y, 0.0f);
+            if (glm::length(right) > 0.001f) right = glm::normalize(right);
 
-                glm::vec3 inputDir(0.0f);
-                if (Input::IsKeyDown(SDL_SCANCODE_W)) inputDir += forward;
-                if (Input::IsKeyDown(SDL_SCANCODE_S)) inputDir -= forward;
-                if (Input::IsKeyDown(SDL_SCANCODE_D)) inputDir += right;
-                if (Input::IsKeyDown(SDL_SCANCODE_A)) inputDir -= right;
+            glm::vec3 inputDir(0.0f);
+            if (Input::IsKeyDown(SDL_SCANCODE_W)) inputDir += forward;
+            if (Input::IsKeyDown(SDL_SCANCODE_S)) inputDir -= forward;
+            if (Input::IsKeyDown(SDL_SCANCODE_D)) inputDir += right;
+            if (Input::IsKeyDown(SDL_SCANCODE_A)) inputDir -= right;
 
-                bool jump = Input::IsKeyDown(SDL_SCANCODE_SPACE);
+            bool jump = Input::IsKeyDown(SDL_SCANCODE_SPACE);
 
-                // ADD &audioServer RIGHT HERE!
-                activePlayer->Update(dt, &physicsServer, &audioServer, inputDir, jump);
-                cam.SetPosition(activePlayer->GetPosition());
+            // ADD &audioServer RIGHT HERE!
+            playerPrevPosition = activePlayer->GetPosition();
+            activePlayer->Update(dt, &physicsServer, &audioServer, inputDir, jump);
+            playerPosition = activePlayer->GetPosition();
 
-                if (localPlayerModel) {
-                    // Offset by -1.0f on Z so the model is at your feet
-                    localPlayerModel->origin = activePlayer->GetPosition() - glm::vec3(0.0f, 0.0f, 1.0f);
+            if (CBaseEntity* playerModel = scene.GetEntity(localPlayerModel)) {
+                // Offset by -1.0f on Z so the model is at your feet
+                playerModel->SetOrigin(playerPosition - glm::vec3(0.0f, 0.0f, 1.0f));
 
-                    // Rotate the model to face the direction you are looking
-                    localPlayerModel->angles = glm::vec3(90.0f, 0.0f, cam.Yaw);
-                }
+                // Rotate the model to face the direction you are looking
+                playerModel->SetAngles(glm::vec3(90.0f, 0.0f, camera.Yaw));
             }
+        }
 
-            // Mouse Look ONLY happens here if we are actively playing
-            // Add the minus sign to -Input::mouseRelX to fix the inverted left/right panning!
-            cam.Rotate((float)-Input::mouseRelX, (float)-Input::mouseRelY);
+        // Think, scripts and component updates
+        scene.systems.Run(dt);
 
-            physicsServer.Update(dt, scene.entities);
+        physicsServer.Update(dt, &scene);
 
-            // =========================================================
-            // MULTIPLAYER SYNC LOOP
-            // =========================================================
+        // =========================================================
+        // MULTIPLAYER SYNC LOOP
+        // =========================================================
 
-            NetworkingServer* activeServer = nullptr;
+        NetworkingServer* activeServer = nullptr;
 
-            // 1. Find the Network Manager and process incoming movements
-            for (auto* ent : scene.entities) {
-                if (ent && ent->className == "node_network" && ent->netServer && ent->netServer->IsConnected()) {
-                    activeServer = ent->netServer;
-                    activeServer->Poll(scene.entities); // Apply incoming data to the scene
-                    break;
-                }
+        // 1. Find the Network Manager and process incoming movements
+        for (auto* ent : scene.EntitiesOfClass(CLASS_NODE_NETWORK)) {
+            if (ent->netServer && ent->netServer->IsConnected()) {
+                activeServer = ent->netServer;
+                activeServer->Poll(scene.storage); // Apply incoming data to the scene
+                break;
             }
+        }
 
-            // 2. Broadcast local movements out to the server/clients
-            if (activeServer) {
-                for (auto* ent : scene.entities) {
+        // 2. Broadcast local movements out to the server/clients
+        // Only the networked archetypes are walked, straight down the link and transform columns
+        if (activeServer && activeServer->IsServer()) {
+            std::as_const(scene.storage).ForEachChunk(GROUP_TRANSFORM | GROUP_NETWORK, [&](const EntityChunk& chunk) {
+                for (uint32_t i = 0; i < chunk.count; i++) {
                     // Broadcast networked entities (like localPlayerModel)
-                    if (ent && ent->syncTransform && activeServer->IsServer()) {
-                        activeServer->BroadcastTransform(
-                            ent->networkID,
-                            ent->origin,
-                            glm::radians(ent->angles)
-                        );
-                    }
+                    if (!chunk.network[i].syncTransform || chunk.network[i].networkID == 0) continue;
+                    activeServer->BroadcastTransform(
+                        chunk.network[i].networkID,
+                        chunk.origin[i],
+                        glm::radians(chunk.angles[i])
+                    );
                 }
-            }
+            });
         }
 
-        // ---3D Audio Listener (spatial)
-        // Bind the audioservers ears to our cameras exact position and rotation.
-        audioServer.UpdateListener(cam.Position, cam.Front, cam.Up);
+        // World matrices for this tick, the previous ones are kept for interpolation
+        TransformSystem::Update(scene);
     }
 
+    // =========================================================
+    // RENDER PIPELINE
+    // The packet is a copy of everything the frame draws, so once it
+    // is published the simulation is free to change the scene while
+    // the render thread records and submits.
+    // =========================================================
     void Engine::Render() {
-        renderer->render(&scene, sceneManager.get(), currentState);
+        PROFILE_SCOPE("Engine::Render");
+        RenderPacket& packet = renderPackets.WriteSlot();
+        renderer->buildPacket(&scene, sceneManager.get(), camera, currentState, packet);
+
+        if (pipelinedRendering) {
+            renderPackets.Publish();
+        } else {
+            renderer->renderPacket(packet);
+        }
+    }
+
+    void Engine::RenderLoop() {
+        PROFILE_THREAD("Render");
+        while (RenderPacket* packet = renderPackets.Acquire()) {
+            renderer->renderPacket(*packet);
+        }
     }
 
     void Engine::Shutdown() {
@@ -262,6 +600,14 @@ namespace Crescendo {
         hasShutdown = true;
         
         std::cout << "[Engine] Commencing Shutdown..." << std::endl;
+        inputRecorder.Stop();
+        frameTimings.Close();
+        if (renderThread.joinable()) {
+            // The frame being recorded finishes, anything still waiting is dropped
+            renderPackets.Close();
+            renderThread.join();
+        }
+        JobSystem::Get().Stop(); // Queued jobs are drained too (pending bakes included) before their servers go
         if (activePlayer) { delete activePlayer; activePlayer = nullptr; }
         if (sceneManager) { sceneManager.reset(); }
         scene.entities.clear(); 
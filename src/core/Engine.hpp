@@ -1,11 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <thread>
 #include "controllers/FPSController.hpp"
 #include "servers/display/DisplayServer.hpp"
 #include "servers/audio/AudioServer.hpp"
 #include "servers/physics/PhysicsServer.hpp" 
+#include "servers/camera/Camera.hpp"
 #include "core/ScriptSystem.hpp"
+#include "core/FixedTimestep.hpp"
+#include "core/TripleBuffer.hpp"
+#include "core/InputRecorder.hpp"
 
 #include "servers/rendering/IRenderer.hpp" 
 
@@ -13,12 +20,25 @@
 #include "core/EngineState.hpp"
 
 namespace Crescendo {
+
+    // How the engine was launched, filled from the command line
+    struct LaunchOptions {
+        bool headless = false;          // No window, audio or GPU: NullRenderer, simulation only
+        float tickRate = 0.0f;          // Headless tick rate, 0 = [Server] tick_rate
+        uint64_t maxTicks = 0;          // Headless: quit once this many ticks ran, 0 = until interrupted
+        std::string scenePath;          // Loaded before the first tick
+        bool spawnPlanet = false;       // Headless: stream a procedural planet, for terrain benchmarks
+        std::string recordPath;         // Capture every frame's input here
+        std::string replayPath;         // Drive the run from a capture instead of SDL, quit at its end
+        std::string timingsPath;        // Per-frame timing CSV, defaults to <capture>.csv when replaying
+    };
+
     class Engine {
     public:
         Engine();
         ~Engine();
 
-        bool Initialize(const char* title, int width, int height);
+        bool Initialize(const char* title, int width, int height, const LaunchOptions& options = LaunchOptions{});
         void Run();
         void Shutdown();
 
@@ -26,10 +46,13 @@ namespace Crescendo {
         EngineState previousState = EngineState::Editor;
 
         FPSController* activePlayer = nullptr;
-        CBaseEntity* localPlayerModel = nullptr;
+        EntityHandle localPlayerModel;      // Handle, not a pointer: the editor can delete it under us
         bool playerSpawned = false;
         
         DisplayServer displayServer;
+
+        // The editor flies it, play mode rides the player, headless streams terrain around it
+        Camera camera;
         
         // --- 3. THE SWAP ---
         std::unique_ptr<IRenderer> renderer;
@@ -41,12 +64,41 @@ namespace Crescendo {
         // SYSTEMS
         ScriptSystem scriptSystem;
         Scene scene; 
+        FixedTimestep simClock;             // Rate from [Simulation] in engine_settings.toml
         
     private:
         bool isRunning;
+        LaunchOptions launch;
         std::unique_ptr<SceneManager> sceneManager;
+
+        // --- RENDER PIPELINE ---
+        // This thread builds render packets, the render thread draws them one frame behind.
+        // Off (render_thread = false) both halves run back to back on this thread.
+        TripleBuffer<RenderPacket> renderPackets;
+        std::thread renderThread;
+        bool pipelinedRendering = false;
+
+        // Player position at the start and end of the latest tick, the camera is drawn in between
+        glm::vec3 playerPrevPosition = glm::vec3(0.0f);
+        glm::vec3 playerPosition = glm::vec3(0.0f);
+
+        double tickMsTotal = 0.0;           // Summed over the run, for the headless report
+
+        // --- RECORD / REPLAY ---
+        InputRecorder inputRecorder;
+        InputFrame capturedInput;           // This frame's record, finished once its ticks are known
+        FrameTimingLog frameTimings;
+
         void ProcessEvents();
-        void Update();
-        void Render();
+        void Update(double frameSeconds);   // Once per rendered frame
+        void Tick(float dt);                // Once per fixed simulation step, Playing only
+        void Render();                      // Builds this frame's packet and hands it over
+        void RenderLoop();                  // Render thread body
+        void RunHeadless();                 // Run() without frames: ticks, then sleeps until the next is due
+        void SpawnLocalPlayer(const glm::vec3& spawnLocation);
+        void SpawnBenchmarkPlanet();
+        void RegisterSystems();
+        bool BeginInputFrame(double& frameSeconds);    // Reads (or replays) this frame's input, false once a replay ran out
+        void EndInputFrame(uint32_t ticks);
     };
 }
\ No newline at end of file
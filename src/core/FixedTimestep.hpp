@@ -0,0 +1,48 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+namespace Crescendo {
+
+    // =========================================================
+    // FIXED TIMESTEP
+    // Wall time goes into an accumulator, the simulation drains it in
+    // whole ticks of 1/rate seconds. Whatever is left over is how far
+    // the rendered frame sits between the last two ticks (Alpha).
+    // Ticks per frame are capped so a hitch on a slow machine drops
+    // time instead of spiraling into ever longer frames.
+    // =========================================================
+
+    class FixedTimestep {
+    public:
+        static constexpr double MAX_FRAME_SECONDS = 0.25;   // Breakpoints, window drags, level loads
+
+        void SetRate(float hz) { step = 1.0 / std::clamp<double>(hz, 1.0, 1000.0); }
+        void SetMaxTicksPerFrame(uint32_t ticks) { maxTicks = std::max(1u, ticks); }
+
+        // Adds one frame of wall time, returns how many ticks to run now
+        uint32_t Advance(double frameSeconds) {
+            accumulator += std::min(std::max(frameSeconds, 0.0), MAX_FRAME_SECONDS);
+
+            uint32_t ticks = static_cast<uint32_t>(accumulator / step);
+            if (ticks > maxTicks) {
+                ticks = maxTicks;
+                accumulator = step * ticks;   // Fall behind on purpose, the rest is dropped
+            }
+            accumulator -= step * ticks;
+            return ticks;
+        }
+
+        // Start from a clean tick, e.g. on entering Play
+        void Reset() { accumulator = 0.0; }
+
+        double Step() const { return step; }
+        float Rate() const { return static_cast<float>(1.0 / step); }
+        float Alpha() const { return static_cast<float>(accumulator / step); }
+
+    private:
+        double step = 1.0 / 60.0;
+        double accumulator = 0.0;
+        uint32_t maxTicks = 5;
+    };
+}
@@ -1,4 +1,6 @@
 #include "core/Input.hpp"
+#include <algorithm>
+#include <iterator>
 
 namespace Crescendo {
 
@@ -12,6 +14,9 @@ namespace Crescendo {
     int Input::mouseRelY = 0;
     int Input::scrollY = 0;
 
+    // Keyboard state served while replaying
+    static Uint8 injectedKeys[SDL_NUM_SCANCODES];
+
     void Input::Update() {
         keyboardState = SDL_GetKeyboardState(NULL);
         
@@ -31,4 +36,24 @@ namespace Crescendo {
         return (mouseState & SDL_BUTTON(button));
     }
 
+    void Input::PressedKeys(std::vector<uint16_t>& out) {
+        out.clear();
+        if (!keyboardState) return;
+        for (int key = 0; key < SDL_NUM_SCANCODES; key++) {
+            if (keyboardState[key]) out.push_back(static_cast<uint16_t>(key));
+        }
+    }
+
+    void Input::Inject(const std::vector<uint16_t>& keys, int relX, int relY, Uint32 buttons) {
+        std::fill(std::begin(injectedKeys), std::end(injectedKeys), 0);
+        for (uint16_t key : keys) {
+            if (key < SDL_NUM_SCANCODES) injectedKeys[key] = 1;
+        }
+
+        keyboardState = injectedKeys;
+        mouseRelX = relX;
+        mouseRelY = relY;
+        mouseState = buttons;
+    }
+
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define INPUT_HPP
 
 #include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
 
 namespace Crescendo {
     class Input {
@@ -10,6 +12,13 @@ namespace Crescendo {
         static bool IsKeyDown(SDL_Scancode key);
         static bool IsMouseButtonDown(int button);
 
+        // --- Record / Replay ---
+        static void PressedKeys(std::vector<uint16_t>& out);
+        static Uint32 MouseButtons() { return mouseState; }
+
+        // Serves a recorded frame instead of the SDL state, until the next Update()
+        static void Inject(const std::vector<uint16_t>& keys, int relX, int relY, Uint32 buttons);
+
         static int mouseX, mouseY;
         static int mouseRelX, mouseRelY;
         static int scrollY;
@@ -0,0 +1,191 @@
+#include "core/InputRecorder.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace Crescendo {
+
+    static constexpr const char* CAPTURE_MAGIC = "crescendo-input";
+    static constexpr int CAPTURE_VERSION = 1;
+
+    // =========================================================
+    // RECORDING
+    // =========================================================
+
+    bool InputRecorder::StartRecording(const std::string& path, const InputCaptureHeader& captureHeader) {
+        if (recordFile.is_open()) recordFile.close();
+
+        recordFile.open(path);
+        if (!recordFile.is_open()) {
+            std::cerr << "[Input] Failed to open " << path << " for recording!" << std::endl;
+            return false;
+        }
+
+        header = captureHeader;
+        recordPath = path;
+        recorded = 0;
+
+        recordFile << CAPTURE_MAGIC << " " << CAPTURE_VERSION << "\n";
+        recordFile << "tick_rate " << std::setprecision(std::numeric_limits<float>::max_digits10) << header.tickRate << "\n";
+        recordFile << "max_ticks " << header.maxTicksPerFrame << "\n";
+        if (!header.scenePath.empty()) recordFile << "scene " << header.scenePath << "\n";
+        recordFile << "frames\n";
+
+        std::cout << "[Input] Recording to " << path << std::endl;
+        return true;
+    }
+
+    void InputRecorder::Record(const InputFrame& frame) {
+        if (!recordFile.is_open()) return;
+
+        // Full precision, the replay has to feed the clock the exact same doubles
+        recordFile << std::setprecision(std::numeric_limits<double>::max_digits10) << frame.frameSeconds;
+        recordFile << std::setprecision(std::numeric_limits<float>::max_digits10);
+        recordFile << " " << frame.ticks << " " << static_cast<int>(frame.state)
+                   << " " << frame.cameraPosition.x << " " << frame.cameraPosition.y << " " << frame.cameraPosition.z
+                   << " " << frame.cameraYaw << " " << frame.cameraPitch
+                   << " " << frame.mouseRelX << " " << frame.mouseRelY << " " << frame.mouseButtons
+                   << " " << frame.keys.size();
+        for (uint16_t key : frame.keys) recordFile << " " << key;
+        recordFile << "\n";
+        recorded++;
+    }
+
+    // =========================================================
+    // REPLAY
+    // =========================================================
+
+    bool InputRecorder::LoadReplay(const std::string& path) {
+        replaying = false;
+
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "[Input] Failed to open capture " << path << std::endl;
+            return false;
+        }
+
+        std::string magic;
+        int version = 0;
+        file >> magic >> version;
+        if (magic != CAPTURE_MAGIC || version != CAPTURE_VERSION) {
+            std::cerr << "[Input] " << path << " is not a version " << CAPTURE_VERSION << " input capture!" << std::endl;
+            return false;
+        }
+
+        header = InputCaptureHeader{};
+        std::string key;
+        while (file >> key && key != "frames") {
+            if (key == "tick_rate") file >> header.tickRate;
+            else if (key == "max_ticks") file >> header.maxTicksPerFrame;
+            else if (key == "scene") { file >> std::ws; std::getline(file, header.scenePath); }
+            else std::getline(file, key); // Unknown field from a newer writer, skip the line
+        }
+
+        frames.clear();
+        InputFrame frame;
+        int state = 0;
+        size_t keyCount = 0;
+        while (file >> frame.frameSeconds >> frame.ticks >> state
+                    >> frame.cameraPosition.x >> frame.cameraPosition.y >> frame.cameraPosition.z
+                    >> frame.cameraYaw >> frame.cameraPitch
+                    >> frame.mouseRelX >> frame.mouseRelY >> frame.mouseButtons >> keyCount) {
+            if (keyCount > 512) break;    // SDL_NUM_SCANCODES, anything more is a broken line
+            frame.state = static_cast<EngineState>(state);
+            frame.keys.resize(keyCount);
+            for (uint16_t& scancode : frame.keys) file >> scancode;
+            frames.push_back(frame);
+        }
+
+        if (frames.empty()) {
+            std::cerr << "[Input] " << path << " has no frames!" << std::endl;
+            return false;
+        }
+
+        cursor = 0;
+        replaying = true;
+        desynced = false;
+        std::cout << "[Input] Replaying " << frames.size() << " frames from " << path << " at " << header.tickRate << " Hz." << std::endl;
+        return true;
+    }
+
+    const InputFrame* InputRecorder::Next() {
+        if (!replaying || cursor >= frames.size()) return nullptr;
+        return &frames[cursor++];
+    }
+
+    void InputRecorder::CheckTicks(uint32_t ticks) {
+        if (!replaying || cursor == 0 || desynced) return;
+
+        const InputFrame& frame = frames[cursor - 1];
+        if (frame.ticks != ticks) {
+            // Reported once, everything after this point is compared against a different world
+            std::cerr << "[Input] Replay desync at frame " << cursor - 1 << ": captured " << frame.ticks
+                      << " ticks, ran " << ticks << "." << std::endl;
+            desynced = true;
+        }
+    }
+
+    void InputRecorder::Stop() {
+        if (recordFile.is_open()) {
+            recordFile.close();
+            std::cout << "[Input] Recorded " << recorded << " frames to " << recordPath << std::endl;
+        }
+
+        if (replaying) {
+            std::cout << "[Input] Replay stopped after " << cursor << " of " << frames.size() << " frames"
+                      << (desynced ? " (desynced)." : ".") << std::endl;
+            frames.clear();
+            replaying = false;
+        }
+    }
+
+    // =========================================================
+    // FRAME TIMING LOG
+    // =========================================================
+
+    bool FrameTimingLog::Open(const std::string& csvPath) {
+        Close();
+
+        file.open(csvPath);
+        if (!file.is_open()) {
+            std::cerr << "[Timings] Failed to open " << csvPath << " for writing!" << std::endl;
+            return false;
+        }
+
+        path = csvPath;
+        frameTimes.clear();
+        file << "frame,tick,ticks,update_ms,render_ms,frame_ms\n";
+        file << std::fixed << std::setprecision(4);
+        return true;
+    }
+
+    void FrameTimingLog::Write(uint64_t tick, uint32_t ticks, double updateMs, double renderMs, double frameMs) {
+        if (!file.is_open()) return;
+
+        file << frameTimes.size() << "," << tick << "," << ticks << ","
+             << updateMs << "," << renderMs << "," << frameMs << "\n";
+        frameTimes.push_back(static_cast<float>(frameMs));
+    }
+
+    void FrameTimingLog::Close() {
+        if (!file.is_open()) return;
+        file.close();
+
+        if (frameTimes.empty()) return;
+
+        std::vector<float> sorted = frameTimes;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&](double p) { return sorted[static_cast<size_t>(p * (sorted.size() - 1))]; };
+
+        double total = 0.0;
+        for (float ms : sorted) total += ms;
+
+        std::streamsize precision = std::cout.precision();
+        std::cout << std::fixed << std::setprecision(3)
+                  << "[Timings] " << sorted.size() << " frames: avg " << total / sorted.size()
+                  << " ms, p50 " << percentile(0.50) << ", p95 " << percentile(0.95)
+                  << ", p99 " << percentile(0.99) << ", max " << sorted.back() << " ms -> " << path << std::endl;
+        std::cout << std::defaultfloat << std::setprecision(precision);
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/EngineState.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // INPUT CAPTURE
+    // One record per Engine::Update: everything that frame took from
+    // outside the simulation. The wall time goes back through the
+    // same fixed-step clock on replay, so the same ticks run with the
+    // same input no matter how fast the replaying machine is.
+    //
+    // Input is sampled once per frame, every tick of a frame sees that
+    // frame's keys. The tick count is stored per record to catch a
+    // replay drifting away from its capture.
+    //
+    // Text, one frame per line, so captures can be checked in and diffed.
+    // =========================================================
+
+    struct InputFrame {
+        double frameSeconds = 0.0;          // Fed to the fixed-step clock
+        uint32_t ticks = 0;                 // Ticks the clock ran for it
+        EngineState state = EngineState::Editor;
+        glm::vec3 cameraPosition = glm::vec3(0.0f);
+        float cameraYaw = 0.0f;
+        float cameraPitch = 0.0f;
+        int32_t mouseRelX = 0;
+        int32_t mouseRelY = 0;
+        uint32_t mouseButtons = 0;
+        std::vector<uint16_t> keys;         // Scancodes held down
+    };
+
+    struct InputCaptureHeader {
+        float tickRate = 60.0f;
+        uint32_t maxTicksPerFrame = 5;
+        std::string scenePath;              // Empty = the default scene
+    };
+
+    class InputRecorder {
+    public:
+        ~InputRecorder() { Stop(); }
+
+        // --- Recording ---
+        bool StartRecording(const std::string& path, const InputCaptureHeader& captureHeader);
+        void Record(const InputFrame& frame);
+        bool IsRecording() const { return recordFile.is_open(); }
+
+        // --- Replay ---
+        bool LoadReplay(const std::string& path);
+        bool IsReplaying() const { return replaying; }
+        const InputCaptureHeader& Header() const { return header; }
+
+        const InputFrame* Next();           // nullptr once every frame was served
+        void CheckTicks(uint32_t ticks);    // Against the frame Next() last served
+
+        void Stop();
+
+    private:
+        InputCaptureHeader header;
+
+        std::ofstream recordFile;
+        std::string recordPath;
+        uint64_t recorded = 0;
+
+        std::vector<InputFrame> frames;
+        size_t cursor = 0;
+        bool replaying = false;
+        bool desynced = false;
+    };
+
+    // =========================================================
+    // FRAME TIMING LOG
+    // Per-frame CPU timings as CSV, plus a percentile summary on
+    // close, so runs of the same capture can be compared across builds.
+    // =========================================================
+
+    class FrameTimingLog {
+    public:
+        ~FrameTimingLog() { Close(); }
+
+        bool Open(const std::string& path);
+        bool IsOpen() const { return file.is_open(); }
+
+        void Write(uint64_t tick, uint32_t ticks, double updateMs, double renderMs, double frameMs);
+        void Close();
+
+    private:
+        std::ofstream file;
+        std::string path;
+        std::vector<float> frameTimes;
+    };
+}
@@ -0,0 +1,230 @@
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace Crescendo {
+
+    // Which pool the current thread works for, and its queue there
+    thread_local const JobSystem* currentPool = nullptr;
+    thread_local uint32_t currentWorker = 0;
+
+    JobSystem& JobSystem::Get() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    JobSystem::JobSystem(uint32_t workerCount) {
+        if (workerCount == 0) {
+            uint32_t hardware = std::thread::hardware_concurrency();
+            workerCount = hardware > 1 ? hardware - 1 : 1;
+        }
+
+        for (uint32_t i = 0; i <= workerCount; i++) queues.push_back(std::make_unique<Queue>());
+
+        running = true;
+        for (uint32_t i = 0; i < workerCount; i++) {
+            workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+        std::cout << "[Jobs] " << workerCount << " worker threads started." << std::endl;
+    }
+
+    JobSystem::~JobSystem() {
+        Stop();
+    }
+
+    void JobSystem::Stop() {
+        if (!running.exchange(false)) return;
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_all();
+
+        // Workers empty the queues before they exit. Continuations released meanwhile run
+        // inline (Push no longer queues), so no counter is left pending behind the join.
+        for (auto& worker : workers) worker.join();
+        workers.clear();
+
+        // Jobs pushed while the flag was flipping can still land after the last worker left
+        size_t stragglers = 0;
+        for (auto& queue : queues) {
+            for (auto& jobs : queue->jobs) {
+                while (!jobs.empty()) {
+                    Job job = std::move(jobs.front());
+                    jobs.pop_front();
+                    Execute(job);
+                    stragglers++;
+                }
+            }
+        }
+        queued = 0;
+        std::cout << "[Jobs] Stopped";
+        if (stragglers > 0) std::cout << " (" << stragglers << " late jobs ran on the caller)";
+        std::cout << "." << std::endl;
+    }
+
+    // =========================================================
+    // SUBMISSION
+    // =========================================================
+
+    void JobSystem::Submit(std::function<void()> fn, JobPriority priority, JobCounter* counter) {
+        if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+        Push(Job{ std::move(fn), priority, counter });
+    }
+
+    void JobSystem::SubmitAfter(JobCounter& dependency, std::function<void()> fn, JobPriority priority, JobCounter* counter) {
+        if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+        Job job{ std::move(fn), priority, counter };
+
+        {
+            std::lock_guard<std::mutex> lock(dependency.mutex);
+            if (dependency.pending.load(std::memory_order_acquire) != 0) {
+                dependency.continuations.push_back(std::move(job));
+                return;
+            }
+        }
+        Push(std::move(job));
+    }
+
+    void JobSystem::Push(Job job) {
+        if (!running || workers.empty()) {
+            Execute(job);
+            return;
+        }
+
+        // Workers keep their own spawn local, everyone else goes through the shared queue
+        Queue& queue = currentPool == this ? *queues[currentWorker] : *queues.back();
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs[static_cast<size_t>(job.priority)].push_back(std::move(job));
+        }
+        queued.fetch_add(1, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_one();
+    }
+
+    // =========================================================
+    // EXECUTION
+    // =========================================================
+
+    bool JobSystem::TryPop(JobPriority lowest, Job& out) {
+        if (queued.load(std::memory_order_acquire) == 0) return false;
+
+        bool isWorker = currentPool == this;
+        size_t self = isWorker ? currentWorker : queues.size() - 1;
+
+        for (size_t p = 0; p <= static_cast<size_t>(lowest); p++) {
+            // 1. Own queue, newest first while it's still hot in cache
+            if (isWorker) {
+                Queue& own = *queues[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.jobs[p].empty()) {
+                    out = std::move(own.jobs[p].back());
+                    own.jobs[p].pop_back();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            // 2. Everyone else's, oldest first, starting next door so thieves spread out
+            for (size_t i = 1; i <= queues.size(); i++) {
+                size_t victim = (self + i) % queues.size();
+                if (isWorker && victim == self) continue;
+
+                Queue& other = *queues[victim];
+                std::lock_guard<std::mutex> lock(other.mutex);
+                if (!other.jobs[p].empty()) {
+                    out = std::move(other.jobs[p].front());
+                    other.jobs[p].pop_front();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    if (victim != queues.size() - 1) stolen.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::Execute(Job& job) {
+        job.fn();
+        executed.fetch_add(1, std::memory_order_relaxed);
+
+        JobCounter* counter = job.counter;
+        if (!counter) return;
+
+        // Last one out releases the continuations. The counter isn't touched after the
+        // lock is released: a waiter may destroy it the moment it sees zero.
+        std::vector<Job> next;
+        {
+            std::lock_guard<std::mutex> lock(counter->mutex);
+            if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) next.swap(counter->continuations);
+        }
+        for (Job& cont : next) Push(std::move(cont));
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index) {
+        currentPool = this;
+        currentWorker = index;
+        PROFILE_THREAD("Worker " + std::to_string(index));
+
+        for (;;) {
+            Job job;
+            if (TryPop(JobPriority::Low, job)) {
+                Execute(job);
+                continue;
+            }
+            if (!running) break;    // Only once the queues are dry, Stop relies on it
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this]() { return !running || queued.load(std::memory_order_acquire) > 0; });
+        }
+    }
+
+    void JobSystem::Wait(JobCounter& counter) {
+        while (!counter.Done()) {
+            Job job;
+            if (TryPop(JobPriority::High, job)) {
+                Execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+        grain = std::max<size_t>(grain, 1);
+        size_t batches = (count + grain - 1) / grain;
+        if (batches == 0) return;
+        if (batches == 1 || workers.empty()) {
+            for (size_t b = 0; b < batches; b++) fn(b * grain, std::min((b + 1) * grain, count));
+            return;
+        }
+
+        // A few helpers pull batches off a shared cursor, so the queues see
+        // one job per helping worker instead of one per batch
+        std::atomic<size_t> next{ 0 };
+        auto drain = [&]() {
+            for (size_t b = next.fetch_add(1); b < batches; b = next.fetch_add(1)) {
+                fn(b * grain, std::min((b + 1) * grain, count));
+            }
+        };
+
+        JobCounter counter;
+        size_t helpers = std::min<size_t>(workers.size(), batches - 1);
+        for (size_t i = 0; i < helpers; i++) Submit(drain, JobPriority::High, &counter);
+
+        drain();
+        Wait(counter);
+    }
+
+    JobStats JobSystem::Stats() const {
+        JobStats stats;
+        stats.executed = executed.load(std::memory_order_relaxed);
+        stats.stolen = stolen.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
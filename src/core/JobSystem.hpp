@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Crescendo {
+
+    // =========================================================
+    // JOB SYSTEM
+    // One pool of worker threads for the whole engine, sized from the
+    // hardware (one core is left to the thread that drives the frame).
+    // Every worker owns a queue per priority: it pops its own work
+    // newest-first and steals from the others oldest-first once it
+    // runs dry. Threads that aren't workers submit into a shared queue.
+    //
+    // There are no fibers. A waiting thread helps by running High jobs
+    // until its counter drains, and work that must follow other work is
+    // chained with SubmitAfter instead of blocking a worker.
+    // =========================================================
+
+    enum class JobPriority : uint32_t {
+        High,       // Frame-critical fan-out: physics, transforms, system batches
+        Normal,
+        Low,        // Background streaming, e.g. terrain bakes. Never run by a waiting thread.
+        Count
+    };
+
+    class JobCounter;
+
+    struct Job {
+        std::function<void()> fn;
+        JobPriority priority = JobPriority::Normal;
+        JobCounter* counter = nullptr;      // Signalled once fn returns
+    };
+
+    // Counts jobs in flight. Done() once every job submitted against it has run,
+    // after which the counter may be destroyed or reused.
+    class JobCounter {
+    public:
+        bool Done() const {
+            if (pending.load(std::memory_order_acquire) != 0) return false;
+            // The last job drops to zero inside the lock, wait for it to let go before anyone frees us
+            std::lock_guard<std::mutex> lock(mutex);
+            return true;
+        }
+
+    private:
+        friend class JobSystem;
+        std::atomic<int32_t> pending{ 0 };
+        mutable std::mutex mutex;
+        std::vector<Job> continuations;     // Submitted the moment pending hits zero
+    };
+
+    struct JobStats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+    };
+
+    class JobSystem {
+    public:
+        // Created and started on first use
+        static JobSystem& Get();
+
+        explicit JobSystem(uint32_t workerCount = 0);   // 0 = hardware threads - 1
+        ~JobSystem();
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Joins the workers once they've run everything still queued, continuations
+        // included. Anything submitted afterwards runs inline on the caller.
+        void Stop();
+
+        uint32_t WorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+
+        void Submit(std::function<void()> fn, JobPriority priority = JobPriority::Normal, JobCounter* counter = nullptr);
+
+        // Continuation: queued once 'dependency' drains, nobody blocks in between
+        void SubmitAfter(JobCounter& dependency, std::function<void()> fn, JobPriority priority = JobPriority::Normal, JobCounter* counter = nullptr);
+
+        // Returns once the counter drains, running High jobs meanwhile
+        void Wait(JobCounter& counter);
+
+        // fn(begin, end) over [0, count) in batches of exactly [k * grain, (k + 1) * grain).
+        // The caller takes batches too and returns when all are done.
+        void ParallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& fn);
+
+        // For results picked up later, e.g. polled with wait_for(0) on the render thread
+        template<typename Fn>
+        auto Async(Fn&& fn, JobPriority priority = JobPriority::Low) -> std::future<std::invoke_result_t<Fn>> {
+            using Result = std::invoke_result_t<Fn>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+            std::future<Result> result = task->get_future();
+            Submit([task]() { (*task)(); }, priority);
+            return result;
+        }
+
+        JobStats Stats() const;
+
+    private:
+        static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(JobPriority::Count);
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Job> jobs[PRIORITY_COUNT];
+        };
+
+        // queues[i] belongs to worker i, the last one takes submissions from other threads
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+
+        std::atomic<bool> running{ false };
+        std::atomic<size_t> queued{ 0 };
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+
+        std::atomic<uint64_t> executed{ 0 };
+        std::atomic<uint64_t> stolen{ 0 };
+
+        void Push(Job job);
+        bool TryPop(JobPriority lowest, Job& out);
+        void Execute(Job& job);
+        void WorkerLoop(uint32_t index);
+    };
+}
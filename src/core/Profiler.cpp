@@ -0,0 +1,193 @@
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace Crescendo {
+
+    thread_local ProfileThread* currentProfileThread = nullptr;
+
+    // =========================================================
+    // THREAD RINGS
+    // =========================================================
+
+    void ProfileThread::Collect(uint64_t from, uint64_t to, std::vector<ProfileEvent>& out) const {
+        uint64_t last = head.load(std::memory_order_acquire);
+        uint64_t first = last > CAPACITY ? last - CAPACITY : 0;
+
+        std::vector<std::pair<uint64_t, ProfileEvent>> copied;
+        copied.reserve(static_cast<size_t>(last - first));
+        for (uint64_t index = first; index < last; index++) {
+            const Slot& slot = slots[index & (CAPACITY - 1)];
+            ProfileEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.start = slot.start.load(std::memory_order_relaxed);
+            event.end = slot.end.load(std::memory_order_relaxed);
+            event.depth = slot.depth.load(std::memory_order_relaxed);
+            copied.push_back({ index, event });
+        }
+
+        // Anything the owner started writing since then may be torn, drop the slots it reached
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t reached = claimed.load(std::memory_order_relaxed);
+        uint64_t intact = reached > CAPACITY ? reached - CAPACITY : 0;
+
+        for (const auto& [index, event] : copied) {
+            if (index < intact || !event.name) continue;
+            if (event.end < from || event.start > to) continue;
+            out.push_back(event);
+        }
+    }
+
+    // =========================================================
+    // PROFILER
+    // =========================================================
+
+    Profiler& Profiler::Get() {
+        static Profiler instance;
+        return instance;
+    }
+
+    std::chrono::steady_clock::time_point Profiler::Epoch() {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return epoch;
+    }
+
+    ProfileThread& Profiler::ThisThread() {
+        if (currentProfileThread) return *currentProfileThread;
+
+        Profiler& profiler = Get();
+        std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+        uint32_t id = static_cast<uint32_t>(profiler.threads.size());
+        profiler.threads.push_back(std::make_unique<ProfileThread>(id));
+        profiler.threadNames.push_back("Thread " + std::to_string(id));
+        currentProfileThread = profiler.threads.back().get();
+        return *currentProfileThread;
+    }
+
+    void Profiler::SetThreadName(const std::string& name) {
+        ProfileThread& thread = ThisThread();
+        Profiler& profiler = Get();
+        std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+        profiler.threadNames[thread.id] = name;
+    }
+
+    const char* Profiler::Intern(const std::string& name) {
+        Profiler& profiler = Get();
+        std::lock_guard<std::mutex> lock(profiler.internMutex);
+        return profiler.interned.insert(name).first->c_str();
+    }
+
+    void Profiler::BeginFrame() {
+        uint64_t now = Now();
+        std::lock_guard<std::mutex> lock(framesMutex);
+
+        if (IsRecording() && frameStart != 0) {
+            ProfileFrame frame{ frameStart, now };
+            if (frames.size() < MAX_FRAMES) {
+                frames.push_back(frame);
+            } else {
+                frames[frameHead] = frame;
+                frameHead = (frameHead + 1) % MAX_FRAMES;
+            }
+        }
+        frameStart = now;
+    }
+
+    std::vector<ProfileFrame> Profiler::Frames() const {
+        std::lock_guard<std::mutex> lock(framesMutex);
+        std::vector<ProfileFrame> ordered;
+        ordered.reserve(frames.size());
+        for (size_t i = 0; i < frames.size(); i++) ordered.push_back(frames[(frameHead + i) % frames.size()]);
+        return ordered;
+    }
+
+    std::vector<ProfileThreadCapture> Profiler::Capture(uint64_t from, uint64_t to) const {
+        std::vector<ProfileThreadCapture> captures;
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        captures.reserve(threads.size());
+
+        for (size_t i = 0; i < threads.size(); i++) {
+            ProfileThreadCapture capture;
+            capture.id = threads[i]->id;
+            capture.name = threadNames[i];
+            threads[i]->Collect(from, to, capture.events);
+
+            // Completion order puts children before their parents, draw order wants starts
+            std::sort(capture.events.begin(), capture.events.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+                return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+            });
+            captures.push_back(std::move(capture));
+        }
+        return captures;
+    }
+
+    // =========================================================
+    // CHROME TRACE EXPORT
+    // "X" (complete) events in microseconds, one tid per thread,
+    // frame starts as global instant events.
+    // =========================================================
+
+    static void WriteJsonString(std::ofstream& file, const std::string& text) {
+        file << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') file << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) file << ' ';
+            else file << c;
+        }
+        file << '"';
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string& path) const {
+        std::vector<ProfileThreadCapture> captures = Capture(0, std::numeric_limits<uint64_t>::max());
+        std::vector<ProfileFrame> frameList = Frames();
+
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "[Profiler] Failed to open " << path << " for writing!" << std::endl;
+            return false;
+        }
+
+        char number[32];
+        auto micros = [&](uint64_t nanos) -> const char* {
+            std::snprintf(number, sizeof(number), "%.3f", nanos / 1000.0);
+            return number;
+        };
+
+        size_t written = 0;
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&]() {
+            if (!first) file << ",\n";
+            first = false;
+        };
+
+        for (const ProfileThreadCapture& capture : captures) {
+            separator();
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << capture.id << ",\"args\":{\"name\":";
+            WriteJsonString(file, capture.name);
+            file << "}}";
+
+            for (const ProfileEvent& event : capture.events) {
+                separator();
+                file << "{\"name\":";
+                WriteJsonString(file, event.name);
+                file << ",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":" << micros(event.start);
+                file << ",\"dur\":" << micros(event.end - event.start);
+                file << ",\"pid\":1,\"tid\":" << capture.id << "}";
+                written++;
+            }
+        }
+
+        for (const ProfileFrame& frame : frameList) {
+            separator();
+            file << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << micros(frame.start) << ",\"pid\":1,\"tid\":0}";
+        }
+
+        file << "\n]}\n";
+        std::cout << "[Profiler] Wrote " << written << " events from " << captures.size() << " threads to " << path << std::endl;
+        return true;
+    }
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Build with -DCRESCENDO_PROFILER=0 (CMake option CRESCENDO_PROFILER=OFF)
+// and every marker below compiles to nothing
+#ifndef CRESCENDO_PROFILER
+#define CRESCENDO_PROFILER 1
+#endif
+
+namespace Crescendo {
+
+    // =========================================================
+    // CPU PROFILER
+    // Scoped markers record {name, start, end, depth} into a ring
+    // buffer owned by the thread that ran them, so recording never
+    // takes a lock or allocates. Readers (the editor timeline, the
+    // Chrome trace export) copy the rings from any thread and drop
+    // whatever the owner overwrote while they were copying.
+    //
+    // Names are stored as pointers: pass string literals, __func__,
+    // or anything run through Profiler::Intern.
+    // =========================================================
+
+    struct ProfileEvent {
+        const char* name = nullptr;
+        uint64_t start = 0;         // Nanoseconds since the profiler started
+        uint64_t end = 0;
+        uint32_t depth = 0;         // Nesting on its thread, 0 = outermost
+    };
+
+    struct ProfileFrame {
+        uint64_t start = 0;
+        uint64_t end = 0;
+    };
+
+    // One thread's events between two timestamps, oldest first
+    struct ProfileThreadCapture {
+        uint32_t id = 0;
+        std::string name;
+        std::vector<ProfileEvent> events;
+    };
+
+    class ProfileThread {
+    public:
+        static constexpr uint64_t CAPACITY = 1u << 15;  // Events kept per thread, a power of two
+
+        explicit ProfileThread(uint32_t threadID) : id(threadID), slots(new Slot[CAPACITY]) {}
+
+        // Owner thread only
+        void Push(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+            uint64_t index = head.load(std::memory_order_relaxed);
+
+            // Claim before writing: a reader that sees any of the new fields also sees the claim
+            claimed.store(index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            Slot& slot = slots[index & (CAPACITY - 1)];
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.start.store(start, std::memory_order_relaxed);
+            slot.end.store(end, std::memory_order_relaxed);
+            slot.depth.store(depth, std::memory_order_relaxed);
+
+            head.store(index + 1, std::memory_order_release);
+        }
+
+        // Any thread. Appends the intact events overlapping [from, to].
+        void Collect(uint64_t from, uint64_t to, std::vector<ProfileEvent>& out) const;
+
+        const uint32_t id;
+        uint32_t depth = 0;         // Open scopes, owner thread only
+
+    private:
+        struct Slot {
+            std::atomic<const char*> name{ nullptr };
+            std::atomic<uint64_t> start{ 0 };
+            std::atomic<uint64_t> end{ 0 };
+            std::atomic<uint32_t> depth{ 0 };
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<uint64_t> head{ 0 };        // Events completed
+        std::atomic<uint64_t> claimed{ 0 };     // Events started, at most head + 1
+    };
+
+    class Profiler {
+    public:
+        static Profiler& Get();
+
+        static uint64_t Now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch()).count());
+        }
+
+        // The calling thread's ring, registered on first use
+        static ProfileThread& ThisThread();
+        static void SetThreadName(const std::string& name);
+
+        // Stable copy of a runtime string, for names built at run time (e.g. system names)
+        static const char* Intern(const std::string& name);
+
+        // Paused captures keep what's in the rings, e.g. to inspect a spike
+        bool IsRecording() const { return recording.load(std::memory_order_relaxed); }
+        void SetRecording(bool enabled) { recording.store(enabled, std::memory_order_relaxed); }
+
+        // Main loop, once per frame (or headless iteration)
+        void BeginFrame();
+
+        std::vector<ProfileFrame> Frames() const;                                       // Completed frames, oldest first
+        std::vector<ProfileThreadCapture> Capture(uint64_t from, uint64_t to) const;    // Every thread, by registration order
+
+        // Everything still in the rings as Chrome trace JSON (chrome://tracing, Perfetto)
+        bool ExportChromeTrace(const std::string& path) const;
+
+    private:
+        Profiler() = default;
+
+        static std::chrono::steady_clock::time_point Epoch();
+
+        static constexpr size_t MAX_FRAMES = 300;
+
+        std::atomic<bool> recording{ true };
+
+        mutable std::mutex threadsMutex;
+        std::vector<std::unique_ptr<ProfileThread>> threads;    // Never freed, readers may hold on to them
+        std::vector<std::string> threadNames;
+
+        std::mutex internMutex;
+        std::unordered_set<std::string> interned;
+
+        mutable std::mutex framesMutex;
+        std::vector<ProfileFrame> frames;                       // Ring of MAX_FRAMES
+        size_t frameHead = 0;
+        uint64_t frameStart = 0;
+    };
+
+    class ProfileScope {
+    public:
+#if CRESCENDO_PROFILER
+        explicit ProfileScope(const char* scopeName) { Open(scopeName); }
+        ~ProfileScope() { Close(); }
+
+        // Ends this phase and starts the next one at the same depth
+        void Next(const char* scopeName) {
+            Close();
+            Open(scopeName);
+        }
+
+    private:
+        void Open(const char* scopeName) {
+            if (!Profiler::Get().IsRecording()) return;
+            thread = &Profiler::ThisThread();
+            name = scopeName;
+            depth = thread->depth++;
+            start = Profiler::Now();
+        }
+
+        void Close() {
+            if (!thread) return;
+            thread->depth--;
+            thread->Push(name, start, Profiler::Now(), depth);
+            thread = nullptr;
+        }
+
+        ProfileThread* thread = nullptr;
+        const char* name = nullptr;
+        uint64_t start = 0;
+        uint32_t depth = 0;
+#else
+        explicit ProfileScope(const char*) {}
+        void Next(const char*) {}
+#endif
+
+    public:
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    };
+}
+
+#define CRESCENDO_PROFILE_JOIN_INNER(a, b) a##b
+#define CRESCENDO_PROFILE_JOIN(a, b) CRESCENDO_PROFILE_JOIN_INNER(a, b)
+
+#if CRESCENDO_PROFILER
+    #define PROFILE_SCOPE(name) ::Crescendo::ProfileScope CRESCENDO_PROFILE_JOIN(profileScope_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+    #define PROFILE_PHASE(var, name) ::Crescendo::ProfileScope var(name)
+    #define PROFILE_THREAD(name) ::Crescendo::Profiler::SetThreadName(name)
+    #define PROFILE_FRAME() ::Crescendo::Profiler::Get().BeginFrame()
+#else
+    #define PROFILE_SCOPE(name) ((void)0)
+    #define PROFILE_FUNCTION() ((void)0)
+    #define PROFILE_PHASE(var, name) ::Crescendo::ProfileScope var(name)
+    #define PROFILE_THREAD(name) ((void)0)
+    #define PROFILE_FRAME() ((void)0)
+#endif
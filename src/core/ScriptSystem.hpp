@@ -35,9 +35,13 @@ namespace Crescendo {
 
             // 3. Bind Entity (Crucial for 'this.origin' to work)
             lua.new_usertype<CBaseEntity>("Entity",
-                "origin", &CBaseEntity::origin,
-                "angles", &CBaseEntity::angles,
-                "scale", &CBaseEntity::scale,
+                // Scripts write single fields (this.origin.z = ...), so the getters hand out the column itself
+                "origin", sol::property([](CBaseEntity& e) -> glm::vec3& { return e.MutableOrigin(); },
+                                        [](CBaseEntity& e, const glm::vec3& v) { e.SetOrigin(v); }),
+                "angles", sol::property([](CBaseEntity& e) -> glm::vec3& { return e.MutableAngles(); },
+                                        [](CBaseEntity& e, const glm::vec3& v) { e.SetAngles(v); }),
+                "scale", sol::property([](CBaseEntity& e) -> glm::vec3& { return e.MutableScale(); },
+                                       [](CBaseEntity& e, const glm::vec3& v) { e.SetScale(v); }),
                 "hasScript", &CBaseEntity::hasScript
             );
             
@@ -0,0 +1,70 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+namespace Crescendo {
+
+    // =========================================================
+    // TRIPLE BUFFER
+    // One producer, one consumer, three slots: the one being written,
+    // the one being read and the latest finished one between them.
+    // Neither side ever touches the other's slot, so the producer can
+    // fill frame N+1 while the consumer is still busy with frame N.
+    //
+    // Publish waits while the previous frame hasn't been picked up,
+    // which keeps the producer at most one frame ahead instead of
+    // building frames nobody will draw.
+    // =========================================================
+
+    template<typename T>
+    class TripleBuffer {
+    public:
+        // --- Producer ---
+        T& WriteSlot() { return slots[write]; }
+
+        void Publish() {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this]() { return !fresh || closed; });
+            std::swap(write, ready);
+            fresh = true;
+            changed.notify_all();
+        }
+
+        // --- Consumer ---
+        // Blocks for the next published slot. nullptr once closed and drained.
+        T* Acquire() {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this]() { return fresh || closed; });
+            if (!fresh) return nullptr;
+            std::swap(read, ready);
+            fresh = false;
+            changed.notify_all();
+            return &slots[read];
+        }
+
+        // Wakes both sides for shutdown, Acquire returns nullptr from here on
+        void Close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            fresh = false;
+            changed.notify_all();
+        }
+
+        void Reopen() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = false;
+        }
+
+    private:
+        T slots[3];
+        int write = 0;
+        int ready = 1;
+        int read = 2;
+        bool fresh = false;     // 'ready' holds a frame the consumer hasn't taken yet
+        bool closed = false;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+    };
+}
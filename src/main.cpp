@@ -1,23 +1,37 @@
+#include <cstdlib>
 #include <iostream>
+#include <string>
 #include "core/Engine.hpp"
-#include "servers/rendering/RenderingServer.hpp"
 
 int main(int argc, char* argv[]) {
     Crescendo::Engine engine;
 
+    // --headless [--tick-rate <hz>] [--ticks <n>] [--planet]   dedicated server / CI benchmark
+    // --scene <file.json>                                       load a scene before the first tick
+    // --record <file> | --replay <file> [--timings <file.csv>]  input capture, deterministic replay with frame timings
+    Crescendo::LaunchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") options.headless = true;
+        else if (arg == "--planet") options.spawnPlanet = true;
+        else if (arg == "--tick-rate" && i + 1 < argc) options.tickRate = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--ticks" && i + 1 < argc) options.maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--scene" && i + 1 < argc) options.scenePath = argv[++i];
+        else if (arg == "--record" && i + 1 < argc) options.recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) options.replayPath = argv[++i];
+        else if (arg == "--timings" && i + 1 < argc) options.timingsPath = argv[++i];
+        else std::cerr << "Ignoring unknown argument: " << arg << std::endl;
+    }
+
     // 1. Boot up the engine and core servers
-    if (!engine.Initialize("Crescendo Engine - Editor", 1920, 1080)) {
+    if (!engine.Initialize("Crescendo Engine - Editor", 1920, 1080, options)) {
         std::cerr << "Failed to initialize Crescendo Engine!" << std::endl;
         return -1;
     }
 
-    auto& camera = static_cast<Crescendo::RenderingServer*>(engine.renderer.get())->mainCamera;
-    camera.SetPosition(glm::vec3(0.0f, -10.0f, 5.0f)); 
-    camera.SetRotation(glm::vec3(0.0f, 90.0f, 0.0f)); 
-
     engine.Run();
 
     engine.Shutdown();
 
     return 0;
-}
\ No newline at end of file
+}
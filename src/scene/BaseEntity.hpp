@@ -2,7 +2,12 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <array>
+#include <utility>
 #include "Component.hpp"
+#include "EntityStorage.hpp"
+#include "EntityHandle.hpp"
+#include "EntityClass.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include "servers/camera/Camera.hpp"
@@ -16,8 +21,11 @@ class CBaseEntity;
 class CBaseEntity {
 public:
     
-    int index = -1;
-    std::string className;
+    int index = -1;                 // Slot in Scene::entities, stable for the entity's lifetime
+    EntityHandle handle;            // Slot + generation, safe to hold across deletes
+    std::string className;          // Read-only outside Scene, change it with Scene::SetEntityClass
+    ClassID classID = CLASS_PROP_DYNAMIC;
+    uint32_t classSlot = 0;         // Position in the scene's per-class index set
     std::string targetName;
 
     std::string scriptPath = "";
@@ -28,14 +36,76 @@ public:
         hasScript = !path.empty();
     }
 
-    glm::ivec3 sector = {0, 0, 0};
-    glm::vec3 origin = {0.0f, 0.0f, 0.0f};
-    glm::vec3 angles = {0.0f, 0.0f, 0.0f};
-    glm::vec3 scale  = {1.0f, 1.0f, 1.0f};
+    // --- ARCHETYPE STORAGE ---
+    // Transform, material and link data live in the scene's SoA chunks.
+    // The accessors below resolve this entity's row on every call.
+    EntityStorage* storage = nullptr;
+    EntityLocation location;
+
+    // Local TRS (relative to moveParent). Read-only; the setters flag the
+    // transform dirty, and only when the value actually changes, so a static
+    // entity stays clean however often it is read.
+    const glm::vec3& Origin() const  { return Chunk().origin[Slot()]; }
+    const glm::vec3& Angles() const  { return Chunk().angles[Slot()]; }
+    const glm::vec3& Scale() const   { return Chunk().scale[Slot()]; }
+    const glm::vec4& LocalBounds() const { return Chunk().bounds[Slot()]; }
+
+    void SetOrigin(const glm::vec3& origin)   { if (Origin() != origin) { Chunk().origin[Slot()] = origin; MarkTransformDirty(); } }
+    void SetAngles(const glm::vec3& angles)   { if (Angles() != angles) { Chunk().angles[Slot()] = angles; MarkTransformDirty(); } }
+    void SetScale(const glm::vec3& scale)     { if (Scale() != scale) { Chunk().scale[Slot()] = scale; MarkTransformDirty(); } }
+    void SetLocalBounds(const glm::vec4& bounds) { if (LocalBounds() != bounds) { Chunk().bounds[Slot()] = bounds; MarkTransformDirty(); } }
+
+    // Flag the transform dirty up front and hand out the column, for callers that write fields
+    // in place through a reference (the Lua bindings' this.origin.z = ...)
+    glm::vec3& MutableOrigin() { MarkTransformDirty(); return Chunk().origin[Slot()]; }
+    glm::vec3& MutableAngles() { MarkTransformDirty(); return Chunk().angles[Slot()]; }
+    glm::vec3& MutableScale()  { MarkTransformDirty(); return Chunk().scale[Slot()]; }
+
+    glm::ivec3& Sector() { return Chunk().sector[Slot()]; }
+    const glm::ivec3& Sector() const { return Chunk().sector[Slot()]; }
+
+    // Mutable access flags the renderer's copy dirty: write through it, read through
+    // the const overload (std::as_const on a non-const entity)
+    MaterialData& Material() { MarkRenderDirty(); return Chunk().material[Slot()]; }
+    const MaterialData& Material() const { return Chunk().material[Slot()]; }
+
+    // World transform as of the last TransformSystem::Update
+    const glm::mat4& WorldMatrix() const { return Chunk().world[Slot()]; }
+    glm::vec3 WorldPosition() const { return glm::vec3(WorldMatrix()[3]); }
+
+    // LocalBounds() pushed through the world matrix, xyz center + w radius
+    glm::vec4 WorldBounds() const { return EntityChunk::WorldSphere(WorldMatrix(), LocalBounds()); }
+
+    void MarkTransformDirty() { Chunk().dirty[Slot()] = 1; }
+    bool IsTransformDirty() const { return Chunk().dirty[Slot()] != 0; }
+
+    // Set by TransformSystem and Material(), cleared once the renderer has copied the row
+    void MarkRenderDirty() { Chunk().renderDirty[Slot()] = 1; }
+    void ClearRenderDirty() { Chunk().renderDirty[Slot()] = 0; }
+
+    // Links are only present once the entity has migrated into an archetype that carries them
+    PhysicsLink* GetPhysicsLink() { return Chunk().physics ? &Chunk().physics[Slot()] : nullptr; }
+    NetworkLink* GetNetworkLink() { return Chunk().network ? &Chunk().network[Slot()] : nullptr; }
+
+    PhysicsLink& EnablePhysicsLink() {
+        if (!GetPhysicsLink()) storage->Migrate(this, storage->MaskOf(location) | GROUP_PHYSICS);
+        return *GetPhysicsLink();
+    }
+
+    // A fresh link takes its ID from targetName (see EntityStorage::AllocateNetworkID), name the entity first
+    NetworkLink& EnableNetworkLink() {
+        if (!GetNetworkLink()) {
+            storage->Migrate(this, storage->MaskOf(location) | GROUP_NETWORK);
+            GetNetworkLink()->networkID = storage->AllocateNetworkID(targetName);
+        }
+        return *GetNetworkLink();
+    }
 
-    glm::vec3 savedOrigin = glm::vec3(0.0f);
-    glm::vec3 savedAngles = glm::vec3(0.0f);
-    glm::vec3 savedScale = glm::vec3(1.0f);
+    // False when another entity already owns the ID
+    bool SetNetworkID(uint32_t id) {
+        EnableNetworkLink();
+        return storage->SetNetworkID(this, id);
+    }
 
     std::vector<Crescendo::Camera> cameras;
     
@@ -57,33 +127,10 @@ public:
     std::vector<CBaseEntity*> children;
     
     int modelIndex = -1;
-    int textureID = 0;
-    int normalTextureID = 0;
-    int ormTextureID = 0;    // NEW: Occlusion, Roughness, Metallic Map
     bool visible = true;
     std::string modelPath = "";
     std::string assetPath = "";
 
-    // [BSDF DEFAULTS]
-    float roughness = 0.0f;
-    float metallic = 0.0f;
-    float emission = 0.0f;
-    float normalStrength = 0.0f;                                // default to 0 to assume no normal map
-    float transmission = 0.0f;                                  // 0.0 = Opaque, 1.0 = glass
-    float thickness = 0.0f;                                     // average thickness
-    float attenuationDistance = 1.0f;                           // Distance at which color is fully absorbed
-    float ior = 1.5f;
-    glm::vec3 attenuationColor = {1.0f, 1.0f, 1.0f};     // The color of the glass
-    glm::vec3 albedoColor = {1.0f, 1.0f, 1.0f};   
-    float clearcoat = 0.0f;                                     // advanced pbr sheedn and clearcoat ORM
-    float clearcoatRoughness = 0.03f;
-    float sheen = 0.0f;
-    float specularWeight = 0.5f;
-    float subsurface = 0.0f;
-    float specular = 0.0f;
-    float specularTint = 0.0f;
-    float anisotropic = 0.0f;
-
     static constexpr float SECTOR_SIZE = 1024.0f;
 
     virtual ~CBaseEntity() {}
@@ -102,39 +149,46 @@ public:
     int networkPort = 7777;
     std::string networkIP = "127.0.0.1";
 
-    // Replication
-    bool syncTransform = false;
-    uint32_t networkID = 0;
-
     // --- THE COMPONENT SYSTEM ---
-    std::vector<std::unique_ptr<Component>> components;
+    // Components live in the scene's per-type pools. The entity keeps a
+    // type bitmask, one slot per type for O(1) lookup, and the insertion
+    // order for the inspector (inline, so adding one never hits the heap).
+    // One component of each type per entity.
+    uint32_t componentMask = 0;
+    std::array<Component*, COMPONENT_TYPE_COUNT> componentSlots{};
+    std::array<Component*, COMPONENT_TYPE_COUNT> components{};
+    uint32_t componentCount = 0;
 
     template<typename T, typename... Args>
     T* AddComponent(Args&&... args) {
-        auto comp = std::make_unique<T>(std::forward<Args>(args)...);
-        T* ptr = comp.get();
-        comp->owner = this;
-        components.push_back(std::move(comp));
+        if (T* existing = GetComponent<T>()) return existing;
+
+        T* ptr = storage->Pool<T>().Acquire(std::forward<Args>(args)...);
+        ptr->owner = this;
+        componentSlots[T::TypeID] = ptr;
+        componentMask |= ComponentBit(T::TypeID);
+        components[componentCount++] = ptr;
         return ptr;
     }
 
     template<typename T>
     T* GetComponent() {
-        for (auto& comp : components) {
-            T* ptr = dynamic_cast<T*>(comp.get());
-            if (ptr) return ptr;
-        }
-        return nullptr;
+        return static_cast<T*>(componentSlots[T::TypeID]);
     }
 
     template<typename T>
-    bool HasComponent() {
-        return GetComponent<T>() != nullptr;
+    bool HasComponent() const {
+        return (componentMask & ComponentBit(T::TypeID)) != 0;
     }
 
-    glm::vec3 GetRenderPosition(glm::ivec3 cameraSector, glm::vec3 cameraOrigin) {
-        glm::vec3 sectorDiff = glm::vec3(sector - cameraSector);
-        return (sectorDiff * SECTOR_SIZE) + (origin - cameraOrigin);
+    glm::vec3 GetRenderPosition(glm::ivec3 cameraSector, glm::vec3 cameraOrigin) const {
+        glm::vec3 sectorDiff = glm::vec3(Sector() - cameraSector);
+        return (sectorDiff * SECTOR_SIZE) + (Origin() - cameraOrigin);
     }
+
+private:
+    EntityChunk& Chunk() { return storage->ChunkOf(location); }
+    const EntityChunk& Chunk() const { return static_cast<const EntityStorage*>(storage)->ChunkOf(location); }
+    uint32_t Slot() const { return EntityStorage::SlotOf(location); }
 };
 }
\ No newline at end of file
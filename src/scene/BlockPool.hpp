@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Crescendo {
+
+    // =========================================================
+    // BLOCK POOL
+    // Raw, correctly aligned storage for objects of one type, handed
+    // out from fixed-size blocks. The pool only owns memory: callers
+    // placement-new into a slot and run the destructor before Free().
+    // Addresses never move, and Reset() rewinds every block at once
+    // without giving memory back, so reloading a level reuses it.
+    // =========================================================
+
+    struct PoolStats {
+        size_t blockAllocations = 0;    // Heap calls the pool has made, ever
+        size_t blocks = 0;              // Blocks currently held
+        size_t acquires = 0;            // Slots handed out, ever
+        size_t live = 0;                // Slots currently in use
+
+        PoolStats& operator+=(const PoolStats& other) {
+            blockAllocations += other.blockAllocations;
+            blocks += other.blocks;
+            acquires += other.acquires;
+            live += other.live;
+            return *this;
+        }
+    };
+
+    template<typename T, uint32_t BLOCK_SIZE>
+    class BlockPool {
+    public:
+        BlockPool() = default;
+        BlockPool(const BlockPool&) = delete;
+        BlockPool& operator=(const BlockPool&) = delete;
+
+        void* Allocate() {
+            stats.acquires++;
+            stats.live++;
+
+            if (!freeSlots.empty()) {
+                void* slot = freeSlots.back();
+                freeSlots.pop_back();
+                return slot;
+            }
+
+            if (blockUsed == BLOCK_SIZE) {
+                blockCursor++;
+                blockUsed = 0;
+            }
+            if (blockCursor == blocks.size()) {
+                blocks.push_back(std::make_unique<Block>());
+                stats.blockAllocations++;
+                stats.blocks++;
+            }
+            return blocks[blockCursor]->bytes + (sizeof(T) * blockUsed++);
+        }
+
+        void Free(void* slot) {
+            stats.live--;
+            freeSlots.push_back(slot);
+        }
+
+        // Every slot becomes free again. The caller must have destroyed the objects already.
+        void Reset() {
+            blockCursor = 0;
+            blockUsed = 0;
+            freeSlots.clear();
+            stats.live = 0;
+        }
+
+        const PoolStats& Stats() const { return stats; }
+
+    private:
+        struct Block {
+            alignas(T) unsigned char bytes[sizeof(T) * BLOCK_SIZE];
+        };
+
+        std::vector<std::unique_ptr<Block>> blocks;
+        size_t blockCursor = 0;     // Block the next fresh slot comes from
+        uint32_t blockUsed = 0;     // Fresh slots already taken from that block
+        std::vector<void*> freeSlots;
+        PoolStats stats;
+    };
+}
@@ -1,19 +1,44 @@
 #pragma once
 
 #include <string> 
+#include <cstdint>
 
 namespace Crescendo {
 
     class CBaseEntity;
 
+    // Compile-time component type IDs. Every concrete component declares
+    // `static constexpr ComponentTypeID TypeID = COMPONENT_X;` so lookups
+    // are a bitmask test and an array index instead of a dynamic_cast.
+    enum ComponentTypeID : uint32_t {
+        COMPONENT_TRANSFORM = 0,
+        COMPONENT_MESH_RENDERER,
+        COMPONENT_POINT_LIGHT,
+        COMPONENT_PROCEDURAL_PLANET,
+        COMPONENT_PLANET_MANAGER,
+
+        COMPONENT_TYPE_COUNT
+    };
+
+    static_assert(COMPONENT_TYPE_COUNT <= 32, "Component mask is a uint32_t");
+
+    inline constexpr uint32_t ComponentBit(ComponentTypeID id) { return 1u << id; }
+
     class Component {
     public:
         CBaseEntity* owner = nullptr;
         bool enabled = true;
 
+        // Filled in by the pool on acquire
+        ComponentTypeID typeID = COMPONENT_TYPE_COUNT;
+        uint32_t poolIndex = 0;
+
         virtual ~Component() = default;
 
         virtual void Start() {}
+        // Driven by the SystemScheduler, possibly on a worker thread alongside
+        // other components of the same type. Write only this component; reading
+        // the owner's transform is fine.
         virtual void Update(float deltaTime) {}
 
         virtual std::string GetName() const = 0;
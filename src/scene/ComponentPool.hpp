@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BlockPool.hpp"
+#include "Component.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // COMPONENT POOLS
+    // One pool per component type. Objects are placement-new'd into
+    // fixed blocks so their addresses never move (entities keep raw
+    // pointers to them), while 'live' is a dense list of every active
+    // instance. "All planets" is a walk over one vector, no RTTI.
+    // =========================================================
+
+    class IComponentPool {
+    public:
+        virtual ~IComponentPool() = default;
+        virtual void Release(Component* comp) = 0;
+        virtual size_t Size() const = 0;
+
+        // Destroys every live component in one sweep and keeps the blocks for reuse
+        virtual void Reset() = 0;
+        virtual const PoolStats& Stats() const = 0;
+
+        // Play/Editor snapshots. Copyable component types are copied whole on Save and
+        // assigned back on Restore. Types holding runtime-only resources (unique_ptrs
+        // to terrain, etc.) can't be copied and keep their Play-mode state.
+        virtual void SaveSnapshot() = 0;
+        virtual void RestoreSnapshot() = 0;
+        virtual void DropSnapshot() = 0;
+    };
+
+    template<typename T>
+    class ComponentPool : public IComponentPool {
+    public:
+        static constexpr uint32_t BLOCK_SIZE = 64;
+
+        ComponentPool() = default;
+        ComponentPool(const ComponentPool&) = delete;
+        ComponentPool& operator=(const ComponentPool&) = delete;
+
+        ~ComponentPool() override {
+            for (T* comp : live) comp->~T();
+        }
+
+        template<typename... Args>
+        T* Acquire(Args&&... args) {
+            T* comp = new (storage.Allocate()) T(std::forward<Args>(args)...);
+            comp->typeID = T::TypeID;
+            comp->poolIndex = static_cast<uint32_t>(live.size());
+            live.push_back(comp);
+            return comp;
+        }
+
+        void Release(Component* base) override {
+            T* comp = static_cast<T*>(base);
+
+            // Swap-remove from the dense list, then recycle the slot
+            uint32_t idx = comp->poolIndex;
+            live[idx] = live.back();
+            live[idx]->poolIndex = idx;
+            live.pop_back();
+
+            comp->~T();
+            storage.Free(comp);
+        }
+
+        void Reset() override {
+            for (T* comp : live) comp->~T();
+            live.clear();
+            storage.Reset();
+        }
+
+        size_t Size() const override { return live.size(); }
+        const PoolStats& Stats() const override { return storage.Stats(); }
+
+        void SaveSnapshot() override {
+            if constexpr (IS_COPYABLE) {
+                saved.clear();
+                saved.reserve(live.size());
+                for (T* comp : live) saved.emplace_back(comp, *comp);
+            }
+        }
+
+        void RestoreSnapshot() override {
+            if constexpr (IS_COPYABLE) {
+                for (auto& [comp, copy] : saved) {
+                    uint32_t index = comp->poolIndex;   // Swap-removes may have moved it in 'live'
+                    *comp = copy;
+                    comp->poolIndex = index;
+                }
+                saved.clear();
+            }
+        }
+
+        void DropSnapshot() override {
+            if constexpr (IS_COPYABLE) saved.clear();
+        }
+
+        // Dense list of live components, iterate this
+        const std::vector<T*>& Items() const { return live; }
+
+    private:
+        static constexpr bool IS_COPYABLE = std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>;
+
+        BlockPool<T, BLOCK_SIZE> storage;
+        std::vector<T*> live;
+        std::conditional_t<IS_COPYABLE, std::vector<std::pair<T*, T>>, std::nullptr_t> saved{};
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Crescendo {
+
+    // =========================================================
+    // INTERNED CLASS NAMES
+    // className strings are interned once at creation so hot paths
+    // compare (or index by) a small integer instead of a string.
+    // The engine's built-in classes have fixed IDs; anything else
+    // (script or map defined) gets the next free ID on first sight.
+    // =========================================================
+
+    using ClassID = uint32_t;
+
+    enum BuiltinClass : ClassID {
+        CLASS_PROP_DYNAMIC = 0,
+        CLASS_PROP_STATIC,
+        CLASS_PROP_SUBMESH,
+        CLASS_PROP_WATER,
+        CLASS_ENV_SKY,
+        CLASS_ENV_SOUND,
+        CLASS_LIGHT_POINT,
+        CLASS_LIGHT_DIRECTIONAL,
+        CLASS_NODE_NETWORK,
+
+        CLASS_BUILTIN_COUNT
+    };
+
+    class ClassRegistry {
+    public:
+        static ClassID Intern(const std::string& name) {
+            Registry& reg = Get();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            auto it = reg.ids.find(name);
+            if (it != reg.ids.end()) return it->second;
+
+            ClassID id = static_cast<ClassID>(reg.names.size());
+            reg.names.push_back(name);
+            reg.ids.emplace(name, id);
+            return id;
+        }
+
+        // deque storage, so the reference stays valid as new names are interned
+        static const std::string& NameOf(ClassID id) {
+            Registry& reg = Get();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            static const std::string unknown = "";
+            return id < reg.names.size() ? reg.names[id] : unknown;
+        }
+
+    private:
+        struct Registry {
+            std::mutex mutex;
+            std::deque<std::string> names;
+            std::unordered_map<std::string, ClassID> ids;
+
+            Registry() {
+                // Must match the BuiltinClass order
+                for (const char* name : { "prop_dynamic", "prop_static", "prop_submesh", "prop_water",
+                                          "env_sky", "env_sound", "light_point", "light_directional", "node_network" }) {
+                    ids.emplace(name, static_cast<ClassID>(names.size()));
+                    names.push_back(name);
+                }
+            }
+        };
+
+        static Registry& Get() {
+            static Registry registry;
+            return registry;
+        }
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+namespace Crescendo {
+
+    // =========================================================
+    // ENTITY HANDLES
+    // A slot index plus the generation that slot had when the entity
+    // was created. Deleting an entity bumps the slot's generation, so
+    // any handle still pointing at it resolves to nullptr instead of
+    // whatever entity reuses the slot next.
+    // =========================================================
+
+    struct EntityHandle {
+        static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+        uint32_t index = INVALID_INDEX;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != INVALID_INDEX; }
+
+        // Packed form for maps, save files and the wire
+        uint64_t Packed() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+        static EntityHandle FromPacked(uint64_t packed) {
+            return EntityHandle{ static_cast<uint32_t>(packed & 0xFFFFFFFF), static_cast<uint32_t>(packed >> 32) };
+        }
+
+        bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+    };
+}
+
+namespace std {
+    template<>
+    struct hash<Crescendo::EntityHandle> {
+        size_t operator()(const Crescendo::EntityHandle& h) const noexcept {
+            return std::hash<uint64_t>()(h.Packed());
+        }
+    };
+}
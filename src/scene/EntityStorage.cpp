@@ -0,0 +1,399 @@
+#include "scene/EntityStorage.hpp"
+#include "scene/BaseEntity.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace Crescendo {
+
+    EntityChunk::EntityChunk(uint32_t groupMask) : mask(groupMask) {
+        owners = std::make_unique<CBaseEntity*[]>(CAPACITY);
+
+        if (mask & GROUP_TRANSFORM) {
+            origin = std::make_unique<glm::vec3[]>(CAPACITY);
+            angles = std::make_unique<glm::vec3[]>(CAPACITY);
+            scale  = std::make_unique<glm::vec3[]>(CAPACITY);
+            sector = std::make_unique<glm::ivec3[]>(CAPACITY);
+            world  = std::make_unique<glm::mat4[]>(CAPACITY);
+            dirty  = std::make_unique<uint8_t[]>(CAPACITY);
+            bounds = std::make_unique<glm::vec4[]>(CAPACITY);
+            prevWorld = std::make_unique<glm::mat4[]>(CAPACITY);
+            worldTick = std::make_unique<uint32_t[]>(CAPACITY);
+            renderDirty = std::make_unique<uint8_t[]>(CAPACITY);
+        }
+        if (mask & GROUP_MATERIAL) material = std::make_unique<MaterialData[]>(CAPACITY);
+        if (mask & GROUP_PHYSICS)  physics  = std::make_unique<PhysicsLink[]>(CAPACITY);
+        if (mask & GROUP_NETWORK)  network  = std::make_unique<NetworkLink[]>(CAPACITY);
+    }
+
+    void EntityChunk::ResetRow(uint32_t row) {
+        owners[row] = nullptr;
+
+        if (origin) {
+            origin[row] = glm::vec3(0.0f);
+            angles[row] = glm::vec3(0.0f);
+            scale[row]  = glm::vec3(1.0f);
+            sector[row] = glm::ivec3(0);
+            world[row]  = glm::mat4(1.0f);
+            dirty[row]  = 1;
+            bounds[row] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);    // Unit sphere until a mesh says otherwise
+            prevWorld[row] = glm::mat4(1.0f);
+            worldTick[row] = NO_TICK;                           // First world write shouldn't interpolate in from the origin
+            renderDirty[row] = 1;
+        }
+        if (material) material[row] = MaterialData{};
+        if (physics)  physics[row]  = PhysicsLink{};
+        if (network)  network[row]  = NetworkLink{};
+    }
+
+    void EntityChunk::CopyRow(uint32_t dstRow, const EntityChunk& src, uint32_t srcRow) {
+        owners[dstRow] = src.owners[srcRow];
+
+        // Columns the source doesn't carry keep the defaults from ResetRow
+        if (origin && src.origin) {
+            origin[dstRow] = src.origin[srcRow];
+            angles[dstRow] = src.angles[srcRow];
+            scale[dstRow]  = src.scale[srcRow];
+            sector[dstRow] = src.sector[srcRow];
+            world[dstRow]  = src.world[srcRow];
+            dirty[dstRow]  = src.dirty[srcRow];
+            bounds[dstRow] = src.bounds[srcRow];
+            prevWorld[dstRow] = src.prevWorld[srcRow];
+            worldTick[dstRow] = src.worldTick[srcRow];
+            renderDirty[dstRow] = src.renderDirty[srcRow];
+        }
+        if (material && src.material) material[dstRow] = src.material[srcRow];
+        if (physics && src.physics)   physics[dstRow]  = src.physics[srcRow];
+        if (network && src.network)   network[dstRow]  = src.network[srcRow];
+    }
+
+    void EntityChunk::CopyFrom(const EntityChunk& src) {
+        count = src.count;
+        std::copy_n(src.owners.get(), count, owners.get());
+
+        if (origin) {
+            std::copy_n(src.origin.get(), count, origin.get());
+            std::copy_n(src.angles.get(), count, angles.get());
+            std::copy_n(src.scale.get(),  count, scale.get());
+            std::copy_n(src.sector.get(), count, sector.get());
+            std::copy_n(src.world.get(),  count, world.get());
+            std::copy_n(src.dirty.get(),  count, dirty.get());
+            std::copy_n(src.bounds.get(), count, bounds.get());
+            std::copy_n(src.prevWorld.get(), count, prevWorld.get());
+            std::copy_n(src.worldTick.get(), count, worldTick.get());
+            std::fill_n(renderDirty.get(), count, uint8_t(1));  // Restored rows differ from whatever the renderer holds
+        }
+        if (material) std::copy_n(src.material.get(), count, material.get());
+        if (physics)  std::copy_n(src.physics.get(),  count, physics.get());
+        if (network)  std::copy_n(src.network.get(),  count, network.get());
+    }
+
+    int32_t EntityStorage::FindOrCreateArchetype(uint32_t groupMask) {
+        for (size_t i = 0; i < archetypes.size(); i++) {
+            if (archetypes[i].mask == groupMask) return static_cast<int32_t>(i);
+        }
+
+        Archetype arch;
+        arch.mask = groupMask;
+        archetypes.push_back(std::move(arch));
+        return static_cast<int32_t>(archetypes.size() - 1);
+    }
+
+    EntityLocation EntityStorage::AllocateRow(int32_t archetypeIndex) {
+        Archetype& arch = archetypes[archetypeIndex];
+
+        EntityLocation loc;
+        loc.archetype = archetypeIndex;
+        loc.row = arch.count;
+
+        uint32_t chunkIndex = loc.row / EntityChunk::CAPACITY;
+        if (chunkIndex >= arch.chunks.size()) {
+            arch.chunks.push_back(std::make_unique<EntityChunk>(arch.mask));
+            arch.chunks.back()->archetype = archetypeIndex;
+            arch.chunks.back()->index = chunkIndex;
+            chunkAllocations++;
+        }
+
+        EntityChunk& chunk = Writable(*arch.chunks[chunkIndex]);
+        chunk.ResetRow(SlotOf(loc));
+        chunk.count++;
+        arch.count++;
+        return loc;
+    }
+
+    void EntityStorage::Insert(CBaseEntity* owner, uint32_t groupMask) {
+        if (!owner) return;
+
+        EntityLocation loc = AllocateRow(FindOrCreateArchetype(groupMask | GROUP_DEFAULT));
+        ChunkOf(loc).owners[SlotOf(loc)] = owner;
+
+        owner->storage = this;
+        owner->location = loc;
+    }
+
+    void EntityStorage::Remove(CBaseEntity* owner) {
+        if (!owner || !owner->location.IsValid()) return;
+
+        EntityLocation loc = owner->location;
+        Archetype& arch = archetypes[loc.archetype];
+
+        EntityLocation last;
+        last.archetype = loc.archetype;
+        last.row = arch.count - 1;
+
+        EntityChunk& lastChunk = ChunkOf(last);
+
+        // Fill the hole with the last row so the chunks stay packed
+        if (loc.row != last.row) {
+            EntityChunk& holeChunk = ChunkOf(loc);
+            holeChunk.CopyRow(SlotOf(loc), lastChunk, SlotOf(last));
+
+            CBaseEntity* moved = holeChunk.owners[SlotOf(loc)];
+            if (moved) moved->location = loc;
+        }
+
+        lastChunk.ResetRow(SlotOf(last));
+        lastChunk.count--;
+        arch.count--;
+
+        // Keep one empty chunk as a spare so add/remove at a chunk boundary doesn't
+        // allocate and free every time, only drop the one beyond it
+        uint32_t lastChunkIndex = last.row / EntityChunk::CAPACITY;
+        if (lastChunk.count == 0 && arch.chunks.size() > lastChunkIndex + 1) {
+            arch.chunks.pop_back();
+        }
+
+        owner->location = EntityLocation{};
+    }
+
+    void EntityStorage::Migrate(CBaseEntity* owner, uint32_t groupMask) {
+        if (!owner || !owner->location.IsValid()) return;
+
+        groupMask |= GROUP_DEFAULT;
+        if (MaskOf(owner->location) == groupMask) return;
+
+        // Creating the archetype can grow the vector, so resolve it before touching any rows
+        int32_t target = FindOrCreateArchetype(groupMask);
+        EntityLocation newLoc = AllocateRow(target);
+
+        ChunkOf(newLoc).CopyRow(SlotOf(newLoc), ChunkOf(owner->location), SlotOf(owner->location));
+
+        Remove(owner);
+        owner->location = newLoc;
+    }
+
+    void EntityStorage::Detach(CBaseEntity* owner) {
+        if (!owner || !owner->location.IsValid()) return;
+        Migrate(owner, MaskOf(owner->location) | GROUP_DETACHED);
+    }
+
+    // --- Network IDs ---
+    // A linear walk over the networked archetypes only; IDs are assigned rarely, and scanning the
+    // rows keeps nothing to go stale across deletes and snapshot restores
+
+    const CBaseEntity* EntityStorage::NetworkOwner(uint32_t id) const {
+        if (id == 0) return nullptr;
+        const CBaseEntity* found = nullptr;
+        ForEachChunk(GROUP_NETWORK, [&](const EntityChunk& chunk) {
+            for (uint32_t i = 0; i < chunk.count && !found; i++) {
+                if (chunk.network[i].networkID == id) found = chunk.owners[i];
+            }
+        });
+        return found;
+    }
+
+    uint32_t EntityStorage::AllocateNetworkID(const std::string& name) const {
+        if (name.empty()) return 0;
+
+        // FNV-1a, folded past the reserved range
+        uint32_t hash = 2166136261u;
+        for (char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        const uint32_t hashed = RESERVED_NETWORK_IDS + hash % (0xFFFFFFFFu - RESERVED_NETWORK_IDS);
+        uint32_t id = hashed;
+
+        // Two entities of the same name: the next free ID, the same on every peer that loaded the same entities
+        while (NetworkOwner(id)) {
+            id = id == 0xFFFFFFFFu ? RESERVED_NETWORK_IDS : id + 1;
+        }
+        if (id != hashed) {
+            std::cerr << "[Network] '" << name << "' shares its name with another networked entity, moved to ID " << id << std::endl;
+        }
+        return id;
+    }
+
+    bool EntityStorage::SetNetworkID(CBaseEntity* owner, uint32_t id) {
+        if (!owner || !owner->location.IsValid() || !(MaskOf(owner->location) & GROUP_NETWORK)) return false;
+
+        const CBaseEntity* current = NetworkOwner(id);
+        if (current && current != owner) {
+            std::cerr << "[Network] ID " << id << " already belongs to '" << current->targetName << "'" << std::endl;
+            return false;
+        }
+        ChunkOf(owner->location).network[SlotOf(owner->location)].networkID = id;
+        return true;
+    }
+
+    void EntityStorage::DestroyComponents(CBaseEntity* owner) {
+        if (!owner) return;
+
+        for (uint32_t i = 0; i < owner->componentCount; i++) {
+            Component* comp = owner->components[i];
+            if (comp && componentPools[comp->typeID]) componentPools[comp->typeID]->Release(comp);
+        }
+        owner->components.fill(nullptr);
+        owner->componentCount = 0;
+        owner->componentMask = 0;
+        owner->componentSlots.fill(nullptr);
+    }
+
+    void EntityStorage::DestroyComponent(CBaseEntity* owner, ComponentTypeID type) {
+        if (!owner) return;
+
+        Component* comp = owner->componentSlots[type];
+        if (!comp) return;
+
+        // Keep the inspector order of the rest
+        auto end = owner->components.begin() + owner->componentCount;
+        auto it = std::find(owner->components.begin(), end, comp);
+        std::rotate(it, it + 1, end);
+        owner->components[--owner->componentCount] = nullptr;
+        owner->componentSlots[type] = nullptr;
+        owner->componentMask &= ~ComponentBit(type);
+
+        if (componentPools[type]) componentPools[type]->Release(comp);
+    }
+
+    // =========================================================
+    // SNAPSHOTS
+    // =========================================================
+
+    void EntityStorage::BeginSnapshot() {
+        EndSnapshot();
+
+        // A fresh epoch makes every chunk's savedEpoch stale, no need to touch them
+        snapshotEpoch++;
+        snapshotActive = true;
+
+        savedArchetypes.resize(archetypes.size());
+        for (size_t i = 0; i < archetypes.size(); i++) {
+            savedArchetypes[i].count = archetypes[i].count;
+            savedArchetypes[i].chunkCount = archetypes[i].chunks.size();
+        }
+
+        for (auto& pool : componentPools) {
+            if (pool) pool->SaveSnapshot();
+        }
+    }
+
+    void EntityStorage::Preserve(EntityChunk& chunk) {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        if (chunk.savedEpoch.load(std::memory_order_relaxed) == snapshotEpoch) return; // Another worker got here first
+
+        // Chunks that didn't exist at BeginSnapshot only need the mark, Restore drops them.
+        // emplace never overwrites: a chunk popped and re-grown at the same index keeps its first copy.
+        bool existed = chunk.archetype >= 0 && static_cast<size_t>(chunk.archetype) < savedArchetypes.size()
+                    && chunk.index < savedArchetypes[chunk.archetype].chunkCount;
+        uint64_t key = (static_cast<uint64_t>(chunk.archetype) << 32) | chunk.index;
+        if (existed && savedChunks.find(key) == savedChunks.end()) {
+            auto copy = std::make_unique<EntityChunk>(chunk.mask);
+            copy->archetype = chunk.archetype;
+            copy->index = chunk.index;
+            copy->CopyFrom(chunk);
+            savedChunks.emplace(key, std::move(copy));
+        }
+
+        chunk.savedEpoch.store(snapshotEpoch, std::memory_order_release);
+    }
+
+    void EntityStorage::RestoreSnapshot() {
+        if (!snapshotActive) return;
+        snapshotActive = false; // Restoring writes everywhere, none of it may be preserved
+
+        // 1. Archetypes created since the snapshot are empty again, their chunks stay as spares
+        for (size_t a = savedArchetypes.size(); a < archetypes.size(); a++) {
+            archetypes[a].count = 0;
+            for (auto& chunk : archetypes[a].chunks) chunk->count = 0;
+        }
+
+        // 2. Back to the saved shape. Chunks beyond it are dropped, popped ones come back empty.
+        for (size_t a = 0; a < savedArchetypes.size(); a++) {
+            Archetype& arch = archetypes[a];
+            const SavedArchetype& saved = savedArchetypes[a];
+
+            while (arch.chunks.size() > saved.chunkCount) arch.chunks.pop_back();
+            while (arch.chunks.size() < saved.chunkCount) {
+                arch.chunks.push_back(std::make_unique<EntityChunk>(arch.mask));
+                arch.chunks.back()->archetype = static_cast<int32_t>(a);
+                arch.chunks.back()->index = static_cast<uint32_t>(arch.chunks.size() - 1);
+                chunkAllocations++;
+            }
+            arch.count = saved.count;
+        }
+
+        // 3. Swap the preserved chunks back in. Every row in them is re-pointed at, since
+        // swap-removes and migrations during play moved entities between chunks.
+        for (auto& [key, saved] : savedChunks) {
+            Archetype& arch = archetypes[saved->archetype];
+            EntityChunk& chunk = *saved;
+
+            for (uint32_t i = 0; i < chunk.count; i++) {
+                CBaseEntity* owner = chunk.owners[i];
+                if (!owner) continue;
+                owner->location.archetype = chunk.archetype;
+                owner->location.row = chunk.index * EntityChunk::CAPACITY + i;
+                if (chunk.dirty) chunk.dirty[i] = 1;   // World matrix and spatial entry are from the end of play
+            }
+            arch.chunks[chunk.index] = std::move(saved);
+        }
+
+        savedChunks.clear();
+        savedArchetypes.clear();
+
+        for (auto& pool : componentPools) {
+            if (pool) pool->RestoreSnapshot();
+        }
+    }
+
+    void EntityStorage::EndSnapshot() {
+        snapshotActive = false;
+        savedChunks.clear();
+        savedArchetypes.clear();
+
+        for (auto& pool : componentPools) {
+            if (pool) pool->DropSnapshot();
+        }
+    }
+
+    void EntityStorage::Clear() {
+        EndSnapshot();
+        archetypes.clear();
+        for (auto& pool : componentPools) pool.reset();
+    }
+
+    void EntityStorage::Reset() {
+        EndSnapshot();
+        for (auto& arch : archetypes) {
+            arch.count = 0;
+            for (auto& chunk : arch.chunks) chunk->count = 0; // Rows are re-initialized by AllocateRow
+        }
+        for (auto& pool : componentPools) {
+            if (pool) pool->Reset();
+        }
+    }
+
+    PoolStats EntityStorage::ComponentStats() const {
+        PoolStats total;
+        for (const auto& pool : componentPools) {
+            if (pool) total += pool->Stats();
+        }
+        return total;
+    }
+
+    size_t EntityStorage::Size() const {
+        size_t total = 0;
+        for (const auto& arch : archetypes) total += arch.count;
+        return total;
+    }
+}
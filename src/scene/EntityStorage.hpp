@@ -0,0 +1,273 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <glm/glm.hpp>
+#include "ComponentPool.hpp"
+
+namespace Crescendo {
+
+    class CBaseEntity;
+
+    // =========================================================
+    // ARCHETYPE STORAGE
+    // Entity data lives here in structure-of-arrays chunks, grouped by
+    // which data groups an entity actually carries. CBaseEntity is only
+    // a facade that knows where its row is.
+    // =========================================================
+
+    enum EntityGroup : uint32_t {
+        GROUP_TRANSFORM = 1u << 0,
+        GROUP_MATERIAL  = 1u << 1,
+        GROUP_PHYSICS   = 1u << 2,   // Entity owns a Jolt body
+        GROUP_NETWORK   = 1u << 3,   // Entity is replicated over ENet
+        GROUP_DETACHED  = 1u << 31   // Deleted during play, parked until the snapshot restores or frees it
+    };
+
+    // Every entity has a transform and a material, links are opt-in
+    static constexpr uint32_t GROUP_DEFAULT = GROUP_TRANSFORM | GROUP_MATERIAL;
+
+    struct MaterialData {
+        int textureID = 0;
+        int normalTextureID = 0;
+        int ormTextureID = 0;                                       // Occlusion, Roughness, Metallic Map
+
+        // [BSDF DEFAULTS]
+        float roughness = 0.0f;
+        float metallic = 0.0f;
+        float emission = 0.0f;
+        float normalStrength = 0.0f;                                // default to 0 to assume no normal map
+        float transmission = 0.0f;                                  // 0.0 = Opaque, 1.0 = glass
+        float thickness = 0.0f;                                     // average thickness
+        float attenuationDistance = 1.0f;                           // Distance at which color is fully absorbed
+        float ior = 1.5f;
+        glm::vec3 attenuationColor = {1.0f, 1.0f, 1.0f};            // The color of the glass
+        glm::vec3 albedoColor = {1.0f, 1.0f, 1.0f};
+        float clearcoat = 0.0f;                                     // advanced pbr sheen and clearcoat ORM
+        float clearcoatRoughness = 0.03f;
+        float sheen = 0.0f;
+        float specularWeight = 0.5f;
+        float subsurface = 0.0f;
+        float specular = 0.0f;
+        float specularTint = 0.0f;
+        float anisotropic = 0.0f;
+    };
+
+    struct PhysicsLink {
+        uint32_t bodyID = 0xFFFFFFFF;   // JPH::BodyID index + sequence, 0xFFFFFFFF = no body
+    };
+
+    struct NetworkLink {
+        uint32_t networkID = 0;
+        bool syncTransform = false;
+    };
+
+    // One fixed-size block of rows. Only the columns of the archetype's groups
+    // are allocated, so walking transforms never pulls materials into cache.
+    struct EntityChunk {
+        static constexpr uint32_t CAPACITY = 256;
+        static constexpr uint32_t NO_TICK = 0xFFFFFFFF;
+
+        uint32_t mask = 0;
+        uint32_t count = 0;
+
+        // Where this chunk sits, and the last snapshot it was copied aside for
+        int32_t archetype = -1;
+        uint32_t index = 0;
+        std::atomic<uint32_t> savedEpoch{ 0 };
+
+        std::unique_ptr<CBaseEntity*[]> owners;
+
+        // GROUP_TRANSFORM
+        // origin/angles/scale are local to moveParent, world is the cached result of TransformSystem
+        std::unique_ptr<glm::vec3[]>  origin;
+        std::unique_ptr<glm::vec3[]>  angles;
+        std::unique_ptr<glm::vec3[]>  scale;
+        std::unique_ptr<glm::ivec3[]> sector;
+        std::unique_ptr<glm::mat4[]>  world;
+        std::unique_ptr<uint8_t[]>    dirty;    // 1 = local TRS changed since the last TransformSystem::Update
+        std::unique_ptr<glm::vec4[]>  bounds;   // Local bounding sphere, xyz center + w radius
+        std::unique_ptr<glm::mat4[]>  prevWorld;    // world as of the tick before worldTick, for render interpolation
+        std::unique_ptr<uint32_t[]>   worldTick;    // Simulation tick world was last written on, NO_TICK = never
+        std::unique_ptr<uint8_t[]>    renderDirty;  // 1 = world or material changed since the renderer last copied the row
+
+        // GROUP_MATERIAL
+        std::unique_ptr<MaterialData[]> material;
+
+        // GROUP_PHYSICS / GROUP_NETWORK
+        std::unique_ptr<PhysicsLink[]> physics;
+        std::unique_ptr<NetworkLink[]> network;
+
+        explicit EntityChunk(uint32_t groupMask);
+
+        void ResetRow(uint32_t row);
+        void CopyRow(uint32_t dstRow, const EntityChunk& src, uint32_t srcRow);
+
+        // Same archetype only: takes src's count and every live row of every column
+        void CopyFrom(const EntityChunk& src);
+
+        static glm::vec4 WorldSphere(const glm::mat4& world, const glm::vec4& local) {
+            float maxScale = glm::max(glm::length(glm::vec3(world[0])), glm::max(glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))));
+            return glm::vec4(glm::vec3(world * glm::vec4(glm::vec3(local), 1.0f)), local.w * maxScale);
+        }
+    };
+
+    struct Archetype {
+        uint32_t mask = 0;
+        uint32_t count = 0;
+        std::vector<std::unique_ptr<EntityChunk>> chunks;
+    };
+
+    struct EntityLocation {
+        int32_t archetype = -1;
+        uint32_t row = 0;
+
+        bool IsValid() const { return archetype >= 0; }
+    };
+
+    class EntityStorage {
+    public:
+        // Appends a default-initialized row for 'owner' and records its location on the entity
+        void Insert(CBaseEntity* owner, uint32_t groupMask = GROUP_DEFAULT);
+
+        // Swap-removes the row so chunks stay dense. The entity moved into the hole gets its location patched.
+        void Remove(CBaseEntity* owner);
+
+        // Moves an entity into the archetype for 'groupMask', carrying over every column both archetypes share
+        void Migrate(CBaseEntity* owner, uint32_t groupMask);
+
+        // Moves the row into the parked twin of its archetype, where no group walk sees it.
+        // Snapshot restores put it back; Remove frees it as usual.
+        void Detach(CBaseEntity* owner);
+
+        // Frees every chunk and component pool
+        void Clear();
+
+        // Scene unload: empties every archetype and pool in one sweep without per-row
+        // swap-removes, and keeps the chunks and pool blocks for the next level
+        void Reset();
+
+        // Mutable access goes through the snapshot write barrier, read through a const storage where you can
+        EntityChunk& ChunkOf(const EntityLocation& loc) {
+            return Writable(*archetypes[loc.archetype].chunks[loc.row / EntityChunk::CAPACITY]);
+        }
+        const EntityChunk& ChunkOf(const EntityLocation& loc) const {
+            return *archetypes[loc.archetype].chunks[loc.row / EntityChunk::CAPACITY];
+        }
+        static uint32_t SlotOf(const EntityLocation& loc) { return loc.row % EntityChunk::CAPACITY; }
+
+        uint32_t MaskOf(const EntityLocation& loc) const {
+            return loc.IsValid() ? archetypes[loc.archetype].mask : 0;
+        }
+
+        // Visits every chunk whose archetype carries all of 'requiredGroups'.
+        // Parked (GROUP_DETACHED) archetypes are only visited when asked for by name.
+        template<typename Fn>
+        void ForEachChunk(uint32_t requiredGroups, Fn&& fn) {
+            for (auto& arch : archetypes) {
+                if (!Matches(arch.mask, requiredGroups)) continue;
+                for (auto& chunk : arch.chunks) {
+                    if (chunk->count > 0) fn(Writable(*chunk));
+                }
+            }
+        }
+
+        // Read-only walk, never trips the snapshot barrier
+        template<typename Fn>
+        void ForEachChunk(uint32_t requiredGroups, Fn&& fn) const {
+            for (const auto& arch : archetypes) {
+                if (!Matches(arch.mask, requiredGroups)) continue;
+                for (const auto& chunk : arch.chunks) {
+                    if (chunk->count > 0) fn(static_cast<const EntityChunk&>(*chunk));
+                }
+            }
+        }
+
+        size_t Size() const;
+        size_t ArchetypeCount() const { return archetypes.size(); }
+
+        // --- ALLOCATION COUNTERS ---
+        size_t ChunkAllocations() const { return chunkAllocations; }
+        PoolStats ComponentStats() const;
+
+        // --- COMPONENT POOLS ---
+        template<typename T>
+        ComponentPool<T>& Pool() {
+            auto& pool = componentPools[T::TypeID];
+            if (!pool) pool = std::make_unique<ComponentPool<T>>();
+            return static_cast<ComponentPool<T>&>(*pool);
+        }
+
+        // Every live component of type T in this scene
+        template<typename T>
+        const std::vector<T*>& Components() {
+            return Pool<T>().Items();
+        }
+
+        // Returns every component the entity owns to its pool. Called once, right before the entity is deleted.
+        void DestroyComponents(CBaseEntity* owner);
+
+        // Returns one component to its pool and unlinks it from the owner
+        void DestroyComponent(CBaseEntity* owner, ComponentTypeID type);
+
+        // --- NETWORK IDS ---
+        // Peers have to agree on an entity's ID without talking, so it comes from the entity's
+        // name: free-slot reuse makes slots follow each peer's own spawn/delete history. 0 means
+        // unassigned and is never sent. IDs below RESERVED_NETWORK_IDS are only handed out by hand.
+        static constexpr uint32_t RESERVED_NETWORK_IDS = 1024;
+
+        // Hash of 'name' moved past any collision, 0 for an unnamed entity
+        uint32_t AllocateNetworkID(const std::string& name) const;
+        // False, leaving the row alone, when another entity already owns 'id'
+        bool SetNetworkID(CBaseEntity* owner, uint32_t id);
+        const CBaseEntity* NetworkOwner(uint32_t id) const;
+
+        // --- SNAPSHOTS ---
+        // Copy-before-write at chunk granularity. BeginSnapshot only records each
+        // archetype's shape and copies the (few) component objects. The first write
+        // to a chunk afterwards copies that chunk aside, so chunks nobody touches
+        // are never copied and RestoreSnapshot is O(chunks written).
+        void BeginSnapshot();
+        // Puts every preserved chunk back, patches entity locations and flags the
+        // restored rows dirty. Entities created since BeginSnapshot must be gone already.
+        void RestoreSnapshot();
+        void EndSnapshot();
+        bool SnapshotActive() const { return snapshotActive; }
+        size_t PreservedChunkCount() const { return savedChunks.size(); }
+
+    private:
+        std::vector<Archetype> archetypes;
+        std::array<std::unique_ptr<IComponentPool>, COMPONENT_TYPE_COUNT> componentPools;
+        size_t chunkAllocations = 0;
+
+        static bool Matches(uint32_t mask, uint32_t requiredGroups) {
+            if ((mask & GROUP_DETACHED) && !(requiredGroups & GROUP_DETACHED)) return false;
+            return (mask & requiredGroups) == requiredGroups;
+        }
+
+        int32_t FindOrCreateArchetype(uint32_t groupMask);
+        EntityLocation AllocateRow(int32_t archetypeIndex);
+
+        // Snapshot state
+        struct SavedArchetype {
+            uint32_t count = 0;
+            size_t chunkCount = 0;
+        };
+        bool snapshotActive = false;
+        uint32_t snapshotEpoch = 0;
+        std::vector<SavedArchetype> savedArchetypes;
+        std::unordered_map<uint64_t, std::unique_ptr<EntityChunk>> savedChunks;    // archetype << 32 | chunk index
+        std::mutex snapshotMutex;                                                   // Transform workers can trip the barrier together
+
+        EntityChunk& Writable(EntityChunk& chunk) {
+            if (snapshotActive && chunk.savedEpoch.load(std::memory_order_acquire) != snapshotEpoch) Preserve(chunk);
+            return chunk;
+        }
+        void Preserve(EntityChunk& chunk);
+    };
+}
@@ -0,0 +1,331 @@
+#include "scene/Scene.hpp"
+#include "servers/physics/PhysicsServer.hpp"
+#include <iostream>
+
+namespace Crescendo {
+
+    Scene::~Scene() {
+        // When the scene is destroyed delete everything.
+        // The physics server may already be gone here, so bodies are left to its Cleanup().
+        // Components go with storage.Clear(), the pool only owns entity memory.
+        for (CBaseEntity* ent : entities) {
+            if (ent) ent->~CBaseEntity();
+        }
+        for (CBaseEntity* ent : deferredDeletes) ent->~CBaseEntity();
+        entities.clear();
+        storage.Clear();
+    }
+
+    CBaseEntity* Scene::CreateEntity(const std::string& className) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(entities.size());
+            entities.push_back(nullptr);
+            generations.push_back(0);
+        }
+
+        CBaseEntity* ent = new (entityPool.Allocate()) CBaseEntity();
+        ent->index = static_cast<int>(slot);
+        ent->handle = EntityHandle{ slot, generations[slot] };
+        ent->className = className;
+        ent->classID = ClassRegistry::Intern(className);
+        storage.Insert(ent);
+        AddToClassIndex(ent);
+
+        entities[slot] = ent;
+        liveCount++;
+        return ent;
+    }
+
+    void Scene::DestroySlot(uint32_t slot) {
+        CBaseEntity* target = entities[slot];
+        if (!target) return;
+
+        if (SnapshotActive() && InSnapshot(target)) {
+            DetachSlot(slot);
+            return;
+        }
+
+        // Only the parent can reference us as a child, no need to sweep the scene
+        if (target->moveParent) {
+            auto& siblings = target->moveParent->children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), target), siblings.end());
+        }
+
+        // Orphan the children so they don't keep a dangling parent pointer
+        for (CBaseEntity* child : target->children) {
+            if (!child) continue;
+            child->moveParent = nullptr;
+            child->MarkTransformDirty();
+        }
+
+        if (physics) physics->RemoveBody(target->handle);
+
+        RemoveFromClassIndex(target);
+        spatial.Remove(slot);
+        storage.DestroyComponents(target);
+        storage.Remove(target);
+        target->~CBaseEntity();
+        entityPool.Free(target);
+
+        entities[slot] = nullptr;
+        generations[slot]++;
+        freeSlots.push_back(slot);
+        liveCount--;
+    }
+
+    void Scene::DetachSlot(uint32_t slot) {
+        CBaseEntity* target = entities[slot];
+
+        // Same unlinking as a real delete, minus giving back the row, components and memory
+        if (target->moveParent) {
+            auto& siblings = target->moveParent->children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), target), siblings.end());
+        }
+        for (CBaseEntity* child : target->children) {
+            if (!child) continue;
+            child->moveParent = nullptr;
+            child->MarkTransformDirty();
+        }
+
+        if (physics) physics->SuspendBody(target->handle);
+
+        RemoveFromClassIndex(target);
+        spatial.Remove(slot);
+        target->visible = false;
+
+        // Out of every chunk walk: not drawn or culled on the GPU (buildPacket clears rows it no
+        // longer sees), not replicated, not re-added to the spatial index, its network ID free
+        storage.Detach(target);
+
+        // The slot isn't freed, so it can't be reused before the restore
+        entities[slot] = nullptr;
+        generations[slot]++;
+        liveCount--;
+        deferredDeletes.push_back(target);
+    }
+
+    void Scene::DeleteEntity(EntityHandle handle) {
+        if (!GetEntity(handle)) return; // Already deleted
+        DestroySlot(handle.index);
+    }
+
+    void Scene::DeleteEntities(const std::vector<EntityHandle>& handles) {
+        freeSlots.reserve(freeSlots.size() + handles.size());
+        for (const EntityHandle& handle : handles) {
+            if (GetEntity(handle)) DestroySlot(handle.index);
+        }
+    }
+
+    void Scene::AddToClassIndex(CBaseEntity* ent) {
+        if (ent->classID >= classMembers.size()) classMembers.resize(ent->classID + 1);
+
+        auto& members = classMembers[ent->classID];
+        ent->classSlot = static_cast<uint32_t>(members.size());
+        members.push_back(ent);
+    }
+
+    void Scene::RemoveFromClassIndex(CBaseEntity* ent) {
+        auto& members = classMembers[ent->classID];
+
+        CBaseEntity* last = members.back();
+        members[ent->classSlot] = last;
+        last->classSlot = ent->classSlot;
+        members.pop_back();
+    }
+
+    void Scene::SetEntityClass(CBaseEntity* ent, const std::string& className) {
+        if (!ent || ent->className == className) return;
+
+        RemoveFromClassIndex(ent);
+        ent->className = className;
+        ent->classID = ClassRegistry::Intern(className);
+        AddToClassIndex(ent);
+    }
+
+    void Scene::SetParent(CBaseEntity* child, CBaseEntity* parent) {
+        if (!child || child == parent || child->moveParent == parent) return;
+
+        // Refuse cycles, the transform pass would never terminate
+        for (CBaseEntity* p = parent; p; p = p->moveParent) {
+            if (p == child) return;
+        }
+
+        if (child->moveParent) {
+            auto& siblings = child->moveParent->children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), child), siblings.end());
+        }
+
+        child->moveParent = parent;
+        if (parent) parent->children.push_back(child);
+        child->MarkTransformDirty();
+    }
+
+    void Scene::Clear() {
+        EndSnapshot();
+
+        // No per-entity unlinking, class index or row swap-removes here: everything goes,
+        // so the indices are simply emptied. Generations are still bumped so handles held
+        // by the editor or the network can't resolve into the next scene.
+        for (uint32_t slot = 0; slot < entities.size(); slot++) {
+            CBaseEntity* ent = entities[slot];
+            if (!ent) continue;
+
+            if (physics) physics->RemoveBody(ent->handle);
+            ent->~CBaseEntity();
+
+            entities[slot] = nullptr;
+            generations[slot]++;
+        }
+
+        // Hand the slots back lowest-first
+        freeSlots.clear();
+        for (uint32_t slot = static_cast<uint32_t>(entities.size()); slot > 0; slot--) {
+            freeSlots.push_back(slot - 1);
+        }
+        liveCount = 0;
+
+        for (auto& members : classMembers) members.clear();
+        spatial.Clear();
+        storage.Reset();
+        entityPool.Reset();
+    }
+
+    // =========================================================
+    // PLAY MODE SNAPSHOT
+    // =========================================================
+
+    void Scene::BeginSnapshot() {
+        EndSnapshot();
+
+        snapshot.assign(entities.size(), EntitySnapshot{});
+        for (CBaseEntity* ent : entities) {
+            if (!ent) continue;
+
+            EntitySnapshot& saved = snapshot[ent->index];
+            saved.handle = ent->handle;
+            saved.parent = ent->moveParent;
+            saved.children = ent->children;
+            saved.componentMask = ent->componentMask;
+            saved.modelIndex = ent->modelIndex;
+            saved.visible = ent->visible;
+        }
+
+        storage.BeginSnapshot();
+        std::cout << "[Scene] Snapshot of " << liveCount << " entities taken." << std::endl;
+    }
+
+    void Scene::RestoreSnapshot() {
+        if (!SnapshotActive()) return;
+
+        // 1. Everything spawned during play really goes. DestroySlot only defers
+        // entities that are in the snapshot, so these are freed for good.
+        for (uint32_t slot = 0; slot < entities.size(); slot++) {
+            CBaseEntity* ent = entities[slot];
+            if (ent && !InSnapshot(ent)) DestroySlot(slot);
+        }
+
+        // 2. Bring back what play deleted, under its old handle
+        for (CBaseEntity* ent : deferredDeletes) {
+            entities[ent->index] = ent;
+            generations[ent->index] = ent->handle.generation;
+            liveCount++;
+            AddToClassIndex(ent);
+            if (physics) physics->ResumeBody(ent->handle);
+            ent->MarkTransformDirty();  // Back into the spatial index on the next transform pass
+        }
+        deferredDeletes.clear();
+
+        // 3. Components added during play go back to their pools, then the entity-side state
+        for (CBaseEntity* ent : entities) {
+            if (!ent) continue;
+            const EntitySnapshot& saved = snapshot[ent->index];
+
+            uint32_t added = ent->componentMask & ~saved.componentMask;
+            for (uint32_t type = 0; added; type++, added >>= 1) {
+                if (added & 1) storage.DestroyComponent(ent, static_cast<ComponentTypeID>(type));
+            }
+
+            ent->moveParent = saved.parent;
+            ent->children = saved.children;
+            ent->modelIndex = saved.modelIndex;
+            ent->visible = saved.visible;
+        }
+
+        // 4. Rows and component data
+        storage.RestoreSnapshot();
+        snapshot.clear();
+
+        std::cout << "[Scene] Snapshot restored, " << liveCount << " entities." << std::endl;
+    }
+
+    void Scene::EndSnapshot() {
+        // Entities deleted during play are deleted for real now
+        std::vector<CBaseEntity*> pending;
+        pending.swap(deferredDeletes);
+        storage.EndSnapshot();
+        snapshot.clear();
+
+        for (CBaseEntity* ent : pending) {
+            uint32_t slot = static_cast<uint32_t>(ent->index);
+            if (physics) physics->RemoveBody(ent->handle);
+            storage.DestroyComponents(ent);
+            storage.Remove(ent);
+            ent->~CBaseEntity();
+            entityPool.Free(ent);
+            freeSlots.push_back(slot);   // Generation was already bumped when it was detached
+        }
+    }
+
+    // =========================================================
+    // SPATIAL QUERIES
+    // =========================================================
+
+    void Scene::ResolveIDs(const std::vector<uint32_t>& ids, std::vector<CBaseEntity*>& out) const {
+        out.reserve(out.size() + ids.size());
+        for (uint32_t slot : ids) {
+            if (slot < entities.size() && entities[slot]) out.push_back(entities[slot]);
+        }
+    }
+
+    void Scene::QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<CBaseEntity*>& out) const {
+        thread_local std::vector<uint32_t> ids;
+        ids.clear();
+        spatial.QueryAABB(min, max, ids);
+        ResolveIDs(ids, out);
+    }
+
+    void Scene::QuerySphere(const glm::vec3& center, float radius, std::vector<CBaseEntity*>& out) const {
+        thread_local std::vector<uint32_t> ids;
+        ids.clear();
+        spatial.QuerySphere(center, radius, ids);
+        ResolveIDs(ids, out);
+    }
+
+    void Scene::QueryFrustum(const glm::mat4& viewProj, std::vector<CBaseEntity*>& out) const {
+        glm::vec4 planes[6];
+        SpatialIndex::ExtractFrustumPlanes(viewProj, planes);
+
+        thread_local std::vector<uint32_t> ids;
+        ids.clear();
+        spatial.QueryFrustum(planes, ids);
+        ResolveIDs(ids, out);
+    }
+
+    CBaseEntity* Scene::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, float* hitDistance) const {
+        thread_local std::vector<SpatialHit> hits;
+        hits.clear();
+        spatial.Raycast(origin, dir, maxDistance, hits);
+
+        for (const SpatialHit& hit : hits) {
+            if (hit.id < entities.size() && entities[hit.id]) {
+                if (hitDistance) *hitDistance = hit.distance;
+                return entities[hit.id];
+            }
+        }
+        return nullptr;
+    }
+}
@@ -2,8 +2,11 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstdint>
 
 #include "BaseEntity.hpp"
+#include "SpatialIndex.hpp"
+#include "SystemScheduler.hpp"
 
 namespace Crescendo {
 
@@ -40,60 +43,143 @@ namespace Crescendo {
 
     class PhysicsServer;
 
+    // Where the fixed-rate simulation is relative to the frame being drawn.
+    // Written by the engine loop, read by the transform pass, renderer and editor.
+    struct SimulationTime {
+        uint32_t tick = 0;              // Simulation ticks run so far
+        float tickRate = 60.0f;         // Hz
+        float alpha = 1.0f;             // How far this frame is from the previous tick (0) to the latest (1)
+        uint32_t ticksLastFrame = 0;
+        double frameMs = 0.0;           // Wall time between rendered frames, smoothed
+        double tickMs = 0.0;            // CPU time of one simulation tick, smoothed
+    };
+
+    // Heap traffic behind the scene's entities. A level load should grow these
+    // by O(blocks + chunks), not by one call per entity and component.
+    struct SceneAllocationStats {
+        PoolStats entities;
+        PoolStats components;
+        size_t chunkAllocations = 0;
+
+        size_t HeapAllocations() const { return entities.blockAllocations + components.blockAllocations + chunkAllocations; }
+    };
+
     class Scene {
     public:
+        // Slot map: an entity keeps its slot for life and freed slots hold nullptr
+        // until CreateEntity recycles them. Always null-check while iterating.
         std::vector<CBaseEntity*> entities;
+        EntityStorage storage;
+        SystemScheduler systems;        // Per-frame gameplay updates, see Engine::Initialize
+        SpatialIndex spatial;           // World bounds keyed by slot, kept current by TransformSystem::Update
+        SimulationTime time;
         PhysicsServer* physics = nullptr;
         EnvironmentSettings environment; 
         std::string name = "Untitled Scene"; 
 
-        ~Scene() {
-            // When the scene is destroyed 
-            // delete everything
-            for (CBaseEntity* ent : entities) {
-                delete ent;
-            }
-            entities.clear();
+        ~Scene();
+
+        CBaseEntity* CreateEntity(const std::string& className = "prop_dynamic");
+
+        // O(1). Returns nullptr if the handle's entity was deleted, even if the slot was reused.
+        CBaseEntity* GetEntity(EntityHandle handle) const {
+            if (handle.index >= entities.size()) return nullptr;
+            if (generations[handle.index] != handle.generation) return nullptr;
+            return entities[handle.index];
         }
 
-        CBaseEntity* CreateEntity(const std::string& className = "prop_dynamic") {
-            CBaseEntity* ent = new CBaseEntity();
-            ent->index = (int)entities.size();
-            ent->className = className; 
-            entities.push_back(ent);
-            return ent;
+        bool IsAlive(EntityHandle handle) const { return GetEntity(handle) != nullptr; }
+
+        // O(1) + the size of the parent's child list. Stale handles are ignored.
+        // While a snapshot is active, entities from before it are only detached and
+        // hidden (handle stale, out of every index) so RestoreSnapshot can bring them back.
+        void DeleteEntity(EntityHandle handle);
+
+        // Mass despawn, O(k) in the number of handles
+        void DeleteEntities(const std::vector<EntityHandle>& handles);
+
+        // Bulk unload. Every entity, component and row is dropped in one sweep and the
+        // pools keep their memory for the next level. Handles still go stale.
+        void Clear();
+
+        // --- CLASS INDEX ---
+        // Every live entity of one class, kept up to date on create/delete/SetEntityClass.
+        // Order is not stable (swap-remove).
+        const std::vector<CBaseEntity*>& EntitiesOfClass(ClassID id) const {
+            static const std::vector<CBaseEntity*> empty;
+            return id < classMembers.size() ? classMembers[id] : empty;
         }
 
-        void DeleteEntity(int index) {
-            if (index >= 0 && index < entities.size()) {
-                CBaseEntity* target = entities[index];
-                if (!target) return; // Already deleted
-
-                // Sweep the scene and remove this child from any parents ---
-                for (CBaseEntity* ent : entities) {
-                    if (ent && !ent->children.empty()) {
-                        // Erase-remove idiom to safely filter out the dead pointer
-                        ent->children.erase(
-                            std::remove(ent->children.begin(), ent->children.end(), target),
-                            ent->children.end()
-                        );
-                    }
-                }
-                
-                delete target;
-                entities.erase(entities.begin() + index); 
-
-                // Re-sync
-                for (int i = 0; i < entities.size(); i++) {
-                    entities[i]->index = i;
-                }
-            }
+        CBaseEntity* FirstOfClass(ClassID id) const {
+            const auto& members = EntitiesOfClass(id);
+            return members.empty() ? nullptr : members.front();
         }
 
-        void Clear() {
-            for (auto* ent : entities) if (ent) delete ent;
-            entities.clear();
+        void SetEntityClass(CBaseEntity* ent, const std::string& className);
+
+        // Re-links the hierarchy and flags the child so its world matrix is rebuilt. nullptr detaches.
+        void SetParent(CBaseEntity* child, CBaseEntity* parent);
+
+        size_t EntityCount() const { return liveCount; }
+
+        // --- SPATIAL QUERIES ---
+        // Against world bounds as of the last TransformSystem::Update. Results are appended.
+        // Safe from several threads at once, just not while the transform pass runs.
+        void QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<CBaseEntity*>& out) const;
+        void QuerySphere(const glm::vec3& center, float radius, std::vector<CBaseEntity*>& out) const;
+        void QueryFrustum(const glm::mat4& viewProj, std::vector<CBaseEntity*>& out) const;
+
+        // Nearest entity whose bounds the ray hits, or nullptr. 'dir' must be normalized.
+        CBaseEntity* Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, float* hitDistance = nullptr) const;
+
+        // --- PLAY MODE SNAPSHOT ---
+        // BeginSnapshot is cheap: storage rows are copied lazily, a chunk at a time,
+        // the first time play writes to them. RestoreSnapshot deletes everything made
+        // since, brings back what was deleted, drops added components and puts rows,
+        // components, hierarchy and visibility back. Physics is restored separately.
+        void BeginSnapshot();
+        void RestoreSnapshot();
+        void EndSnapshot();     // Keep the current state, forget the snapshot
+        bool SnapshotActive() const { return storage.SnapshotActive(); }
+
+        SceneAllocationStats AllocationStats() const {
+            SceneAllocationStats stats;
+            stats.entities = entityPool.Stats();
+            stats.components = storage.ComponentStats();
+            stats.chunkAllocations = storage.ChunkAllocations();
+            return stats;
+        }
+
+    private:
+        std::vector<uint32_t> generations;      // Bumped every time a slot is freed
+        std::vector<uint32_t> freeSlots;
+        size_t liveCount = 0;
+
+        // Entities are placement-new'd here instead of one heap call each
+        BlockPool<CBaseEntity, 256> entityPool;
+
+        std::vector<std::vector<CBaseEntity*>> classMembers;    // Indexed by ClassID
+
+        // What storage doesn't cover, per slot as of BeginSnapshot
+        struct EntitySnapshot {
+            EntityHandle handle;                // Invalid = slot was free
+            CBaseEntity* parent = nullptr;
+            std::vector<CBaseEntity*> children;
+            uint32_t componentMask = 0;
+            int modelIndex = -1;
+            bool visible = true;
+        };
+        std::vector<EntitySnapshot> snapshot;
+        std::vector<CBaseEntity*> deferredDeletes;              // Deleted during play, still allocated
+
+        bool InSnapshot(const CBaseEntity* ent) const {
+            return ent->index < static_cast<int>(snapshot.size()) && snapshot[ent->index].handle == ent->handle;
         }
 
+        void DestroySlot(uint32_t slot);
+        void DetachSlot(uint32_t slot);
+        void ResolveIDs(const std::vector<uint32_t>& ids, std::vector<CBaseEntity*>& out) const;
+        void AddToClassIndex(CBaseEntity* ent);
+        void RemoveFromClassIndex(CBaseEntity* ent);
     };
-}
\ No newline at end of file
+}
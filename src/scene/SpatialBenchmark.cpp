@@ -0,0 +1,146 @@
+#include "scene/SpatialBenchmark.hpp"
+#include "scene/SpatialIndex.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Crescendo {
+
+    using BenchClock = std::chrono::high_resolution_clock;
+
+    static double MillisSince(BenchClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    static void Report(const char* label, size_t ops, double ms, size_t hits) {
+        char line[160];
+        std::snprintf(line, sizeof(line), "    %-22s %9.3f ms  %10.3f us/op  %10.1f hits/op",
+                      label, ms, ops ? (ms * 1000.0) / ops : 0.0, ops ? double(hits) / ops : 0.0);
+        std::cout << line << std::endl;
+    }
+
+    void RunSpatialBenchmark(const std::vector<size_t>& sizes) {
+        // Objects are spread so density stays roughly constant as the population grows
+        constexpr size_t QUERY_COUNT = 1000;
+        constexpr size_t BATCH_COUNT = 10000;
+
+        std::cout << "[SpatialBenchmark] Loose octree, " << QUERY_COUNT << " queries per type" << std::endl;
+
+        for (size_t n : sizes) {
+            std::mt19937 rng(1337);
+            float extent = 64.0f * std::cbrt(float(n));
+            std::uniform_real_distribution<float> pos(-extent, extent);
+            std::uniform_real_distribution<float> rad(0.5f, 4.0f);
+            std::uniform_real_distribution<float> jitter(-0.25f, 0.25f);
+
+            std::vector<glm::vec4> spheres(n);
+            for (auto& s : spheres) s = glm::vec4(pos(rng), pos(rng), pos(rng), rad(rng));
+
+            std::cout << "  N = " << n << " (extent +/-" << extent << ")" << std::endl;
+            SpatialIndex index;
+
+            // --- UPDATE COST ---
+            auto start = BenchClock::now();
+            for (size_t i = 0; i < n; i++) index.Update(uint32_t(i), glm::vec3(spheres[i]), spheres[i].w);
+            Report("insert", n, MillisSince(start), 0);
+
+            // A typical frame: 10% of everything drifts a little
+            size_t movers = n / 10;
+            start = BenchClock::now();
+            for (size_t i = 0; i < movers; i++) {
+                glm::vec4& s = spheres[(i * 7919) % n];
+                s += glm::vec4(jitter(rng), jitter(rng), jitter(rng), 0.0f);
+                index.Update(uint32_t((i * 7919) % n), glm::vec3(s), s.w);
+            }
+            Report("move (small, 10%)", movers, MillisSince(start), 0);
+
+            // Teleports always change cell, the worst case
+            size_t teleports = n / 100;
+            start = BenchClock::now();
+            for (size_t i = 0; i < teleports; i++) {
+                glm::vec4& s = spheres[(i * 104729) % n];
+                s = glm::vec4(pos(rng), pos(rng), pos(rng), s.w);
+                index.Update(uint32_t((i * 104729) % n), glm::vec3(s), s.w);
+            }
+            Report("move (teleport, 1%)", teleports, MillisSince(start), 0);
+
+            // --- QUERY COST ---
+            std::vector<uint32_t> results;
+            std::vector<SpatialHit> hits;
+            size_t total = 0;
+
+            start = BenchClock::now();
+            for (size_t q = 0; q < QUERY_COUNT; q++) {
+                results.clear();
+                index.QuerySphere(glm::vec3(pos(rng), pos(rng), pos(rng)), 50.0f, results);
+                total += results.size();
+            }
+            Report("sphere r=50", QUERY_COUNT, MillisSince(start), total);
+
+            // Brute force over the same data, for scale
+            total = 0;
+            start = BenchClock::now();
+            for (size_t q = 0; q < QUERY_COUNT / 10; q++) {
+                glm::vec3 c(pos(rng), pos(rng), pos(rng));
+                for (const auto& s : spheres) {
+                    glm::vec3 d = glm::vec3(s) - c;
+                    if (glm::dot(d, d) <= (s.w + 50.0f) * (s.w + 50.0f)) total++;
+                }
+            }
+            Report("sphere r=50 (linear)", QUERY_COUNT / 10, MillisSince(start), total);
+
+            total = 0;
+            start = BenchClock::now();
+            for (size_t q = 0; q < QUERY_COUNT; q++) {
+                glm::vec3 c(pos(rng), pos(rng), pos(rng));
+                results.clear();
+                index.QueryAABB(c - 50.0f, c + 50.0f, results);
+                total += results.size();
+            }
+            Report("aabb 100^3", QUERY_COUNT, MillisSince(start), total);
+
+            total = 0;
+            start = BenchClock::now();
+            for (size_t q = 0; q < QUERY_COUNT; q++) {
+                glm::vec3 origin(pos(rng), pos(rng), pos(rng));
+                glm::vec3 dir = glm::normalize(glm::vec3(pos(rng), pos(rng), pos(rng)) + glm::vec3(0.001f));
+                hits.clear();
+                index.Raycast(origin, dir, 2000.0f, hits);
+                total += hits.size();
+            }
+            Report("ray 2000", QUERY_COUNT, MillisSince(start), total);
+
+            // Camera-like frustum, 1km far plane
+            glm::mat4 proj = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+            glm::vec4 planes[6];
+            total = 0;
+            start = BenchClock::now();
+            for (size_t q = 0; q < QUERY_COUNT / 10; q++) {
+                glm::vec3 eye(pos(rng), pos(rng), pos(rng));
+                glm::vec3 target(pos(rng), pos(rng), pos(rng));
+                SpatialIndex::ExtractFrustumPlanes(proj * glm::lookAt(eye, target, glm::vec3(0.0f, 0.0f, 1.0f)), planes);
+                results.clear();
+                index.QueryFrustum(planes, results);
+                total += results.size();
+            }
+            Report("frustum 1km", QUERY_COUNT / 10, MillisSince(start), total);
+
+            // --- BATCHED ---
+            std::vector<glm::vec4> batch(BATCH_COUNT);
+            for (auto& b : batch) b = glm::vec4(pos(rng), pos(rng), pos(rng), 50.0f);
+            std::vector<std::vector<uint32_t>> batchResults;
+
+            start = BenchClock::now();
+            index.QuerySphereBatch(batch, batchResults);
+            double batchMs = MillisSince(start);
+            total = 0;
+            for (const auto& r : batchResults) total += r.size();
+            Report("sphere batch (MT)", BATCH_COUNT, batchMs, total);
+
+            std::cout << "    nodes: " << index.NodeCount() << std::endl;
+        }
+        std::cout << "[SpatialBenchmark] Done." << std::endl;
+    }
+}
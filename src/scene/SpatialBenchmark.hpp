@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace Crescendo {
+
+    // Synthetic load for the SpatialIndex: random spheres, per-frame movers and
+    // every query type, timed at each population size. Prints a table to stdout
+    // (the editor console mirrors it). Run with the "bench_spatial" console command.
+    void RunSpatialBenchmark(const std::vector<size_t>& sizes = { 10000, 100000, 1000000 });
+}
@@ -0,0 +1,353 @@
+#include "scene/SpatialIndex.hpp"
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Crescendo {
+
+    // Queries per job. Below this the thread hand-off costs more than it saves.
+    static constexpr size_t PARALLEL_QUERY_THRESHOLD = 32;
+
+    SpatialIndex::SpatialIndex(const glm::vec3& center, float halfSize) {
+        AllocateNode(-1, center, halfSize, 0);
+    }
+
+    // =========================================================
+    // PLACEMENT
+    // =========================================================
+
+    uint32_t SpatialIndex::DepthFor(float radius) const {
+        // Deepest level whose cell half-size still covers the radius, so the
+        // sphere never leaves the loose bounds of the cell holding its center
+        if (radius <= 0.0f) return MAX_DEPTH;
+        float levels = std::floor(std::log2(nodes[0].halfSize / radius));
+        if (levels <= 0.0f) return 0;
+        return std::min(static_cast<uint32_t>(levels), MAX_DEPTH);
+    }
+
+    bool SpatialIndex::CellContains(const Node& node, const glm::vec3& point) const {
+        glm::vec3 d = glm::abs(point - node.center);
+        return d.x <= node.halfSize && d.y <= node.halfSize && d.z <= node.halfSize;
+    }
+
+    bool SpatialIndex::Fits(const Node& node, const glm::vec4& sphere) const {
+        glm::vec3 center(sphere);
+        if (node.parent < 0) {
+            // Outside the indexed volume the root is the only home
+            if (!CellContains(node, center)) return true;
+        } else if (sphere.w > node.halfSize || !CellContains(node, center)) {
+            return false;
+        }
+
+        // Small enough for an existing child: re-insert so it descends instead of staying up here
+        if (DepthFor(sphere.w) > node.depth && node.children[OctantOf(node, center)] >= 0) return false;
+        return true;
+    }
+
+    int SpatialIndex::OctantOf(const Node& node, const glm::vec3& point) const {
+        return (point.x >= node.center.x ? 1 : 0) |
+               (point.y >= node.center.y ? 2 : 0) |
+               (point.z >= node.center.z ? 4 : 0);
+    }
+
+    int32_t SpatialIndex::ChildFor(int32_t index, int octant) {
+        int32_t child = nodes[index].children[octant];
+        if (child >= 0) return child;
+
+        const Node& node = nodes[index];
+        float half = node.halfSize * 0.5f;
+        glm::vec3 offset((octant & 1) ? half : -half, (octant & 2) ? half : -half, (octant & 4) ? half : -half);
+        glm::vec3 childCenter = node.center + offset;
+        uint32_t childDepth = node.depth + 1;
+
+        // AllocateNode can grow 'nodes', so nothing above may be held by reference past here
+        child = AllocateNode(index, childCenter, half, childDepth);
+        nodes[index].children[octant] = child;
+        return child;
+    }
+
+    void SpatialIndex::Split(int32_t index) {
+        if (nodes[index].depth >= MAX_DEPTH) return;
+
+        // Push every item that fits a child down one level, the rest stay
+        for (size_t i = 0; i < nodes[index].items.size();) {
+            Item item = nodes[index].items[i];
+            if (DepthFor(item.sphere.w) <= nodes[index].depth || !CellContains(nodes[index], glm::vec3(item.sphere))) {
+                i++;
+                continue;
+            }
+
+            int32_t child = ChildFor(index, OctantOf(nodes[index], glm::vec3(item.sphere)));
+            auto& here = nodes[index].items;       // ChildFor may have moved the node array
+            here[i] = here.back();
+            proxies[here[i].id].item = static_cast<uint32_t>(i);
+            here.pop_back();
+
+            Node& target = nodes[child];
+            proxies[item.id] = { child, static_cast<uint32_t>(target.items.size()) };
+            target.items.push_back(item);
+            target.subtreeCount++;                  // Ancestors already counted it
+        }
+
+        // Children that ended up overfull split in turn
+        for (int octant = 0; octant < 8; octant++) {
+            int32_t child = nodes[index].children[octant];
+            if (child >= 0 && nodes[child].items.size() > SPLIT_THRESHOLD) Split(child);
+        }
+    }
+
+    int32_t SpatialIndex::AllocateNode(int32_t parent, const glm::vec3& center, float halfSize, uint32_t depth) {
+        int32_t index;
+        if (!freeNodes.empty()) {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+        } else {
+            index = static_cast<int32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+
+        Node& node = nodes[index];
+        node.center = center;
+        node.halfSize = halfSize;
+        node.parent = parent;
+        std::fill(std::begin(node.children), std::end(node.children), -1);
+        node.depth = depth;
+        node.subtreeCount = 0;
+        node.items.clear();
+        return index;
+    }
+
+    void SpatialIndex::AdjustCounts(int32_t index, int32_t delta) {
+        while (index >= 0) {
+            Node& node = nodes[index];
+            node.subtreeCount += delta;
+            int32_t parent = node.parent;
+
+            // Prune empty branches so queries never walk dead cells
+            if (node.subtreeCount == 0 && parent >= 0) {
+                for (int32_t& slot : nodes[parent].children) {
+                    if (slot == index) slot = -1;
+                }
+                node.items.clear();
+                freeNodes.push_back(index);
+            }
+            index = parent;
+        }
+    }
+
+    void SpatialIndex::Update(uint32_t id, const glm::vec3& center, float radius) {
+        if (id >= proxies.size()) proxies.resize(id + 1);
+        glm::vec4 sphere(center, radius);
+
+        // Still fits where it is: overwrite in place
+        if (proxies[id].node >= 0) {
+            const Proxy& proxy = proxies[id];
+            if (Fits(nodes[proxy.node], sphere)) {
+                nodes[proxy.node].items[proxy.item].sphere = sphere;
+                return;
+            }
+            Remove(id);
+        }
+
+        // Walk down through existing nodes as far as the radius allows
+        uint32_t depth = DepthFor(radius);
+        int32_t target = 0;
+        if (CellContains(nodes[0], center)) {
+            while (nodes[target].depth < depth) {
+                int32_t child = nodes[target].children[OctantOf(nodes[target], center)];
+                if (child < 0) break;
+                target = child;
+            }
+        }
+
+        Node& node = nodes[target];
+        proxies[id] = { target, static_cast<uint32_t>(node.items.size()) };
+        node.items.push_back({ sphere, id });
+        AdjustCounts(target, 1);
+        count++;
+
+        if (nodes[target].items.size() > SPLIT_THRESHOLD) Split(target);
+    }
+
+    void SpatialIndex::Remove(uint32_t id) {
+        if (!Contains(id)) return;
+
+        Proxy& proxy = proxies[id];
+        int32_t index = proxy.node;
+        auto& items = nodes[index].items;
+
+        // Swap-remove, the item moved into the hole gets its proxy patched
+        items[proxy.item] = items.back();
+        proxies[items[proxy.item].id].item = proxy.item;
+        items.pop_back();
+
+        proxy = Proxy{};
+        AdjustCounts(index, -1);
+        count--;
+    }
+
+    void SpatialIndex::Clear() {
+        glm::vec3 center = nodes[0].center;
+        float halfSize = nodes[0].halfSize;
+
+        nodes.clear();
+        freeNodes.clear();
+        std::fill(proxies.begin(), proxies.end(), Proxy{});
+        count = 0;
+        AllocateNode(-1, center, halfSize, 0);
+    }
+
+    // =========================================================
+    // QUERIES
+    // =========================================================
+
+    template<typename NodeTest, typename ItemFn>
+    void SpatialIndex::Walk(NodeTest&& nodeTest, ItemFn&& itemFn) const {
+        int32_t stack[8 * (MAX_DEPTH + 1) + 1];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            if (node.subtreeCount == 0) continue;
+
+            for (const Item& item : node.items) itemFn(item);
+
+            for (int32_t child : node.children) {
+                if (child < 0) continue;
+                const Node& c = nodes[child];
+                if (nodeTest(c.center, c.halfSize * 2.0f)) stack[top++] = child;
+            }
+        }
+    }
+
+    void SpatialIndex::QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) const {
+        Walk(
+            [&](const glm::vec3& c, float h) {
+                return glm::all(glm::lessThanEqual(c - h, max)) && glm::all(glm::greaterThanEqual(c + h, min));
+            },
+            [&](const Item& item) {
+                glm::vec3 p = glm::clamp(glm::vec3(item.sphere), min, max);
+                glm::vec3 d = p - glm::vec3(item.sphere);
+                if (glm::dot(d, d) <= item.sphere.w * item.sphere.w) out.push_back(item.id);
+            });
+    }
+
+    void SpatialIndex::QuerySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const {
+        Walk(
+            [&](const glm::vec3& c, float h) {
+                glm::vec3 d = glm::max(glm::abs(center - c) - h, glm::vec3(0.0f));
+                return glm::dot(d, d) <= radius * radius;
+            },
+            [&](const Item& item) {
+                glm::vec3 d = glm::vec3(item.sphere) - center;
+                float r = item.sphere.w + radius;
+                if (glm::dot(d, d) <= r * r) out.push_back(item.id);
+            });
+    }
+
+    void SpatialIndex::QueryFrustum(const glm::vec4 planes[6], std::vector<uint32_t>& out) const {
+        Walk(
+            [&](const glm::vec3& c, float h) {
+                for (int i = 0; i < 6; i++) {
+                    glm::vec3 n(planes[i]);
+                    float reach = h * (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+                    if (glm::dot(n, c) + planes[i].w < -reach) return false;
+                }
+                return true;
+            },
+            [&](const Item& item) {
+                glm::vec3 c(item.sphere);
+                for (int i = 0; i < 6; i++) {
+                    if (glm::dot(glm::vec3(planes[i]), c) + planes[i].w < -item.sphere.w) return;
+                }
+                out.push_back(item.id);
+            });
+    }
+
+    void SpatialIndex::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, std::vector<SpatialHit>& out) const {
+        glm::vec3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+        size_t first = out.size();
+
+        Walk(
+            [&](const glm::vec3& c, float h) {
+                // Slab test against the loose box
+                glm::vec3 t0 = (c - h - origin) * invDir;
+                glm::vec3 t1 = (c + h - origin) * invDir;
+                glm::vec3 tMin = glm::min(t0, t1), tMax = glm::max(t0, t1);
+                float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+                float exit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+                return enter <= exit;
+            },
+            [&](const Item& item) {
+                glm::vec3 oc = origin - glm::vec3(item.sphere);
+                float b = glm::dot(oc, dir);
+                float c = glm::dot(oc, oc) - item.sphere.w * item.sphere.w;
+                if (c > 0.0f && b > 0.0f) return;   // Outside and pointing away
+
+                float disc = b * b - c;
+                if (disc < 0.0f) return;
+
+                float t = std::max(-b - std::sqrt(disc), 0.0f);
+                if (t <= maxDistance) out.push_back({ item.id, t });
+            });
+
+        std::sort(out.begin() + first, out.end(), [](const SpatialHit& a, const SpatialHit& b) { return a.distance < b.distance; });
+    }
+
+    // =========================================================
+    // BATCHED QUERIES
+    // =========================================================
+
+    template<typename Fn>
+    static void ParallelFor(size_t count, Fn&& fn) {
+        JobSystem::Get().ParallelFor(count, PARALLEL_QUERY_THRESHOLD, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) fn(i);
+        });
+    }
+
+    void SpatialIndex::QuerySphereBatch(const std::vector<glm::vec4>& spheres, std::vector<std::vector<uint32_t>>& results) const {
+        results.resize(spheres.size());
+        ParallelFor(spheres.size(), [&](size_t i) {
+            results[i].clear();
+            QuerySphere(glm::vec3(spheres[i]), spheres[i].w, results[i]);
+        });
+    }
+
+    void SpatialIndex::QueryAABBBatch(const std::vector<std::pair<glm::vec3, glm::vec3>>& boxes, std::vector<std::vector<uint32_t>>& results) const {
+        results.resize(boxes.size());
+        ParallelFor(boxes.size(), [&](size_t i) {
+            results[i].clear();
+            QueryAABB(boxes[i].first, boxes[i].second, results[i]);
+        });
+    }
+
+    void SpatialIndex::RaycastBatch(const std::vector<std::pair<glm::vec3, glm::vec3>>& rays, float maxDistance, std::vector<std::vector<SpatialHit>>& results) const {
+        results.resize(rays.size());
+        ParallelFor(rays.size(), [&](size_t i) {
+            results[i].clear();
+            Raycast(rays[i].first, rays[i].second, maxDistance, results[i]);
+        });
+    }
+
+    void SpatialIndex::ExtractFrustumPlanes(const glm::mat4& viewProj, glm::vec4 planes[6]) {
+        const glm::mat4& m = viewProj;
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        // Left, Right, Bottom, Top, Near (-1..1 depth, conservative for 0..1), Far
+        planes[0] = row3 + row0;
+        planes[1] = row3 - row0;
+        planes[2] = row3 + row1;
+        planes[3] = row3 - row1;
+        planes[4] = row3 + row2;
+        planes[5] = row3 - row2;
+
+        for (int i = 0; i < 6; i++) {
+            float len = glm::length(glm::vec3(planes[i]));
+            if (len > 0.0f) planes[i] /= len;
+        }
+    }
+}
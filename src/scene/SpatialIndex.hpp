@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Crescendo {
+
+    // =========================================================
+    // SPATIAL INDEX (LOOSE OCTREE)
+    // Bounding spheres keyed by entity slot. Each node's loose bounds
+    // are twice its cell, so an object fits any cell that holds its
+    // center and is at least as big as its radius. Nodes only split
+    // once they hold more than SPLIT_THRESHOLD items, so sparse regions
+    // stay shallow. Moving while still inside the same cell is an
+    // in-place write, which is the common case for per-frame movers;
+    // an item that could sit in an existing child is re-inserted, so
+    // only out-of-volume or oversized items stay on the root.
+    //
+    // Queries are const and may run from any number of threads, as
+    // long as nothing calls Update/Remove at the same time. The
+    // TransformSystem is the only writer during a frame.
+    // =========================================================
+
+    struct SpatialHit {
+        uint32_t id;
+        float distance;     // Along the ray, 0 if the origin starts inside the sphere
+    };
+
+    class SpatialIndex {
+    public:
+        static constexpr float DEFAULT_HALF_SIZE = 32768.0f;
+        static constexpr uint32_t MAX_DEPTH = 12;
+        static constexpr size_t SPLIT_THRESHOLD = 16;
+
+        explicit SpatialIndex(const glm::vec3& center = glm::vec3(0.0f), float halfSize = DEFAULT_HALF_SIZE);
+
+        // Inserts the id, or moves it if it's already indexed
+        void Update(uint32_t id, const glm::vec3& center, float radius);
+        void Remove(uint32_t id);
+        void Clear();
+
+        bool Contains(uint32_t id) const { return id < proxies.size() && proxies[id].node >= 0; }
+        size_t Size() const { return count; }
+        size_t NodeCount() const { return nodes.size() - freeNodes.size(); }
+
+        // --- QUERIES ---
+        // Results are appended, ids are in no particular order unless stated
+        void QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) const;
+        void QuerySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+        void QueryFrustum(const glm::vec4 planes[6], std::vector<uint32_t>& out) const;
+
+        // Every sphere the ray touches within maxDistance, nearest first. 'dir' must be normalized.
+        void Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, std::vector<SpatialHit>& out) const;
+
+        // --- BATCHED QUERIES ---
+        // One result list per query, spread across worker threads. Same rules as the single queries.
+        void QuerySphereBatch(const std::vector<glm::vec4>& spheres, std::vector<std::vector<uint32_t>>& results) const;
+        void QueryAABBBatch(const std::vector<std::pair<glm::vec3, glm::vec3>>& boxes, std::vector<std::vector<uint32_t>>& results) const;
+        void RaycastBatch(const std::vector<std::pair<glm::vec3, glm::vec3>>& rays, float maxDistance, std::vector<std::vector<SpatialHit>>& results) const;
+
+        // Normalized planes (xyz normal, w distance) pointing inwards, from a projection * view matrix
+        static void ExtractFrustumPlanes(const glm::mat4& viewProj, glm::vec4 planes[6]);
+
+    private:
+        struct Item {
+            glm::vec4 sphere;   // xyz center, w radius
+            uint32_t id;
+        };
+
+        struct Node {
+            glm::vec3 center;
+            float halfSize;             // Of the cell. The loose bounds are twice this.
+            int32_t parent = -1;
+            int32_t children[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+            uint32_t depth = 0;
+            uint32_t subtreeCount = 0;  // Items here and below, empty subtrees are skipped and pruned
+            std::vector<Item> items;
+        };
+
+        struct Proxy {
+            int32_t node = -1;
+            uint32_t item = 0;
+        };
+
+        std::vector<Node> nodes;        // nodes[0] is the root
+        std::vector<int32_t> freeNodes;
+        std::vector<Proxy> proxies;     // Indexed by id
+        size_t count = 0;
+
+        uint32_t DepthFor(float radius) const;
+        bool CellContains(const Node& node, const glm::vec3& point) const;
+        bool Fits(const Node& node, const glm::vec4& sphere) const;
+        int OctantOf(const Node& node, const glm::vec3& point) const;
+        int32_t ChildFor(int32_t index, int octant);
+        void Split(int32_t index);
+        int32_t AllocateNode(int32_t parent, const glm::vec3& center, float halfSize, uint32_t depth);
+        void AdjustCounts(int32_t node, int32_t delta);
+
+        template<typename NodeTest, typename ItemFn>
+        void Walk(NodeTest&& nodeTest, ItemFn&& itemFn) const;
+    };
+}
@@ -0,0 +1,105 @@
+#include "scene/SystemScheduler.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+namespace Crescendo {
+
+    // Items per batch. Small enough to balance, big enough that the atomic pull is noise.
+    static constexpr size_t BATCH_SIZE = 128;
+
+    void SystemScheduler::AddSystem(const std::string& name, AccessMask reads, AccessMask writes,
+                                    CountFn count, BatchFn run, bool batched) {
+        System sys;
+        sys.reads = reads;
+        sys.writes = writes;
+        sys.count = std::move(count);
+        sys.run = std::move(run);
+        sys.batched = batched;
+        sys.profileName = Profiler::Intern(name);
+        systems.push_back(std::move(sys));
+
+        SystemTiming timing;
+        timing.name = name;
+        timings.push_back(timing);
+
+        stagesDirty = true;
+    }
+
+    void SystemScheduler::BuildStages() {
+        stages.clear();
+
+        // A system lands one stage after the latest earlier system it conflicts with,
+        // so conflicting systems always run in registration order
+        for (size_t i = 0; i < systems.size(); i++) {
+            uint32_t stage = 0;
+            for (size_t j = 0; j < i; j++) {
+                if (Conflicts(systems[j], systems[i])) stage = std::max(stage, timings[j].stage + 1);
+            }
+
+            if (stage >= stages.size()) stages.resize(stage + 1);
+            stages[stage].push_back(i);
+            timings[i].stage = stage;
+        }
+
+        std::cout << "[Scheduler] " << systems.size() << " systems in " << stages.size() << " stages." << std::endl;
+        stagesDirty = false;
+    }
+
+    void SystemScheduler::RunStage(const std::vector<size_t>& stage, float dt) {
+        struct Task {
+            size_t system;
+            size_t begin;
+            size_t end;
+        };
+
+        // 1. Cut every system in the stage into tasks. Counts are taken here, on the
+        // calling thread, after the previous stage has finished writing.
+        std::vector<Task> tasks;
+        for (size_t sysIndex : stage) {
+            size_t count = systems[sysIndex].count();
+            timings[sysIndex].items = count;
+            if (count == 0) continue;
+
+            size_t step = systems[sysIndex].batched ? BATCH_SIZE : count;
+            for (size_t begin = 0; begin < count; begin += step) {
+                tasks.push_back({ sysIndex, begin, std::min(begin + step, count) });
+            }
+        }
+
+        std::vector<std::atomic<int64_t>> nanos(systems.size());
+        for (auto& n : nanos) n.store(0, std::memory_order_relaxed);
+
+        // 2. The shared job workers drain the stage, the calling thread helps
+        JobSystem::Get().ParallelFor(tasks.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; t++) {
+                const Task& task = tasks[t];
+                PROFILE_SCOPE(systems[task.system].profileName);
+                auto start = std::chrono::high_resolution_clock::now();
+                systems[task.system].run(task.begin, task.end, dt);
+                auto elapsed = std::chrono::high_resolution_clock::now() - start;
+                nanos[task.system].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+            }
+        });
+
+        // 3. Fold this frame's numbers into the timings
+        for (size_t sysIndex : stage) {
+            SystemTiming& timing = timings[sysIndex];
+            timing.lastMs = nanos[sysIndex].load(std::memory_order_relaxed) / 1.0e6;
+            timing.avgMs = timing.avgMs * 0.95 + timing.lastMs * 0.05;
+        }
+    }
+
+    void SystemScheduler::Run(float dt) {
+        if (stagesDirty) BuildStages();
+
+        auto frameStart = std::chrono::high_resolution_clock::now();
+        for (const auto& stage : stages) {
+            RunStage(stage, dt);
+        }
+        lastFrameMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - frameStart).count();
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "EntityStorage.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // SYSTEM SCHEDULER
+    // Every per-frame update is registered as a system that declares
+    // what it reads and writes. Systems are packed into stages: two
+    // systems share a stage only if neither writes something the other
+    // touches, otherwise the later-registered one moves to a later
+    // stage. Each stage's systems are split into batches and the
+    // batches are run across worker threads together.
+    // =========================================================
+
+    // Bits 0-31 are component types (ComponentBit), the upper half are
+    // shared engine state that isn't a component.
+    using AccessMask = uint64_t;
+
+    enum EngineAccess : AccessMask {
+        ACCESS_ENTITY_TRANSFORM = 1ull << 32,   // Origin/Angles/Scale columns
+        ACCESS_ENTITY_MATERIAL  = 1ull << 33,
+        ACCESS_SCRIPT_STATE     = 1ull << 34,   // sol::state is single-threaded
+        ACCESS_EVERYTHING       = ~0ull
+    };
+
+    template<typename... Ts>
+    constexpr AccessMask AccessOf() { return (AccessMask(0) | ... | (AccessMask(1) << Ts::TypeID)); }
+
+    struct SystemTiming {
+        std::string name;
+        uint32_t stage = 0;
+        size_t items = 0;
+        double lastMs = 0.0;        // CPU time summed over all of this system's batches
+        double avgMs = 0.0;         // Smoothed, what the editor shows
+    };
+
+    class SystemScheduler {
+    public:
+        // Items this frame, evaluated when the system's stage starts
+        using CountFn = std::function<size_t()>;
+        // Update items [begin, end). May run on any worker thread.
+        using BatchFn = std::function<void(size_t begin, size_t end, float dt)>;
+
+        // 'batched' = items are independent and may be split across threads.
+        // Otherwise the whole range runs as one task (still alongside other systems).
+        void AddSystem(const std::string& name, AccessMask reads, AccessMask writes,
+                       CountFn count, BatchFn run, bool batched = true);
+
+        // Component::Update over every live T. A component's Update may write itself
+        // and read its owner's transform; anything more needs its own system.
+        template<typename T>
+        void AddComponentUpdate(EntityStorage& storage, const std::string& name) {
+            AddSystem(name, ACCESS_ENTITY_TRANSFORM | AccessOf<T>(), AccessOf<T>(),
+                [&storage]() { return storage.Components<T>().size(); },
+                [&storage](size_t begin, size_t end, float dt) {
+                    const auto& items = storage.Components<T>();
+                    for (size_t i = begin; i < end; i++) {
+                        if (items[i]->enabled) items[i]->Update(dt);
+                    }
+                });
+        }
+
+        void Run(float dt);
+
+        const std::vector<SystemTiming>& Timings() const { return timings; }
+        double LastFrameMs() const { return lastFrameMs; }
+        size_t StageCount() const { return stages.size(); }
+
+    private:
+        struct System {
+            AccessMask reads = 0;
+            AccessMask writes = 0;
+            CountFn count;
+            BatchFn run;
+            bool batched = true;
+            const char* profileName = nullptr;  // Interned, the timeline keeps the pointer
+        };
+
+        static bool Conflicts(const System& a, const System& b) {
+            return (a.writes & (b.reads | b.writes)) || (b.writes & a.reads);
+        }
+
+        void BuildStages();
+        void RunStage(const std::vector<size_t>& stage, float dt);
+
+        std::vector<System> systems;
+        std::vector<SystemTiming> timings;
+        std::vector<std::vector<size_t>> stages;
+        bool stagesDirty = false;
+        double lastFrameMs = 0.0;
+    };
+}
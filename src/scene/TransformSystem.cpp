@@ -0,0 +1,140 @@
+#include "scene/TransformSystem.hpp"
+#include "scene/Scene.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Crescendo {
+
+    // Dirty subtrees per job. Fewer than this and the thread hand-off costs more than it saves.
+    static constexpr size_t ROOT_BATCH_SIZE = 64;
+
+    glm::mat4 TransformSystem::ComposeLocal(const glm::vec3& origin, const glm::vec3& anglesDeg, const glm::vec3& scale) {
+        glm::vec3 r = glm::radians(anglesDeg);
+        float cx = std::cos(r.x), sx = std::sin(r.x);
+        float cy = std::cos(r.y), sy = std::sin(r.y);
+        float cz = std::cos(r.z), sz = std::sin(r.z);
+
+        glm::mat4 m(1.0f);
+        m[0] = glm::vec4(glm::vec3(cy * cz, cy * sz, -sy) * scale.x, 0.0f);
+        m[1] = glm::vec4(glm::vec3(cz * sx * sy - cx * sz, cx * cz + sx * sy * sz, cy * sx) * scale.y, 0.0f);
+        m[2] = glm::vec4(glm::vec3(cx * cz * sy + sx * sz, -cz * sx + cx * sy * sz, cx * cy) * scale.z, 0.0f);
+        m[3] = glm::vec4(origin, 1.0f);
+        return m;
+    }
+
+    glm::mat4 TransformSystem::ComputeWorldMatrix(const CBaseEntity* ent) {
+        if (!ent) return glm::mat4(1.0f);
+
+        glm::mat4 local = ComposeLocal(ent->Origin(), ent->Angles(), ent->Scale());
+        return ent->moveParent ? ComputeWorldMatrix(ent->moveParent) * local : local;
+    }
+
+    glm::mat4 TransformSystem::Interpolate(const glm::mat4& from, const glm::mat4& to, float t) {
+        glm::vec3 fromScale(glm::length(glm::vec3(from[0])), glm::length(glm::vec3(from[1])), glm::length(glm::vec3(from[2])));
+        glm::vec3 toScale(glm::length(glm::vec3(to[0])), glm::length(glm::vec3(to[1])), glm::length(glm::vec3(to[2])));
+
+        // Zero scale (hidden spawners) has no rotation to recover, just snap
+        if (fromScale.x * fromScale.y * fromScale.z == 0.0f || toScale.x * toScale.y * toScale.z == 0.0f) {
+            return t < 0.5f ? from : to;
+        }
+
+        glm::quat fromRot = glm::quat_cast(glm::mat3(glm::vec3(from[0]) / fromScale.x, glm::vec3(from[1]) / fromScale.y, glm::vec3(from[2]) / fromScale.z));
+        glm::quat toRot   = glm::quat_cast(glm::mat3(glm::vec3(to[0]) / toScale.x, glm::vec3(to[1]) / toScale.y, glm::vec3(to[2]) / toScale.z));
+
+        glm::mat4 m = glm::mat4_cast(glm::slerp(fromRot, toRot, t));
+        glm::vec3 scale = glm::mix(fromScale, toScale, t);
+        m[0] *= scale.x;
+        m[1] *= scale.y;
+        m[2] *= scale.z;
+        m[3] = glm::vec4(glm::mix(glm::vec3(from[3]), glm::vec3(to[3]), t), 1.0f);
+        return m;
+    }
+
+    glm::mat4 TransformSystem::RenderMatrix(const EntityChunk& chunk, uint32_t row, const SimulationTime& time) {
+        if (chunk.worldTick[row] != time.tick || time.alpha >= 1.0f) return chunk.world[row];
+        return Interpolate(chunk.prevWorld[row], chunk.world[row], time.alpha);
+    }
+
+    void TransformSystem::UpdateSubtree(CBaseEntity* root, const glm::mat4& parentWorld, uint32_t tick, std::vector<CBaseEntity*>& updated) {
+        // Explicit stack, imported hierarchies can be deep enough to blow the call stack.
+        // Parents are always written before their children are popped.
+        std::vector<CBaseEntity*> stack;
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            CBaseEntity* ent = stack.back();
+            stack.pop_back();
+
+            EntityChunk& chunk = ent->storage->ChunkOf(ent->location);
+            uint32_t row = EntityStorage::SlotOf(ent->location);
+
+            const glm::mat4& parent = (ent == root || !ent->moveParent) ? parentWorld : ent->moveParent->WorldMatrix();
+            glm::mat4 world = parent * ComposeLocal(chunk.origin[row], chunk.angles[row], chunk.scale[row]);
+
+            // Only the first move in a tick sets where the interpolation starts from
+            if (chunk.worldTick[row] != tick) {
+                chunk.prevWorld[row] = chunk.worldTick[row] == EntityChunk::NO_TICK ? world : chunk.world[row];
+                chunk.worldTick[row] = tick;
+            }
+            chunk.world[row] = world;
+            chunk.dirty[row] = 0;
+            chunk.renderDirty[row] = 1;
+            updated.push_back(ent);
+
+            for (CBaseEntity* child : ent->children) {
+                if (child) stack.push_back(child);
+            }
+        }
+    }
+
+    TransformSystem::Stats TransformSystem::Update(Scene& scene) {
+        PROFILE_SCOPE("TransformSystem::Update");
+        Stats stats;
+
+        // 1. Collect the topmost dirty entity of every dirty subtree.
+        // Anything with a dirty ancestor gets rewritten by that ancestor's pass.
+        std::vector<CBaseEntity*> roots;
+        std::as_const(scene.storage).ForEachChunk(GROUP_TRANSFORM, [&](const EntityChunk& chunk) {
+            for (uint32_t i = 0; i < chunk.count; i++) {
+                if (!chunk.dirty[i]) continue;
+
+                CBaseEntity* ent = chunk.owners[i];
+                bool covered = false;
+                for (const CBaseEntity* p = ent->moveParent; p; p = p->moveParent) {
+                    if (p->IsTransformDirty()) { covered = true; break; }
+                }
+                if (!covered) roots.push_back(ent);
+            }
+        });
+
+        stats.dirtyRoots = roots.size();
+        if (roots.empty()) return stats;
+
+        // 2. Subtrees are disjoint, so each batch owns its roots outright. One updated list per batch.
+        std::vector<std::vector<CBaseEntity*>> updated((roots.size() + ROOT_BATCH_SIZE - 1) / ROOT_BATCH_SIZE);
+        JobSystem::Get().ParallelFor(roots.size(), ROOT_BATCH_SIZE, [&](size_t begin, size_t end) {
+            std::vector<CBaseEntity*>& list = updated[begin / ROOT_BATCH_SIZE];
+            for (size_t i = begin; i < end; i++) {
+                CBaseEntity* ent = roots[i];
+                glm::mat4 parentWorld = ent->moveParent ? ent->moveParent->WorldMatrix() : glm::mat4(1.0f);
+                UpdateSubtree(ent, parentWorld, scene.time.tick, list);
+            }
+        });
+
+        // 3. The spatial index has a single writer, fold every moved entity in on this thread
+        for (const auto& list : updated) {
+            for (CBaseEntity* ent : list) {
+                glm::vec4 sphere = ent->WorldBounds();
+                scene.spatial.Update(static_cast<uint32_t>(ent->index), glm::vec3(sphere), sphere.w);
+            }
+            stats.updated += list.size();
+        }
+
+        return stats;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Crescendo {
+
+    class Scene;
+    class CBaseEntity;
+    struct EntityChunk;
+    struct SimulationTime;
+
+    // =========================================================
+    // TRANSFORM SYSTEM
+    // Entities store local TRS relative to moveParent. This turns them
+    // into cached world matrices, recomputing only subtrees whose root
+    // was flagged dirty, parent-first. Dirty subtrees never overlap, so
+    // they are spread across worker threads. Every rewritten entity
+    // then has its world bounds refreshed in the scene's spatial index.
+    // The first rewrite in a simulation tick keeps the old matrix in
+    // prevWorld so rendering can interpolate between ticks.
+    // =========================================================
+
+    class TransformSystem {
+    public:
+        struct Stats {
+            size_t dirtyRoots = 0;      // Subtrees that needed recomputing this update
+            size_t updated = 0;         // World matrices written
+        };
+
+        // T * Rz * Ry * Rx * S, angles in degrees. Same Euler order the shaders used to rebuild per vertex.
+        static glm::mat4 ComposeLocal(const glm::vec3& origin, const glm::vec3& anglesDeg, const glm::vec3& scale);
+
+        // Walks the parent chain on demand. For importers that need a world pose before the next Update().
+        static glm::mat4 ComputeWorldMatrix(const CBaseEntity* ent);
+
+        static Stats Update(Scene& scene);
+
+        // Blend of two world matrices: translation and scale lerped, rotation slerped
+        static glm::mat4 Interpolate(const glm::mat4& from, const glm::mat4& to, float t);
+
+        // What the renderer should draw for a row: the world matrix eased in from the
+        // previous tick if it moved on the latest one, the plain world matrix otherwise
+        static glm::mat4 RenderMatrix(const EntityChunk& chunk, uint32_t row, const SimulationTime& time);
+
+    private:
+        static void UpdateSubtree(CBaseEntity* ent, const glm::mat4& parentWorld, uint32_t tick, std::vector<CBaseEntity*>& updated);
+    };
+}
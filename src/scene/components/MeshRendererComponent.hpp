@@ -4,30 +4,35 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <imgui.h>
+#include <utility>
 
 namespace Crescendo {
 
     class MeshRendererComponent : public Component {
     public:
+        static constexpr ComponentTypeID TypeID = COMPONENT_MESH_RENDERER;
+
         std::string GetName() const override { return "Mesh Renderer"; }
 
         void DrawInspectorUI() override {
             if (!owner) return;
 
-            // Material UI
+            // Material UI, edited on a copy so an idle inspector doesn't flag the row for the renderer
+            MaterialData mat = std::as_const(*owner).Material();
+            bool changed = false;
             ImGui::TextDisabled("BSDF Material");
-            ImGui::ColorEdit3("Albedo", glm::value_ptr(owner->albedoColor));
-            ImGui::SliderFloat("Roughness", &owner->roughness, 0.0f, 1.0f);
-            ImGui::SliderFloat("Metallic", &owner->metallic, 0.0f, 1.0f);
-            ImGui::SliderFloat("Emission", &owner->emission, 0.0f, 20.0f);
-            ImGui::SliderFloat("Clearcoat", &owner->clearcoat, 0.0f, 1.0f);
-            ImGui::SliderFloat("Coat Roughness", &owner->clearcoatRoughness, 0.0f, 1.0f);
-            ImGui::SliderFloat("Sheen", &owner->sheen, 0.0f, 1.0f);
-            ImGui::SliderFloat("Specular Weight", &owner->specularWeight, 0.0f, 1.0f);
-            ImGui::SliderFloat("Subsurface", &owner->subsurface, 0.0f, 1.0f);
-            ImGui::SliderFloat("Specular", &owner->specular, 0.0f, 1.0f);
-            ImGui::SliderFloat("Specular Tint", &owner->specularTint, 0.0f, 1.0f);
-            ImGui::SliderFloat("Anisotropic", &owner->anisotropic, 0.0f, 1.0f);
+            changed |= ImGui::ColorEdit3("Albedo", glm::value_ptr(mat.albedoColor));
+            changed |= ImGui::SliderFloat("Roughness", &mat.roughness, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Metallic", &mat.metallic, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Emission", &mat.emission, 0.0f, 20.0f);
+            changed |= ImGui::SliderFloat("Clearcoat", &mat.clearcoat, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Coat Roughness", &mat.clearcoatRoughness, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Sheen", &mat.sheen, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Specular Weight", &mat.specularWeight, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Subsurface", &mat.subsurface, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Specular", &mat.specular, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Specular Tint", &mat.specularTint, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Anisotropic", &mat.anisotropic, 0.0f, 1.0f);
 
             ImGui::Spacing();
                         
@@ -35,21 +40,23 @@ namespace Crescendo {
             ImGui::Spacing();
             
             ImGui::TextDisabled("Transparency & Volume");
-            ImGui::SliderFloat("Transmission (Glass)", &owner->transmission, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("Transmission (Glass)", &mat.transmission, 0.0f, 1.0f);
             
             // Only show advanced volume settings if the material is actually transparent
-            if (owner->transmission > 0.0f) {
+            if (mat.transmission > 0.0f) {
                 ImGui::Indent();
-                ImGui::ColorEdit3("Volume Tint", glm::value_ptr(owner->attenuationColor));
-                ImGui::DragFloat("Density (Dist)", &owner->attenuationDistance, 0.01f, 0.001f, 10.0f);
-                ImGui::SliderFloat("Refraction (IOR)", &owner->ior, 1.0f, 2.5f); 
+                changed |= ImGui::ColorEdit3("Volume Tint", glm::value_ptr(mat.attenuationColor));
+                changed |= ImGui::DragFloat("Density (Dist)", &mat.attenuationDistance, 0.01f, 0.001f, 10.0f);
+                changed |= ImGui::SliderFloat("Refraction (IOR)", &mat.ior, 1.0f, 2.5f); 
                 ImGui::Unindent();
             }
             
             ImGui::Separator();
             ImGui::Spacing();
             
-            ImGui::SliderFloat("Normal Strength", &owner->normalStrength, 0.0f, 5.0f);
+            changed |= ImGui::SliderFloat("Normal Strength", &mat.normalStrength, 0.0f, 5.0f);
+
+            if (changed) owner->Material() = mat;
         }
     };
 }
\ No newline at end of file
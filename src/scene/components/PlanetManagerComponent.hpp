@@ -40,6 +40,8 @@ namespace Crescendo {
 
     class PlanetManagerComponent : public Component {
     public:
+        static constexpr ComponentTypeID TypeID = COMPONENT_PLANET_MANAGER;
+
         std::unique_ptr<Terrain::OctreeNode> root;
         float splitDistance = 1.5f; 
         
@@ -8,6 +8,8 @@ namespace Crescendo {
 
     class PointLightComponent : public Component {
     public:
+        static constexpr ComponentTypeID TypeID = COMPONENT_POINT_LIGHT;
+
         glm::vec3 color = glm::vec3(1.0f, 0.4f, 0.1f);
         float intensity = 25.0f;
         float radius = 15.0f;
@@ -12,6 +12,8 @@ namespace Crescendo {
 
     class ProceduralPlanetComponent : public Component {
     public:
+        static constexpr ComponentTypeID TypeID = COMPONENT_PROCEDURAL_PLANET;
+
         Terrain::VoxelSettings settings;
         int resolution = 32;
         float chunkSize = 30.0f; 
@@ -9,16 +9,20 @@ namespace Crescendo {
 
     class TransformComponent : public Component {
     public:
+        static constexpr ComponentTypeID TypeID = COMPONENT_TRANSFORM;
+
         std::string GetName() const override { return "Transform"; }
 
         void DrawInspectorUI() override {
             if (!owner) return;
             
-            // Bridge: We manipulate the owner's legacy variables directly.
-            
-            ImGui::DragFloat3("Position", glm::value_ptr(owner->origin), 0.1f);
-            ImGui::DragFloat3("Rotation", glm::value_ptr(owner->angles), 1.0f);
-            ImGui::DragFloat3("Scale",    glm::value_ptr(owner->scale), 0.1f);
+            // Edited on copies, only a drag that moved something dirties the entity
+            glm::vec3 origin = owner->Origin();
+            glm::vec3 angles = owner->Angles();
+            glm::vec3 scale = owner->Scale();
+            if (ImGui::DragFloat3("Position", glm::value_ptr(origin), 0.1f)) owner->SetOrigin(origin);
+            if (ImGui::DragFloat3("Rotation", glm::value_ptr(angles), 1.0f)) owner->SetAngles(angles);
+            if (ImGui::DragFloat3("Scale",    glm::value_ptr(scale), 0.1f))  owner->SetScale(scale);
         }
     };
 }
\ No newline at end of file
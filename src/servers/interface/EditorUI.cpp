@@ -8,6 +8,9 @@
 #include "scene/components/TransformComponent.hpp"    
 #include "scene/components/MeshRendererComponent.hpp" 
 #include "scene/components/ProceduralPlanetComponent.hpp"
+#include "scene/TransformSystem.hpp"
+#include "scene/SpatialBenchmark.hpp"
+#include "core/Profiler.hpp"
 #include "modules/terrain/TerrainManager.hpp"
 #include "modules/terrain/OctreeNode.hpp"
 #include "servers/rendering/RenderingServer.hpp"
@@ -23,6 +26,10 @@
 
 #include <streambuf>
 #include <filesystem>
+#include <algorithm>
+#include <ctime>
+#include <string_view>
+#include <utility>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 #include <vulkan/vulkan_core.h>
@@ -142,7 +149,7 @@ namespace Crescendo {
     }
 
     // --- CONSTRUCTOR / DESTRUCTOR ---
-    EditorUI::EditorUI() : rendererRef(nullptr), selectedObjectIndex(-1) {
+    EditorUI::EditorUI() : rendererRef(nullptr) {
         mCurrentGizmoOperation = ImGuizmo::TRANSLATE;
         mCurrentGizmoMode = ImGuizmo::WORLD;
     }
@@ -388,19 +395,19 @@ namespace Crescendo {
             if (ImGui::MenuItem("Empty Prop")) {
                 CBaseEntity* ent = scene->CreateEntity("prop_dynamic");
                 ent->targetName = "New Prop";
-                ent->origin = camera.Position + camera.Front * 5.0f; 
+                ent->SetOrigin(camera.Position + camera.Front * 5.0f); 
                 
                 // Auto-attach core components
                 ent->AddComponent<TransformComponent>();
                 ent->AddComponent<MeshRendererComponent>();
                 
-                selectedObjectIndex = scene->entities.size() - 1; 
+                selectedEntity = ent->handle; 
             }
 
             if (ImGui::MenuItem("Procedural Planet")) {
                 CBaseEntity* planet = scene->CreateEntity("prop_dynamic");
                 planet->targetName = "Voxel Planet";
-                planet->origin = camera.Position + (camera.Front * 5000.0f); // Push it FAR away!
+                planet->SetOrigin(camera.Position + (camera.Front * 5000.0f)); // Push it FAR away!
 
                 planet->AddComponent<TransformComponent>();
                 planet->AddComponent<MeshRendererComponent>();
@@ -454,63 +461,57 @@ namespace Crescendo {
                 CBaseEntity* ocean = scene->CreateEntity("prop_water"); 
                 ocean->targetName = "Procedural Ocean";
                 
-                // Make sure it spawns at the planet origin!
-                // (If your planet entity is named something other than 'newEnt', change it here!)
-                ocean->origin = planet->origin;
+                // Parented to the planet below, so a zero local origin keeps it centered on the core
                 
                 // Now that the ocean exists AND the mesh exists, we can link them!
                 ocean->modelIndex = waterMeshID;
                 planet->modelIndex = -1; 
-                planet->albedoColor = glm::vec3(0.2f, 0.6f, 0.3f); 
-                planet->roughness = 0.9f;
-                planet->metallic = 0.0f;
-
-                ocean->scale = glm::vec3(planetComp->settings.radius + 15.0f);     // Water level
-                ocean->albedoColor = glm::vec3(0.0f, 0.2f, 0.6f); 
-                ocean->roughness = 0.1f; 
-                ocean->transmission = 1.0f; 
+                planet->Material().albedoColor = glm::vec3(0.2f, 0.6f, 0.3f); 
+                planet->Material().roughness = 0.9f;
+                planet->Material().metallic = 0.0f;
+
+                ocean->SetScale(glm::vec3(planetComp->settings.radius + 15.0f));     // Water level
+                ocean->Material().albedoColor = glm::vec3(0.0f, 0.2f, 0.6f); 
+                ocean->Material().roughness = 0.1f; 
+                ocean->Material().transmission = 1.0f; 
                 
-                planet->children.push_back(ocean);
-                selectedObjectIndex = scene->entities.size() - 2; 
+                scene->SetParent(ocean, planet);
+                selectedEntity = planet->handle; 
             }
             
             if (ImGui::MenuItem("Point Light")) {
                 CBaseEntity* point = scene->CreateEntity("light_point");
                 point->targetName = "Point Light";
-                point->origin = camera.Position + camera.Front * 5.0f;                  // Spawn in front of you
-                point->albedoColor = glm::vec3(1.0f, 0.4f, 0.1f);               // Warm fire orange
-                point->emission = 25.0f;  // Intensity
-                point->scale.x = 15.0f;   // RADIUS: How far the light reaches!
-                selectedObjectIndex = scene->entities.size() - 1;
+                point->SetOrigin(camera.Position + camera.Front * 5.0f);                  // Spawn in front of you
+                point->Material().albedoColor = glm::vec3(1.0f, 0.4f, 0.1f);               // Warm fire orange
+                point->Material().emission = 25.0f;  // Intensity
+                point->SetScale(glm::vec3(15.0f, point->Scale().y, point->Scale().z));   // RADIUS (x): How far the light reaches!
+                selectedEntity = point->handle;
             }
             
             if (ImGui::MenuItem("Directional Light (Sun)")) {
                 CBaseEntity* sun = scene->CreateEntity("light_directional");
                 sun->targetName = "Sun Light";
-                sun->angles = glm::vec3(45.0f, -30.0f, 0.0f);
-                sun->albedoColor = glm::vec3(1.0f, 0.95f, 0.9f); // Warm sunlight
-                sun->emission = 5.0f; // Intensity
-                selectedObjectIndex = scene->entities.size() - 1;
+                sun->SetAngles(glm::vec3(45.0f, -30.0f, 0.0f));
+                sun->Material().albedoColor = glm::vec3(1.0f, 0.95f, 0.9f); // Warm sunlight
+                sun->Material().emission = 5.0f; // Intensity
+                selectedEntity = sun->handle;
             }
             
             if (ImGui::MenuItem("Atmosphere (Skybox)")) {
                 CBaseEntity* sky = scene->CreateEntity("env_sky");
                 sky->targetName = "Sky Environment";
-                selectedObjectIndex = scene->entities.size() - 1;
+                selectedEntity = sky->handle;
             }
 
             if (ImGui::MenuItem("Player Spawn Point")) {
-                size_t priorCount = scene->entities.size();
-
-                Crescendo::AssetLoader::loadModel(rendererRef, "assets/systemsymbols/playerspawner.glb", scene);
-
-                if (scene->entities.size() > priorCount) {
-                    CBaseEntity* spawner = scene->entities[priorCount];
+                CBaseEntity* spawner = Crescendo::AssetLoader::loadModel(rendererRef, "assets/systemsymbols/playerspawner.glb", scene);
 
+                if (spawner) {
                     spawner->targetName = "SpawnPoint";
-                    spawner->origin = camera.Position + camera.Front * 5.0f;
+                    spawner->SetOrigin(camera.Position + camera.Front * 5.0f);
 
-                    selectedObjectIndex = priorCount; // Auto-select in inspector
+                    selectedEntity = spawner->handle; // Auto-select in inspector
                 }
             }
 
@@ -523,7 +524,7 @@ namespace Crescendo {
                 netNode->networkPort = 7777;
                 netNode->networkIP = "127.0.0.1";
 
-                selectedObjectIndex = scene->entities.size() -1; // Auto-Select
+                selectedEntity = netNode->handle; // Auto-Select
             }
             
             ImGui::EndPopup();
@@ -584,12 +585,14 @@ namespace Crescendo {
                 ImGui::EndMenu();
             }
             if (ImGui::BeginMenu("Edit")) {
-                if (ImGui::MenuItem("Deselect All", "Esc")) { selectedObjectIndex = -1; }
+                if (ImGui::MenuItem("Deselect All", "Esc")) { selectedEntity = EntityHandle{}; }
                 ImGui::EndMenu();
             }
             if (ImGui::BeginMenu("Window")) {
                 ImGui::MenuItem("Engine Settings", NULL, &showSettingsWindow);
                 ImGui::MenuItem("Console", NULL, &showConsole);
+                ImGui::MenuItem("System Timings", NULL, &showSystemsWindow);
+                ImGui::MenuItem("Profiler", NULL, &showProfilerWindow);
                 ImGui::EndMenu();
             }
             if (ImGui::BeginMenu("Help")) {
@@ -622,8 +625,8 @@ namespace Crescendo {
             // Sweep the scene to see if our node_network is actively hosting/connected
             bool isConnected = false; 
             if (scene) {
-                for (auto* ent : scene->entities) {
-                    if (ent && ent->className == "node_network" && ent->netServer) {
+                for (auto* ent : scene->EntitiesOfClass(CLASS_NODE_NETWORK)) {
+                    if (ent->netServer) {
                         isConnected = ent->netServer->IsConnected();
                         break;
                     }
@@ -685,8 +688,10 @@ namespace Crescendo {
         ImVec2 viewportPos = ImGui::GetCursorScreenPos();
         this->lastViewportSize = glm::vec2(viewportSize.x, viewportSize.y);
 
+        bool viewportImageHovered = false;
         if (viewportDescriptor != VK_NULL_HANDLE) {
             ImGui::Image((ImTextureID)viewportDescriptor, viewportSize);
+            viewportImageHovered = ImGui::IsItemHovered();
         }
 
         // Scene manager access
@@ -702,7 +707,7 @@ namespace Crescendo {
                 if (ImGui::BeginTabItem(openScene->name.c_str(), &isOpen, flags)) {
                     if (sceneManager->GetActiveScene() != openScene) {
                         sceneManager->SetActiveScene(openScene);
-                        selectedObjectIndex = -1;
+                        selectedEntity = EntityHandle{};
                     }
                     ImGui::EndTabItem();
                 }
@@ -744,16 +749,16 @@ namespace Crescendo {
                 // Bootstrap with default lighting so we don't spawn into a black void
                 CBaseEntity* sky = newScene->CreateEntity("env_sky");
                 sky->targetName = "Procedural Sky";
-                sky->albedoColor = glm::vec3(0.5f, 0.7f, 1.0f);
+                sky->Material().albedoColor = glm::vec3(0.5f, 0.7f, 1.0f);
 
                 CBaseEntity* sun = newScene->CreateEntity("light_directional");
                 sun->targetName = "Sun Light";
-                sun->angles = glm::vec3(45.0f, -30.0f, 0.0f);
-                sun->albedoColor = glm::vec3(1.0f, 0.95f, 0.9f);
-                sun->emission = 5.0f;
+                sun->SetAngles(glm::vec3(45.0f, -30.0f, 0.0f));
+                sun->Material().albedoColor = glm::vec3(1.0f, 0.95f, 0.9f);
+                sun->Material().emission = 5.0f;
 
                 sceneManager->SetActiveScene(newScene);
-                selectedObjectIndex = -1; // Deselect the old scene's objects
+                selectedEntity = EntityHandle{}; // Deselect the old scene's objects
 
                 showNewSceneModal = false;
                 ImGui::CloseCurrentPopup();
@@ -784,29 +789,48 @@ namespace Crescendo {
             // Generate the raw OpenGL-style projection matrix
             glm::mat4 proj = glm::perspective(glm::radians(camera.fov), aspect, camera.nearClip, camera.farClip);
                 
-            if (selectedObjectIndex >= 0 && selectedObjectIndex < (int)scene->entities.size()) {
-                CBaseEntity* ent = scene->entities[selectedObjectIndex];
+            {
+                CBaseEntity* ent = scene->GetEntity(selectedEntity);
                 if (ent) {
                     
-                    glm::mat4 model = glm::mat4(1.0f);
-                    model = glm::translate(model, ent->origin);
-                    model = glm::rotate(model, glm::radians(ent->angles.z), glm::vec3(0, 0, 1));
-                    model = glm::rotate(model, glm::radians(ent->angles.y), glm::vec3(0, 1, 0));
-                    model = glm::rotate(model, glm::radians(ent->angles.x), glm::vec3(1, 0, 0));
-                    model = glm::scale(model, ent->scale);
+                    // The gizmo works in world space, the entity stores TRS local to its parent
+                    glm::mat4 parentWorld = TransformSystem::ComputeWorldMatrix(ent->moveParent);
+                    glm::mat4 model = TransformSystem::ComputeWorldMatrix(ent);
 
                     ImGuizmo::Manipulate(glm::value_ptr(view), glm::value_ptr(proj), 
                                          mCurrentGizmoOperation, mCurrentGizmoMode, glm::value_ptr(model));
 
                     if (ImGuizmo::IsUsing()) {
+                        glm::mat4 local = glm::inverse(parentWorld) * model;
+
                         float newTranslation[3], newRotation[3], newScale[3];
-                        ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(model), newTranslation, newRotation, newScale);
-                        ent->origin = glm::make_vec3(newTranslation);
-                        ent->angles = glm::make_vec3(newRotation);
-                        ent->scale  = glm::make_vec3(newScale);
+                        ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(local), newTranslation, newRotation, newScale);
+                        ent->SetOrigin(glm::make_vec3(newTranslation));
+                        ent->SetAngles(glm::make_vec3(newRotation));
+                        ent->SetScale(glm::make_vec3(newScale));
                     }
                 } 
             } 
+
+            // --- CLICK TO SELECT ---
+            // Unproject the mouse into a world ray and take the nearest bounds it hits
+            if (engineState == EngineState::Editor && viewportImageHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
+                !ImGuizmo::IsOver() && !ImGuizmo::IsUsing()) {
+                ImVec2 mouse = ImGui::GetMousePos();
+                float ndcX = ((mouse.x - viewportPos.x) / viewportSize.x) * 2.0f - 1.0f;
+                float ndcY = 1.0f - ((mouse.y - viewportPos.y) / viewportSize.y) * 2.0f;
+
+                if (ndcX >= -1.0f && ndcX <= 1.0f && ndcY >= -1.0f && ndcY <= 1.0f) {
+                    glm::mat4 invViewProj = glm::inverse(proj * view);
+                    glm::vec4 nearPoint = invViewProj * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+                    glm::vec4 farPoint  = invViewProj * glm::vec4(ndcX, ndcY,  1.0f, 1.0f);
+                    glm::vec3 rayOrigin = glm::vec3(nearPoint) / nearPoint.w;
+                    glm::vec3 rayDir = glm::normalize(glm::vec3(farPoint) / farPoint.w - rayOrigin);
+
+                    CBaseEntity* hit = scene->Raycast(rayOrigin, rayDir, camera.farClip);
+                    selectedEntity = hit ? hit->handle : EntityHandle{};
+                }
+            }
         } 
 
         // --- ADD THIS: DRAG TARGET ---
@@ -816,13 +840,12 @@ namespace Crescendo {
                 std::string ext = std::filesystem::path(path).extension().string();
             
                 if (ext == ".glb" || ext == ".gltf" || ext == ".obj") {
-                    size_t priorCount = scene->entities.size();
-                    Crescendo::AssetLoader::loadModel(rendererRef, path, scene);
+                    CBaseEntity* dropped = Crescendo::AssetLoader::loadModel(rendererRef, path, scene);
 
-                    if (scene->entities.size() > priorCount) {
-                        selectedObjectIndex = scene->entities.size() - 1;
+                    if (dropped) {
+                        selectedEntity = dropped->handle;
                         // Place it in front of the camera
-                        scene->entities[selectedObjectIndex]->origin = camera.Position + (camera.Front * 5.0f);
+                        dropped->SetOrigin(camera.Position + (camera.Front * 5.0f));
                     }
                 }
             }
@@ -847,41 +870,43 @@ namespace Crescendo {
                 if (!ent) continue;
                 ImGui::PushID((int)i);
                 std::string label = ent->targetName.empty() ? "Entity " + std::to_string(i) : ent->targetName;
-                if (ImGui::Selectable(label.c_str(), selectedObjectIndex == (int)i)) {
-                    selectedObjectIndex = (int)i;
+                if (ImGui::Selectable(label.c_str(), selectedEntity == ent->handle)) {
+                    selectedEntity = ent->handle;
                 }
 
                 // --- RIGHT-CLICK CONTEXT MENU ---
                 if (ImGui::BeginPopupContextItem()) {
-                    selectedObjectIndex = (int)i; // Auto-select the item you right-clicked
+                    selectedEntity = ent->handle; // Auto-select the item you right-clicked
                     
                     ImGui::TextDisabled("%s", label.c_str());
                     ImGui::Separator();
 
                     if (ImGui::MenuItem("Duplicate", "Ctrl+D")) {
-                        CBaseEntity* orig = scene->entities[i];
+                        CBaseEntity* orig = ent;
+                        const MaterialData origMaterial = std::as_const(*orig).Material(); // copy: CreateEntity may grow the chunk
                         CBaseEntity* clone = scene->CreateEntity(orig->className);
                         
                         clone->targetName = orig->targetName + " (Copy)";
                         clone->modelIndex = orig->modelIndex;
-                        clone->textureID  = orig->textureID;
+                        clone->Material().textureID  = origMaterial.textureID;
                         clone->assetPath  = orig->assetPath;
                         
-                        // Copy Transform
-                        clone->origin = orig->origin;
-                        clone->angles = orig->angles;
-                        clone->scale  = orig->scale;
+                        // Copy Transform (local, so the clone shares the original's parent)
+                        scene->SetParent(clone, orig->moveParent);
+                        clone->SetOrigin(orig->Origin());
+                        clone->SetAngles(orig->Angles());
+                        clone->SetScale(orig->Scale());
                         
                         // Copy PBR Material Data
-                        clone->albedoColor = orig->albedoColor;
-                        clone->emission    = orig->emission;
-                        clone->roughness   = orig->roughness;
-                        clone->metallic    = orig->metallic;
-                        clone->transmission = orig->transmission;
-                        clone->ior         = orig->ior;
-                        clone->attenuationColor = orig->attenuationColor;
-                        clone->attenuationDistance = orig->attenuationDistance;
-                        clone->normalStrength = orig->normalStrength;
+                        clone->Material().albedoColor = origMaterial.albedoColor;
+                        clone->Material().emission    = origMaterial.emission;
+                        clone->Material().roughness   = origMaterial.roughness;
+                        clone->Material().metallic    = origMaterial.metallic;
+                        clone->Material().transmission = origMaterial.transmission;
+                        clone->Material().ior         = origMaterial.ior;
+                        clone->Material().attenuationColor = origMaterial.attenuationColor;
+                        clone->Material().attenuationDistance = origMaterial.attenuationDistance;
+                        clone->Material().normalStrength = origMaterial.normalStrength;
 
                         // Re-attach Bridge Components
                         if (orig->HasComponent<TransformComponent>()) clone->AddComponent<TransformComponent>();
@@ -889,16 +914,17 @@ namespace Crescendo {
                         if (orig->HasComponent<PointLightComponent>()) clone->AddComponent<PointLightComponent>();
                         
                         // Select the newly duplicated item
-                        selectedObjectIndex = clone->index; 
+                        selectedEntity = clone->handle; 
                     }
                     
                     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.4f, 0.4f, 1.0f)); // Red text
                     if (ImGui::MenuItem("Delete", "Del")) {
                         
-                        scene->DeleteEntity(i); // Call our new safe delete!
+                        // O(1): the slot is freed in place, so this loop's indices stay valid
+                        scene->DeleteEntity(ent->handle);
                         
                         // Reset selection so the Inspector doesn't try to draw a deleted object
-                        selectedObjectIndex = -1; 
+                        selectedEntity = EntityHandle{}; 
                     }
                     ImGui::PopStyleColor();
 
@@ -913,8 +939,8 @@ namespace Crescendo {
         // --- THE NEW COMPONENT-STYLE INSPECTOR ---
         ImGui::Begin("Inspector");
         
-        if (selectedObjectIndex >= 0 && scene && selectedObjectIndex < (int)scene->entities.size()) {
-            CBaseEntity* ent = scene->entities[selectedObjectIndex];
+        if (scene) {
+            CBaseEntity* ent = scene->GetEntity(selectedEntity);
             if (ent) {
                 // --- 1. ENTITY HEADER ---
                 bool active = true; 
@@ -938,7 +964,7 @@ namespace Crescendo {
                 // 1. THE NETWORK MANAGER UI
                 // =========================================================
 
-                if (ent->className == "node_network") {
+                if (ent->classID == CLASS_NODE_NETWORK) {
                     ImGui::Text("Network Manager Settings");
 
                     ImGui::Checkbox("Host Server", &ent->isHost);
@@ -978,26 +1004,35 @@ namespace Crescendo {
                 // =========================================================
                 else {
                     ImGui::Text("Multiplayer Synchronization");
-                    ImGui::Checkbox("Sync Transform over Network", &ent->syncTransform);
+                    // The network link only exists once replication is switched on
+                    NetworkLink* net = ent->GetNetworkLink();
+                    bool syncTransform = net && net->syncTransform;
 
-                    if (ent->syncTransform) {
+                    if (ImGui::Checkbox("Sync Transform over Network", &syncTransform)) {
+                        net = &ent->EnableNetworkLink();
+                        net->syncTransform = syncTransform;
+                    }
+
+                    if (net && net->syncTransform) {
                         // Cast to int for ImGui, but ensure it stays positive for the uint32_t
-                        int tempNetID = static_cast<int>(ent->networkID);
+                        int tempNetID = static_cast<int>(net->networkID);
                         
                         if (ImGui::InputInt("Network ID", &tempNetID)) {
-                            // YOU ARE MISSING THIS LINE:
-                            ent->networkID = static_cast<uint32_t>(std::max(0, tempNetID));
+                            // Refused (and logged) when another entity already has it
+                            ent->SetNetworkID(static_cast<uint32_t>(std::max(0, tempNetID)));
                         }
                         
-                        ImGui::TextDisabled("Note: Network ID must match on both clients.");
+                        if (net->networkID == 0) ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Unassigned: name the entity or pick an ID.");
+                        else ImGui::TextDisabled("Note: Network ID must match on both clients.");
                     }
                 }
 
                 // --- 3. DYNAMIC COMPONENTS ---
-                for (auto& comp : ent->components) {
+                for (uint32_t c = 0; c < ent->componentCount; c++) {
+                    Component* comp = ent->components[c];
                     if (comp->GetName() == "Procedural Planet") continue;
                     
-                    ImGui::PushID(comp.get());
+                    ImGui::PushID(comp);
                     ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.2f, 0.2f, 0.22f, 1.0f));
                     
                     if (ImGui::CollapsingHeader(comp->GetName().c_str(), ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed)) {
@@ -1010,7 +1045,7 @@ namespace Crescendo {
                 }
                 
                 // Atmosphere & Skybox
-                if (ent->className == "env_sky") {
+                if (ent->classID == CLASS_ENV_SKY) {
                     ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.2f, 0.2f, 0.22f, 1.0f));
                     if (ImGui::CollapsingHeader("Atmosphere (Skybox)", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed)) {
                         const char* skyTypeNames[] = { "Solid Color", "Procedural", "HDR Map" };
@@ -1020,14 +1055,18 @@ namespace Crescendo {
                             scene->environment.skyType = static_cast<SkyType>(currentSkyType);
                         }
 
+                        // Edited on a copy, written back only when a widget changed it
+                        MaterialData skyMaterial = std::as_const(*ent).Material();
+                        bool skyChanged = false;
                         if (scene->environment.skyType == SkyType::SolidColor) {
-                            ImGui::ColorEdit3("Background Color", glm::value_ptr(ent->albedoColor));
+                            skyChanged |= ImGui::ColorEdit3("Background Color", glm::value_ptr(skyMaterial.albedoColor));
                         }
                         else if (scene->environment.skyType == SkyType::Procedural) {
-                            ImGui::ColorEdit3("Zenith Color", glm::value_ptr(ent->albedoColor));
-                            ImGui::ColorEdit3("Horizon Color", glm::value_ptr(ent->attenuationColor));
-                            ImGui::SliderFloat("Sun Intensity", &ent->emission, 0.0f, 10.0f);
+                            skyChanged |= ImGui::ColorEdit3("Zenith Color", glm::value_ptr(skyMaterial.albedoColor));
+                            skyChanged |= ImGui::ColorEdit3("Horizon Color", glm::value_ptr(skyMaterial.attenuationColor));
+                            skyChanged |= ImGui::SliderFloat("Sun Intensity", &skyMaterial.emission, 0.0f, 10.0f);
                         }
+                        if (skyChanged) ent->Material() = skyMaterial;
                         else if (scene->environment.skyType == SkyType::HDRMap) {
                             if (ImGui::Button("Load New HDR...")) {
                                 auto selection = pfd::open_file("Select HDR", ".", std::vector<std::string>{"HDR Files", "*.hdr"}).result();
@@ -1052,7 +1091,7 @@ namespace Crescendo {
                 }
 
                 // --- 4. LEGACY COMPONENTS (To be refactored) ---
-                if (ent->className == "env_sound") {
+                if (ent->classID == CLASS_ENV_SOUND) {
                     ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.2f, 0.2f, 0.22f, 1.0f));
                     if (ImGui::CollapsingHeader("Audio Source", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed)) {
                         char audioBuf[256];
@@ -1063,7 +1102,8 @@ namespace Crescendo {
                         if (ImGui::InputText("##AudioPath", audioBuf, sizeof(audioBuf))) {
                             ent->assetPath = audioBuf;
                         }
-                        ImGui::SliderFloat("Volume", &ent->emission, 0.0f, 5.0f);
+                        float volume = std::as_const(*ent).Material().emission;
+                        if (ImGui::SliderFloat("Volume", &volume, 0.0f, 5.0f)) ent->Material().emission = volume;
                         ImGui::Spacing();
                     }
                     ImGui::PopStyleColor();
@@ -1128,8 +1168,7 @@ namespace Crescendo {
                 }
 
                 // ATMO TWEAKS
-                if (selectedObjectIndex >= 0 && selectedObjectIndex < scene->entities.size()) {
-                    CBaseEntity* entity = scene->entities[selectedObjectIndex];
+                if (CBaseEntity* entity = scene->GetEntity(selectedEntity)) {
 
                     // ... (Transform UI, MeshRenderer UI) ...
                 
@@ -1170,9 +1209,9 @@ namespace Crescendo {
                         ent->AddComponent<MeshRendererComponent>();
                     }
                     
-                    if (ImGui::MenuItem("Audio Source", nullptr, false, ent->className != "env_sound")) {
-                        ent->className = "env_sound";
-                        ent->emission = 1.0f;
+                    if (ImGui::MenuItem("Audio Source", nullptr, false, ent->classID != CLASS_ENV_SOUND)) {
+                        scene->SetEntityClass(ent, "env_sound");
+                        ent->Material().emission = 1.0f;
                         ent->assetPath = "assets/audio/default.wav";
                     }
 
@@ -1336,6 +1375,22 @@ namespace Crescendo {
                     ImGui::Checkbox("Half-Resolution SSR", &rendererRef->renderSettings.halfResSSR);
                     ImGui::Unindent();
                 }
+
+                ImGui::Separator();
+
+                ImGui::Checkbox("Frustum Culling", &rendererRef->renderSettings.frustumCulling);
+
+                // Opaque, shadow and outline draws culled by a compute pass and drawn indirect
+                ImGui::BeginDisabled(!rendererRef->gpuCullingSupported);
+                ImGui::Checkbox("GPU Culling", &rendererRef->renderSettings.gpuCulling);
+                ImGui::EndDisabled();
+                if (!rendererRef->gpuCullingSupported) {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(not supported by this device)");
+                }
+
+                // Still casters stay in cached cascade layers, off redraws every caster every frame
+                ImGui::Checkbox("Cached Shadows", &rendererRef->renderSettings.shadowCache);
             }
 
             // --- ENGINE GRAPHICS SETTINGS ---
@@ -1369,6 +1424,14 @@ namespace Crescendo {
             ImGui::End();
         }
 
+        // --- SYSTEM TIMINGS WINDOW ---
+        // Per-system CPU time from the scheduler, so you can see which update stage eats the frame.
+        // scene is the one Engine::Update ticks (handed down through buildPacket), not a scene tab.
+        if (showSystemsWindow) DrawSystemTimingsWindow(*scene);
+
+        // --- PROFILER WINDOW ---
+        if (showProfilerWindow) DrawProfilerWindow();
+
         // --- ABOUT WINDOW ---
         if (showAboutWindow) {
             ImGui::Begin("About", &showAboutWindow, ImGuiWindowFlags_AlwaysAutoResize);
@@ -1455,6 +1518,8 @@ namespace Crescendo {
                         // No space, meaning they are checking a value or running a single command
                         if (command == "clear") {
                             consoleLog.clear();
+                        } else if (command == "bench_spatial") {
+                            RunSpatialBenchmark();
                         } else if (floatConVars.find(command) != floatConVars.end()) {
                             // Print current value
                             AddLog(command + " = " + std::to_string(*floatConVars[command]), ImVec4(0.8f, 0.8f, 0.8f, 1.0f));
@@ -1475,16 +1540,308 @@ namespace Crescendo {
         } // Closes if (showConsole)
 
         ImGui::Render(); 
+
+        // The render thread only gets a copy of the draw lists, so font atlas uploads happen here
+        ImDrawData* drawData = ImGui::GetDrawData();
+        if (drawData && drawData->Textures) {
+            std::lock_guard<std::mutex> lock(rendererRef->queueMutex);
+            for (ImTextureData* tex : *drawData->Textures) {
+                if (tex->Status != ImTextureStatus_OK) ImGui_ImplVulkan_UpdateTexture(tex);
+            }
+        }
     } // Closes EditorUI::Prepare()
     
-    void EditorUI::Render(VkCommandBuffer cmd) {
-        ImDrawData* draw_data = ImGui::GetDrawData();
-        if (draw_data) {
-            ImGui_ImplVulkan_RenderDrawData(draw_data, cmd);
+    void EditorUI::Render(VkCommandBuffer cmd, ImDrawData* drawData) {
+        if (drawData) {
+            ImGui_ImplVulkan_RenderDrawData(drawData, cmd);
         }
     }
 
     void EditorUI::HandleInput(SDL_Event& event) {
         ImGui_ImplSDL2_ProcessEvent(&event);
     }
+
+    // =========================================================
+    // SYSTEM TIMINGS WINDOW
+    // The scheduler Engine::RegisterSystems filled, plus the
+    // renderer's per-frame culling, draw and upload counters.
+    // =========================================================
+    void EditorUI::DrawSystemTimingsWindow(const Scene& simulation) {
+        ImGui::Begin("System Timings", &showSystemsWindow);
+        ImGui::Text("Frame: %.2f ms (%.0f FPS)", simulation.time.frameMs, simulation.time.frameMs > 0.0 ? 1000.0 / simulation.time.frameMs : 0.0);
+        ImGui::Text("Tick: %.3f ms at %.0f Hz, %u this frame", simulation.time.tickMs, simulation.time.tickRate, simulation.time.ticksLastFrame);
+        ImGui::Text("Update: %.3f ms over %zu stages", simulation.systems.LastFrameMs(), simulation.systems.StageCount());
+        if (simulation.systems.Timings().empty()) ImGui::TextDisabled("No systems registered on this scene.");
+
+        SceneAllocationStats alloc = simulation.AllocationStats();
+        ImGui::TextDisabled("Pools: %zu entity blocks, %zu component blocks, %zu chunks (%zu heap calls total)",
+            alloc.entities.blocks, alloc.components.blocks, alloc.chunkAllocations, alloc.HeapAllocations());
+        ImGui::Separator();
+
+        if (ImGui::BeginTable("SystemTimingTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+            ImGui::TableSetupColumn("System");
+            ImGui::TableSetupColumn("Stage");
+            ImGui::TableSetupColumn("Items");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableHeadersRow();
+
+            for (const SystemTiming& timing : simulation.systems.Timings()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(timing.name.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%u", timing.stage);
+                ImGui::TableNextColumn(); ImGui::Text("%zu", timing.items);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", timing.avgMs);
+            }
+            ImGui::EndTable();
+        }
+
+        // Objects each view was offered and kept, from the last packet built
+        const CullStats& cull = rendererRef->cullStats;
+        ImGui::Separator();
+        ImGui::Text("Culling: %.3f ms%s%s", cull.cullMs, rendererRef->renderSettings.frustumCulling ? "" : " (off)",
+                    cull.gpu ? ", opaque on the GPU (drawn a frame late)" : "");
+        if (ImGui::BeginTable("CullStatsTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+            ImGui::TableSetupColumn("View");
+            ImGui::TableSetupColumn("Tested");
+            ImGui::TableSetupColumn("Drawn");
+            ImGui::TableSetupColumn("Culled");
+            ImGui::TableHeadersRow();
+
+            auto cullRow = [](const char* view, const ViewCullStats& stats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(view);
+                ImGui::TableNextColumn(); ImGui::Text("%u", stats.tested);
+                ImGui::TableNextColumn(); ImGui::Text("%u", stats.drawn);
+                ImGui::TableNextColumn(); ImGui::Text("%u", stats.Culled());
+            };
+            cullRow("Camera", cull.camera);
+            const char* cascadeNames[] = { "Cascade 0", "Cascade 1", "Cascade 2", "Cascade 3" };
+            for (int c = 0; c < 4; c++) cullRow(cascadeNames[c], cull.cascades[c]);
+            ImGui::EndTable();
+        }
+
+        // Entities sharing a mesh are drawn as one instanced call per pass
+        const DrawCallStats& draws = rendererRef->drawStats;
+        ImGui::Text("Draw calls: %u for %u items", draws.drawCalls, draws.items);
+        if (draws.indirectDraws > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(+%u indirect)", draws.indirectDraws);
+        }
+        ImGui::TextDisabled("Key sort: %.3f ms", draws.sortMs);
+
+        // Binds that reached the command buffer after the redundant ones were skipped
+        if (ImGui::BeginTable("StateChangeTable", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("Pipelines");
+            ImGui::TableSetupColumn("Sets");
+            ImGui::TableSetupColumn("Geometry");
+            ImGui::TableSetupColumn("Draws");
+            ImGui::TableHeadersRow();
+
+            const char* passNames[STATE_PASS_COUNT] = { "Shadow", "Opaque", "Transparent", "Water", "Outline" };
+            for (uint32_t p = 0; p < STATE_PASS_COUNT; p++) {
+                const PassStateStats& pass = draws.passes[p];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(passNames[p]);
+                ImGui::TableNextColumn(); ImGui::Text("%u", pass.pipelines);
+                ImGui::TableNextColumn(); ImGui::Text("%u", pass.descriptorSets);
+                ImGui::TableNextColumn(); ImGui::Text("%u", pass.geometry);
+                ImGui::TableNextColumn(); ImGui::Text("%u", pass.draws);
+            }
+            ImGui::EndTable();
+        }
+
+        // Point lights binned into the froxel grid, a fragment shades at most the busiest cluster's count
+        const LightClusterStats& lights = rendererRef->lightStats;
+        ImGui::Separator();
+        ImGui::Text("Point lights: %u visible of %u, binned in %.3f ms%s", lights.visible, lights.lights, lights.binMs,
+                    lights.truncated ? " (capped)" : "");
+        ImGui::TextDisabled("%u cluster entries, busiest cluster %u lights", lights.indices, lights.busiestCluster);
+
+        // Static casters are only drawn when a cascade's cached layer is redrawn
+        const ShadowCacheStats& shadows = rendererRef->shadowStats;
+        ImGui::Text("Shadow casters: %u static, %u dynamic", shadows.staticCasters, shadows.dynamicCasters);
+        ImGui::TextDisabled("Layers redrawn: %u (%u refit, %llu total), composited: %u", shadows.rebuilt, shadows.refit,
+                            static_cast<unsigned long long>(shadows.totalRebuilds), shadows.composited);
+
+        // Every mesh lives in the shared geometry pages, holes are left by released meshes
+        GeometryArenaStats geometry = rendererRef->geometryStats();
+        ImGui::Separator();
+        ImGui::Text("Geometry: %u meshes in %u pages, vertices %.1f / %.1f MB, indices %.1f / %.1f MB",
+                    geometry.allocations, geometry.pages,
+                    geometry.vertexBytesUsed / 1048576.0, geometry.vertexBytes / 1048576.0,
+                    geometry.indexBytesUsed / 1048576.0, geometry.indexBytes / 1048576.0);
+        ImGui::TextDisabled("%zu free ranges", geometry.freeRanges);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Compact")) rendererRef->compactGeometry();
+
+        UploadStats uploads = rendererRef->uploadStats();
+        ImGui::Text("Uploads: %llu (%.1f MB) in %llu batches, %s", static_cast<unsigned long long>(uploads.uploads),
+                    uploads.bytes / 1048576.0, static_cast<unsigned long long>(uploads.batches),
+                    uploads.dedicatedQueue ? "transfer queue" : "graphics queue");
+        ImGui::TextDisabled("Ring %.1f / %.1f MB in flight, %llu stalls, %llu oversized", uploads.ringBytesInFlight / 1048576.0,
+                            uploads.ringBytes / 1048576.0, static_cast<unsigned long long>(uploads.ringStalls),
+                            static_cast<unsigned long long>(uploads.oversized));
+        ImGui::End();
+    }
+
+    // =========================================================
+    // PROFILER WINDOW
+    // Frame times on top: click a bar (or Worst Frame) to inspect it,
+    // which also pauses recording so the spike stays in the rings.
+    // Below, the selected frame's markers, one lane per thread and
+    // one row per nesting level.
+    // =========================================================
+    void EditorUI::DrawProfilerWindow() {
+        Profiler& profiler = Profiler::Get();
+
+        ImGui::SetNextWindowSize(ImVec2(900, 420), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Profiler", &showProfilerWindow)) {
+            ImGui::End();
+            return;
+        }
+
+        bool recording = profiler.IsRecording();
+        if (ImGui::Button(recording ? "Pause" : "Resume")) {
+            profiler.SetRecording(!recording);
+            if (!recording) profilerFrame = -1; // Back to following the latest frame
+        }
+
+        std::vector<ProfileFrame> frames = profiler.Frames();
+        if (profilerFrame >= static_cast<int>(frames.size())) profilerFrame = -1;
+
+        int worst = 0;
+        double worstMs = 0.0;
+        for (size_t i = 0; i < frames.size(); i++) {
+            double ms = (frames[i].end - frames[i].start) / 1.0e6;
+            if (ms > worstMs) { worstMs = ms; worst = static_cast<int>(i); }
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Worst Frame") && !frames.empty()) {
+            profiler.SetRecording(false);
+            profilerFrame = worst;
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome Trace")) {
+            std::filesystem::create_directories("profiles");
+            std::string path = "profiles/trace_" + std::to_string(std::time(nullptr)) + ".json";
+            if (profiler.ExportChromeTrace(path)) lastTraceExport = path;
+        }
+        if (!lastTraceExport.empty()) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%s", lastTraceExport.c_str());
+        }
+
+        if (frames.empty()) {
+            ImGui::TextDisabled("No frames captured yet.");
+            ImGui::End();
+            return;
+        }
+
+        int selected = profilerFrame < 0 ? static_cast<int>(frames.size()) - 1 : profilerFrame;
+        ImDrawList* draw = ImGui::GetWindowDrawList();
+
+        // --- FRAME HISTORY ---
+        {
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImVec2 size(ImGui::GetContentRegionAvail().x, 60.0f);
+            ImGui::InvisibleButton("##ProfilerFrames", size);
+
+            double scaleMs = std::max(worstMs, 33.3);
+            float barWidth = size.x / frames.size();
+            draw->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(20, 20, 20, 255));
+
+            for (size_t i = 0; i < frames.size(); i++) {
+                double ms = (frames[i].end - frames[i].start) / 1.0e6;
+                float height = static_cast<float>(ms / scaleMs) * size.y;
+                ImU32 color = ms > 33.3 ? IM_COL32(220, 70, 60, 255) : ms > 16.7 ? IM_COL32(230, 180, 60, 255) : IM_COL32(90, 180, 90, 255);
+                if (static_cast<int>(i) == selected) color = IM_COL32(255, 255, 255, 255);
+
+                float x = origin.x + i * barWidth;
+                draw->AddRectFilled(ImVec2(x, origin.y + size.y - height), ImVec2(x + std::max(barWidth - 1.0f, 1.0f), origin.y + size.y), color);
+            }
+
+            // 60 FPS budget
+            float budgetY = origin.y + size.y - static_cast<float>(16.7 / scaleMs) * size.y;
+            draw->AddLine(ImVec2(origin.x, budgetY), ImVec2(origin.x + size.x, budgetY), IM_COL32(255, 255, 255, 60));
+
+            if (ImGui::IsItemHovered()) {
+                int hovered = std::clamp(static_cast<int>((ImGui::GetIO().MousePos.x - origin.x) / barWidth), 0, static_cast<int>(frames.size()) - 1);
+                ImGui::SetTooltip("%.3f ms", (frames[hovered].end - frames[hovered].start) / 1.0e6);
+                if (ImGui::IsItemClicked()) {
+                    profiler.SetRecording(false);
+                    profilerFrame = hovered;
+                    selected = hovered;
+                }
+            }
+        }
+
+        // --- TIMELINE ---
+        const ProfileFrame& frame = frames[selected];
+        double frameNs = static_cast<double>(std::max<uint64_t>(frame.end - frame.start, 1));
+
+        ImGui::Text("Frame %d of %zu: %.3f ms", selected + 1, frames.size(), frameNs / 1.0e6);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderFloat("Zoom", &profilerZoom, 1.0f, 50.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+
+        std::vector<ProfileThreadCapture> threads = profiler.Capture(frame.start, frame.end);
+
+        ImGui::BeginChild("##ProfilerTimeline", ImVec2(0, 0), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+        {
+            ImDrawList* lanes = ImGui::GetWindowDrawList();
+            const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+            const float labelWidth = 110.0f;
+            const float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 100.0f) * profilerZoom;
+
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImVec2 mouse = ImGui::GetIO().MousePos;
+            bool timelineHovered = ImGui::IsWindowHovered();
+            float y = origin.y;
+
+            for (const ProfileThreadCapture& thread : threads) {
+                if (thread.events.empty()) continue;
+
+                uint32_t maxDepth = 0;
+                for (const ProfileEvent& event : thread.events) maxDepth = std::max(maxDepth, event.depth);
+
+                lanes->AddText(ImVec2(origin.x, y + 2.0f), IM_COL32(200, 200, 200, 255), thread.name.c_str());
+
+                for (const ProfileEvent& event : thread.events) {
+                    double begin = static_cast<double>(std::max(event.start, frame.start) - frame.start);
+                    double end = static_cast<double>(std::min(event.end, frame.end) - frame.start);
+
+                    float x0 = origin.x + labelWidth + static_cast<float>(begin / frameNs) * width;
+                    float x1 = std::max(origin.x + labelWidth + static_cast<float>(end / frameNs) * width, x0 + 1.0f);
+                    float top = y + event.depth * rowHeight;
+                    ImVec2 min(x0, top), max(x1, top + rowHeight - 1.0f);
+
+                    // Same name, same color, across frames and threads
+                    size_t hash = std::hash<std::string_view>{}(event.name);
+                    ImU32 color = ImColor::HSV((hash % 360) / 360.0f, 0.45f, 0.8f);
+                    lanes->AddRectFilled(min, max, color);
+
+                    if (x1 - x0 > 24.0f) {
+                        lanes->PushClipRect(min, max, true);
+                        lanes->AddText(ImVec2(x0 + 3.0f, top + 2.0f), IM_COL32(15, 15, 15, 255), event.name);
+                        lanes->PopClipRect();
+                    }
+
+                    if (timelineHovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+                        ImGui::SetTooltip("%s\n%.3f ms (at +%.3f ms)\n%s", event.name, (event.end - event.start) / 1.0e6, begin / 1.0e6, thread.name.c_str());
+                    }
+                }
+
+                y += (maxDepth + 1) * rowHeight + 6.0f;
+                lanes->AddLine(ImVec2(origin.x, y - 3.0f), ImVec2(origin.x + labelWidth + width, y - 3.0f), IM_COL32(255, 255, 255, 30));
+            }
+
+            ImGui::Dummy(ImVec2(labelWidth + width, std::max(y - origin.y, 1.0f)));
+        }
+        ImGui::EndChild();
+
+        ImGui::End();
+    }
 }
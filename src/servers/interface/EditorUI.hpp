@@ -59,7 +59,7 @@ namespace Crescendo {
         void Shutdown(VkDevice device);
 
         void Prepare(Scene* scene, SceneManager* sceneManager, Camera& camera, VkDescriptorSet viewportDescriptor, EngineState& engineState);
-        void Render(VkCommandBuffer cmd);
+        void Render(VkCommandBuffer cmd, ImDrawData* drawData);   // The frame's copy from its render packet
         
         void HandleInput(SDL_Event& event);
 
@@ -67,7 +67,7 @@ namespace Crescendo {
         glm::vec2 GetViewportSize() const { return lastViewportSize; }
         Console& Getconsole() { return gameConsole; }
 
-        int GetSelectedObjectIndex() const { return selectedObjectIndex; }
+        EntityHandle GetSelectedEntity() const { return selectedEntity; }
         bool GetShowSelectionOutline() const { return showSelectionOutline; }
 
         // Managers
@@ -97,6 +97,8 @@ namespace Crescendo {
         bool showSettingsWindow = false;
         bool showAboutWindow = false;
         bool showConsole = true;
+        bool showSystemsWindow = false;
+        bool showProfilerWindow = false;
         bool showSelection = true;
         bool showSelectionOutline = true;
         // Asset Browser State
@@ -106,15 +108,26 @@ namespace Crescendo {
         Console gameConsole;
         glm::vec2 lastViewportSize = {1280.0f, 720.0f};
 
+        // Profiler State
+        int profilerFrame = -1;            // Index into the frame history, -1 follows the latest
+        float profilerZoom = 1.0f;
+        std::string lastTraceExport;
+
         // Gizmo State
         ImGuizmo::OPERATION mCurrentGizmoOperation = ImGuizmo::TRANSLATE;
         ImGuizmo::MODE mCurrentGizmoMode = ImGuizmo::WORLD;
         
         // Selection & Cursor
-        int selectedObjectIndex = -1; 
+        EntityHandle selectedEntity;       // Resolves to nullptr once the entity is deleted
         glm::vec3 cursor3DPosition = glm::vec3(0.0f);
 
         // Themes
         void SetCrescendoEditorStyle();
+
+        // Per-system update cost of the scene the engine ticks, and renderer stats
+        void DrawSystemTimingsWindow(const Scene& simulation);
+
+        // CPU timeline of one captured frame, every thread
+        void DrawProfilerWindow();
     };
 }
\ No newline at end of file
@@ -4,7 +4,8 @@
 
 namespace Crescendo {
 
-    bool SymbolServer::Initialize(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout textureSetLayout) {
+    bool SymbolServer::Initialize(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout textureSetLayout,
+                                  VkPipelineCache pipelineCache) {
         
         // 1. PUSH CONSTANTS
         VkPushConstantRange pushConstantRange{};
@@ -130,7 +131,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = renderPass;
         pipelineInfo.subpass = 0; // Adjust if your engine uses multiple subpasses!
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
             std::cerr << "[SymbolServer] Failed to create graphics pipeline!" << std::endl;
             return false;
         }
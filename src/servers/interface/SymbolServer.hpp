@@ -25,7 +25,8 @@ namespace Crescendo {
         ~SymbolServer() = default;
 
         // Must have all 4 arguments!
-        bool Initialize(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout textureSetLayout);
+        bool Initialize(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout textureSetLayout,
+                        VkPipelineCache pipelineCache = VK_NULL_HANDLE);
 
         void Cleanup(VkDevice device);
         void SubmitSymbol(const glm::vec3& position, float scale = 1.0f);
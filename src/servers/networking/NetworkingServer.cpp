@@ -1,5 +1,6 @@
 #include <iostream>
 #include "servers/networking/NetworkingServer.hpp"
+#include "core/Profiler.hpp"
 #include <enet/enet.h>
 
 namespace Crescendo {
@@ -51,8 +52,9 @@ namespace Crescendo {
         return true;
     }
 
-    void NetworkingServer::Poll(std::vector<CBaseEntity*>& entities) {
+    void NetworkingServer::Poll(EntityStorage& storage) {
         if (!host) return;
+        PROFILE_SCOPE("NetworkingServer::Poll");
 
         ENetEvent event;
         while (enet_host_service(host, &event, 0) > 0) {
@@ -63,16 +65,25 @@ namespace Crescendo {
                 case ENET_EVENT_TYPE_RECEIVE:
                     if (event.packet->dataLength == sizeof(TransformPacket)) {
                         TransformPacket* packet = (TransformPacket*)event.packet->data;
+                        if (packet->networkID == 0) {
+                            enet_packet_destroy(event.packet);
+                            break;
+                        }
                         
                         // Find the entity with the matching Network ID and apply the transform!
-                        for (auto* ent : entities) {
-                            if (ent->syncTransform && ent->networkID == packet->networkID) {
-                                ent->origin = packet->position;
-                                // Convert incoming radians back to degrees for the engine/inspector
-                                ent->angles = glm::degrees(packet->rotation); 
-                                break;
+                        // Only archetypes that carry a network link are scanned.
+                        bool applied = false;
+                        storage.ForEachChunk(GROUP_TRANSFORM | GROUP_NETWORK, [&](EntityChunk& chunk) {
+                            for (uint32_t i = 0; i < chunk.count && !applied; i++) {
+                                if (chunk.network[i].syncTransform && chunk.network[i].networkID == packet->networkID) {
+                                    chunk.origin[i] = packet->position;
+                                    // Convert incoming radians back to degrees for the engine/inspector
+                                    chunk.angles[i] = glm::degrees(packet->rotation); 
+                                    chunk.dirty[i] = 1;
+                                    applied = true;
+                                }
                             }
-                        }
+                        });
                     }
                     enet_packet_destroy(event.packet);
                     break;
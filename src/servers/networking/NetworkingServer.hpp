@@ -3,6 +3,7 @@
 #include <enet/enet.h>
 #include <glm/glm.hpp>
 #include "scene/BaseEntity.hpp"
+#include "scene/EntityStorage.hpp"
 #include <string>
 
 class CBaseEntity;
@@ -30,7 +31,7 @@ namespace Crescendo {
         ~NetworkingServer();
 
         bool Initialize(bool asServer, int port = 7777, const std::string& address = "127.0.0.1");
-        void Poll(std::vector<CBaseEntity*>& entities);
+        void Poll(EntityStorage& storage);
         void Shutdown();
         void BroadcastTransform(uint32_t netID, const glm::vec3& pos, const glm::vec3& rot);
 
@@ -0,0 +1,66 @@
+#pragma once
+#include <thread>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // JOLT JOB ADAPTER
+    // Jolt's job graph on top of the engine's workers instead of a
+    // private JobSystemThreadPool. Jobs live in a fixed free list the
+    // way Jolt's own pool keeps them; once a job's dependencies are
+    // met it is handed to the engine as a High priority job.
+    // =========================================================
+
+    class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+    public:
+        JoltJobSystem(Crescendo::JobSystem& jobs, JPH::uint maxJobs, JPH::uint maxBarriers) : JobSystemWithBarrier(maxBarriers), engineJobs(jobs) {
+            freeJobs.Init(maxJobs, maxJobs);
+        }
+
+        int GetMaxConcurrency() const override { return static_cast<int>(engineJobs.WorkerCount()) + 1; }
+
+        JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override {
+            // Same back-off as JobSystemThreadPool when the list is exhausted
+            JPH::uint32 index;
+            for (;;) {
+                index = freeJobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+                if (index != decltype(freeJobs)::cInvalidObjectIndex) break;
+                std::this_thread::yield();
+            }
+
+            Job* job = &freeJobs.Get(index);
+            JobHandle handle(job);
+            if (inNumDependencies == 0) QueueJob(job);
+            return handle;
+        }
+
+    protected:
+        void QueueJob(Job* inJob) override {
+            inJob->AddRef();    // Released once it has run, the free list reclaims it
+            engineJobs.Submit([inJob]() {
+                PROFILE_SCOPE("Jolt Job");
+                inJob->Execute();
+                inJob->Release();
+            }, JobPriority::High);
+        }
+
+        void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override {
+            for (JPH::uint i = 0; i < inNumJobs; i++) QueueJob(inJobs[i]);
+        }
+
+        void FreeJob(Job* inJob) override {
+            freeJobs.DestructObject(inJob);
+        }
+
+    private:
+        Crescendo::JobSystem& engineJobs;    // Unqualified JobSystem is Jolt's base class in here
+        JPH::FixedSizeFreeList<Job> freeJobs;
+    };
+}
@@ -19,12 +19,14 @@
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include "servers/physics/JoltJobSystem.hpp"
+#include "core/Profiler.hpp"
 
 // 3. All other Jolt Headers go AFTER Jolt.h
 #include <Jolt/Math/Float3.h> // <--- Moved down!
 #include <Jolt/Geometry/Triangle.h> // <--- Added to fix 'VertexList'
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorderImpl.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h> 
@@ -105,7 +107,10 @@ class PhysicsServer {
 public:
     PhysicsSystem* physicsSystem = nullptr;
     TempAllocatorImpl* tempAllocator = nullptr;
-    JobSystemThreadPool* jobSystem = nullptr;
+    JoltJobSystem* jobSystem = nullptr;     // Runs on the engine's shared workers
+
+    StateRecorderImpl savedState;   // Play mode snapshot, see SaveState
+    bool hasSavedState = false;
     
     BPLayerInterfaceImpl broad_phase_layer_interface;
     ObjectVsBroadPhaseLayerFilterImpl object_vs_broadphase_layer_filter;
@@ -167,7 +172,7 @@ public:
     }
 
     BodyInterface* bodyInterface = nullptr;
-    std::unordered_map<int, BodyID> entityBodyMap;
+    std::unordered_map<EntityHandle, BodyID> entityBodyMap;     // Keyed by handle so deleted/reused slots never alias
 
     void Initialize() {
         std::cout << "[Physics] Initializing Jolt (Z-Up Mode)..." << std::endl;
@@ -177,8 +182,8 @@ public:
 
         tempAllocator = new TempAllocatorImpl(10 * 1024 * 1024);
         
-        // --- THE FIX: Lock Jolt to exactly 4 cores ---
-        jobSystem = new JobSystemThreadPool(cMaxPhysicsJobs, cMaxPhysicsBarriers, 4);
+        // No private thread pool, physics jobs share the engine workers with everything else
+        jobSystem = new JoltJobSystem(Crescendo::JobSystem::Get(), cMaxPhysicsJobs, cMaxPhysicsBarriers);
 
         physicsSystem = new PhysicsSystem();
         physicsSystem->Init(1024, 0, 1024, 1024, broad_phase_layer_interface, object_vs_broadphase_layer_filter, object_vs_object_layer_filter);
@@ -202,11 +207,13 @@ public:
         }
     }
 
-    void CreateMeshCollider(int entityID, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, glm::vec3 pos, glm::vec3 scale) {
+    void CreateMeshCollider(CBaseEntity* ent, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, glm::vec3 pos, glm::vec3 scale) {
         if (!bodyInterface) {
             std::cerr << "!! CRITICAL: BodyInterface is NULL" << std::endl; 
             return; 
         }
+        if (!ent) return;
+        int entityID = ent->index;
 
         // 1. Convert our Vulkan Vertices into Jolt's Float3 format, applying the model's scale
         JPH::VertexList joltVertices;
@@ -254,13 +261,15 @@ public:
         }
         
         bodyInterface->AddBody(body->GetID(), EActivation::DontActivate);
-        entityBodyMap[entityID] = body->GetID();
+        LinkBody(ent, body->GetID());
         
         std::cout << "[Physics] Mesh Collider generated for Entity " << entityID << " (" << joltIndices.size() << " triangles)" << std::endl;
     }
 
-    void CreateBox(int entityID, glm::vec3 position, glm::vec3 scale, bool isDynamic) {
+    void CreateBox(CBaseEntity* ent, glm::vec3 position, glm::vec3 scale, bool isDynamic) {
         if (!bodyInterface) { std::cerr << "!! CRITICAL: BodyInterface is NULL" << std::endl; return; }
+        if (!ent) return;
+        int entityID = ent->index;
 
         BoxShapeSettings* boxShape = new BoxShapeSettings(ToJolt(scale / 2.0f)); 
 
@@ -279,13 +288,13 @@ public:
         }
         
         bodyInterface->AddBody(body->GetID(), EActivation::Activate);
-        entityBodyMap[entityID] = body->GetID();
+        LinkBody(ent, body->GetID());
     }
 
     // Change return type to JPH::Body*
-    JPH::Body* CreateChassisBody(int entityID, glm::vec3 position) {
+    JPH::Body* CreateChassisBody(CBaseEntity* ent, glm::vec3 position) {
         std::cout << "[Physics] Creating Car Chassis Body (Z-Up)..." << std::endl;
-        if (!bodyInterface) return nullptr;
+        if (!bodyInterface || !ent) return nullptr;
 
         // SLIMMED DOWN COLLISION: 
         // 1.2m wide, 2.6m long, 0.2m tall
@@ -302,17 +311,18 @@ public:
         if (!carBody) return nullptr;
         
         bodyInterface->AddBody(carBody->GetID(), EActivation::Activate);
-        entityBodyMap[entityID] = carBody->GetID();
+        LinkBody(ent, carBody->GetID());
         
         // Return the raw pointer instead of the ID
         return carBody;
     }
 
-    void ResetBody(int entityID, glm::vec3 pos, glm::vec3 rot) {
+    void ResetBody(EntityHandle entity, glm::vec3 pos, glm::vec3 rot) {
         if (!bodyInterface) return;
         
-        if (entityBodyMap.find(entityID) != entityBodyMap.end()) {
-            JPH::BodyID id = entityBodyMap[entityID];
+        auto it = entityBodyMap.find(entity);
+        if (it != entityBodyMap.end()) {
+            JPH::BodyID id = it->second;
             
             // 1. Stop all movement
             bodyInterface->SetLinearAndAngularVelocity(id, JPH::Vec3::sZero(), JPH::Vec3::sZero());
@@ -323,16 +333,78 @@ public:
         }
     }
 
-    void Update(float deltaTime, std::vector<class CBaseEntity*>& entityList) {
+    // Moves the entity into the physics archetype and records the body on its row
+    void LinkBody(CBaseEntity* ent, BodyID bodyID) {
+        ent->EnablePhysicsLink().bodyID = bodyID.GetIndexAndSequenceNumber();
+        entityBodyMap[ent->handle] = bodyID;
+    }
+
+    // Called by Scene when an entity is deleted so its body doesn't keep simulating
+    void RemoveBody(EntityHandle entity) {
+        auto it = entityBodyMap.find(entity);
+        if (it == entityBodyMap.end()) return;
+
+        if (bodyInterface) {
+            if (bodyInterface->IsAdded(it->second)) bodyInterface->RemoveBody(it->second);
+            bodyInterface->DestroyBody(it->second);
+        }
+        entityBodyMap.erase(it);
+    }
+
+    // Deleted during play but still in the scene snapshot: out of the simulation, body kept
+    void SuspendBody(EntityHandle entity) {
+        auto it = entityBodyMap.find(entity);
+        if (it != entityBodyMap.end() && bodyInterface && bodyInterface->IsAdded(it->second)) {
+            bodyInterface->RemoveBody(it->second);
+        }
+    }
+
+    void ResumeBody(EntityHandle entity) {
+        auto it = entityBodyMap.find(entity);
+        if (it != entityBodyMap.end() && bodyInterface && !bodyInterface->IsAdded(it->second)) {
+            bodyInterface->AddBody(it->second, EActivation::DontActivate);
+        }
+    }
+
+    // --- PLAY MODE SNAPSHOT ---
+    // Jolt's own state recorder: positions, velocities, sleep state and contact cache
+    void SaveState() {
         if (!physicsSystem) return;
+        savedState.Clear();
+        physicsSystem->SaveState(savedState);
+        hasSavedState = true;
+    }
+
+    // Call after the scene has been restored. If the body set changed in a way Jolt
+    // can't map back, every body is teleported to its entity's restored transform instead.
+    void RestoreState(Scene* scene) {
+        if (!physicsSystem || !hasSavedState) return;
+        hasSavedState = false;
+
+        savedState.Rewind();
+        if (physicsSystem->RestoreState(savedState)) return;
+
+        std::cout << "[Physics] Saved state no longer matches the bodies, resetting them from the scene." << std::endl;
+        for (auto& [handle, bodyID] : entityBodyMap) {
+            const CBaseEntity* ent = scene ? scene->GetEntity(handle) : nullptr;
+            if (ent) ResetBody(handle, ent->Origin(), ent->Angles());
+        }
+    }
+
+    void Update(float deltaTime, Scene* scene) {
+        if (!physicsSystem || !scene) return;
+        PROFILE_SCOPE("PhysicsServer::Update");
+
+        PROFILE_PHASE(phase, "Jolt Step");
         physicsSystem->Update(deltaTime, 1, tempAllocator, jobSystem);
 
-        for (auto& pair : entityBodyMap) {
-            int entID = pair.first;
-            BodyID bodyID = pair.second;
-            
-            if (entID < (int)entityList.size() && entityList[entID]) {
-                
+        // Write back straight into the transform columns of archetypes that own a body
+        phase.Next("Write Back");
+        scene->storage.ForEachChunk(GROUP_TRANSFORM | GROUP_PHYSICS, [&](EntityChunk& chunk) {
+            for (uint32_t i = 0; i < chunk.count; i++) {
+                BodyID bodyID(chunk.physics[i].bodyID);
+                if (bodyID.IsInvalid()) continue;
+
                 // --- FIX 4: The "Anti-Gravity" Static Lock ---
                 if (bodyInterface->GetMotionType(bodyID) == EMotionType::Static) {
                     continue; // NEVER move static objects
@@ -340,15 +412,19 @@ public:
                 // -------------------------------------------
 
                 if (bodyInterface->IsActive(bodyID)) {
-                    Vec3 pos = bodyInterface->GetPosition(bodyID);
-                    entityList[entID]->origin = ToGlm(pos);
-                    
-                    Quat rot = bodyInterface->GetRotation(bodyID);
+                    Vec3 pos;
+                    Quat rot;
+                    bodyInterface->GetPositionAndRotation(bodyID, pos, rot);
+                    chunk.origin[i] = ToGlm(pos);
+
                     glm::quat glmRot(rot.GetW(), rot.GetX(), rot.GetY(), rot.GetZ());
-                    entityList[entID]->angles = glm::degrees(glm::eulerAngles(glmRot));
+                    chunk.angles[i] = glm::degrees(glm::eulerAngles(glmRot));
+
+                    // Bodies are simulated in world space, so this assumes the entity is a hierarchy root
+                    chunk.dirty[i] = 1;
                 }
             }
-        }
+        });
     }
 
     // ---------------------------------------------------------
@@ -360,7 +436,7 @@ public:
         auto planetComp = planet->GetComponent<Crescendo::ProceduralPlanetComponent>();
 
         // 1. Calculate the vector from the Planet's Core to the Camera
-        glm::vec3 toCam = cam.Position - planet->origin;
+        glm::vec3 toCam = cam.Position - planet->WorldPosition();
         float distanceToCore = glm::length(toCam);
         if (distanceToCore == 0.0f) return;
 
@@ -397,9 +473,10 @@ public:
         float minDistance = std::numeric_limits<float>::max();
 
         // 1. Scan the scene dynamically for planets
-        for (auto* ent : scene->entities) {
-            if (ent && ent->HasComponent<Crescendo::ProceduralPlanetComponent>()) {
-                float dist = glm::length(cam.Position - ent->origin);
+        for (auto* planet : scene->storage.Components<Crescendo::ProceduralPlanetComponent>()) {
+            Crescendo::CBaseEntity* ent = planet->owner;
+            if (ent) {
+                float dist = glm::length(cam.Position - ent->WorldPosition());
                 if (dist < minDistance) {
                     minDistance = dist;
                     closestPlanet = ent;
@@ -413,7 +490,7 @@ public:
             
             // Dynamically scale speed based on this specific planet's radius!
             auto planetComp = closestPlanet->GetComponent<Crescendo::ProceduralPlanetComponent>();
-            float alt = glm::length(cam.Position - closestPlanet->origin) - planetComp->settings.radius;
+            float alt = glm::length(cam.Position - closestPlanet->WorldPosition()) - planetComp->settings.radius;
             
             // Slower near the dirt, screaming fast in orbit
             cam.MovementSpeed = glm::clamp(alt * 0.1f, 10.0f, 1000.0f);
@@ -0,0 +1,87 @@
+#include "servers/rendering/DrawKey.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Crescendo {
+
+    // =========================================================
+    // DRAW KEY
+    // =========================================================
+
+    namespace {
+        uint64_t Field(uint32_t value, uint32_t bits, uint32_t shift) {
+            uint32_t mask = (1u << bits) - 1u;
+            return static_cast<uint64_t>(std::min(value, mask)) << shift;
+        }
+
+        // -1 is "no texture", it sorts first
+        uint32_t MaterialField(int material) {
+            return static_cast<uint32_t>(std::max(material + 1, 0));
+        }
+    }
+
+    uint32_t DrawKey::QuantizeDepth(float depth) {
+        if (!(depth > 0.0f)) return 0;
+
+        // Sign bit clear, so the top 31 bits order like the float. Keep the top 24 of them.
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits >> (31 - DEPTH_BITS);
+    }
+
+    uint64_t DrawKey::Opaque(DrawPass pass, DrawPipeline pipeline, uint32_t mesh, int material, float depth) {
+        return Field(static_cast<uint32_t>(pass), 4, 60) |
+               Field(static_cast<uint32_t>(pipeline), 4, 56) |
+               Field(mesh, MESH_BITS, 36) |
+               Field(MaterialField(material), MATERIAL_BITS, 24) |
+               Field(QuantizeDepth(depth), DEPTH_BITS, 0);
+    }
+
+    uint64_t DrawKey::Transparent(DrawPass pass, DrawPipeline pipeline, uint32_t mesh, int material, float depth) {
+        // Inverted, so the farthest sorts first
+        uint32_t farFirst = ((1u << DEPTH_BITS) - 1u) - QuantizeDepth(depth);
+        return Field(static_cast<uint32_t>(pass), 4, 60) |
+               Field(farFirst, DEPTH_BITS, 36) |
+               Field(static_cast<uint32_t>(pipeline), 4, 32) |
+               Field(mesh, MESH_BITS, 12) |
+               Field(MaterialField(material), MATERIAL_BITS, 0);
+    }
+
+    // =========================================================
+    // RADIX SORT
+    // =========================================================
+
+    void RadixSortDraws(std::vector<SortedDraw>& draws, std::vector<SortedDraw>& scratch) {
+        const size_t count = draws.size();
+        if (count < 2) return;
+
+        // Every byte's histogram in one read of the keys
+        uint32_t histograms[8][256] = {};
+        for (const SortedDraw& draw : draws) {
+            for (uint32_t b = 0; b < 8; b++) histograms[b][(draw.key >> (b * 8)) & 0xFF]++;
+        }
+
+        scratch.resize(count);
+        std::vector<SortedDraw>* src = &draws;
+        std::vector<SortedDraw>* dst = &scratch;
+
+        for (uint32_t b = 0; b < 8; b++) {
+            uint32_t* histogram = histograms[b];
+
+            // All keys share this byte, the pass would only copy
+            if (histogram[(draws[0].key >> (b * 8)) & 0xFF] == count) continue;
+
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < 256; bucket++) {
+                uint32_t size = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += size;
+            }
+
+            for (const SortedDraw& draw : *src) (*dst)[histogram[(draw.key >> (b * 8)) & 0xFF]++] = draw;
+            std::swap(src, dst);
+        }
+
+        if (src != &draws) draws.swap(scratch);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "servers/rendering/RenderPacket.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // DRAW KEYS
+    // Every draw of a frame gets one 64-bit key, most significant
+    // field first, so sorting the integers groups the draws by the
+    // state they need and orders them inside each group:
+    //
+    //   opaque       pass:4 | pipeline:4 | mesh:20 | material:12 | depth:24   near first
+    //   transparent  pass:4 | depth:24 | pipeline:4 | mesh:20 | material:12   far first
+    //
+    // Mesh sits above material: textures are bindless here, so a
+    // material change costs no bind, and keeping a mesh's draws
+    // together keeps its instanced batch whole. Depth is the camera
+    // distance's float bits, which order like the floats for positive
+    // values, so no near/far range is needed.
+    // =========================================================
+
+    enum class DrawPass : uint8_t {
+        Opaque = 0,
+        Terrain,
+        Transparent,
+        Water,
+        Outline,
+        Shadow,                                 // Shadow + cascade, one pass per cascade
+        StaticShadow = Shadow + 4,              // Same, for the cascades' cached layers
+        Count = StaticShadow + 4
+    };
+
+    enum class DrawPipeline : uint8_t {
+        Opaque = 0,
+        Transparent,
+        Water,
+        Outline,
+        Shadow
+    };
+
+    struct DrawKey {
+        static constexpr uint32_t MESH_BITS = 20;
+        static constexpr uint32_t MATERIAL_BITS = 12;
+        static constexpr uint32_t DEPTH_BITS = 24;
+
+        static uint64_t Opaque(DrawPass pass, DrawPipeline pipeline, uint32_t mesh, int material, float depth);
+        static uint64_t Transparent(DrawPass pass, DrawPipeline pipeline, uint32_t mesh, int material, float depth);
+
+        static DrawPass Pass(uint64_t key) { return static_cast<DrawPass>(key >> 60); }
+        static uint32_t QuantizeDepth(float depth);     // Monotonic for depth >= 0, negative clamps to 0
+    };
+
+    struct SortedDraw {
+        uint64_t key;
+        DrawItem item;
+    };
+
+    // LSD radix sort on the key, one byte per pass. Stable, so equal keys keep the order they were
+    // queued in, and a byte every key shares costs no pass. Ends with the result in draws.
+    void RadixSortDraws(std::vector<SortedDraw>& draws, std::vector<SortedDraw>& scratch);
+}
@@ -0,0 +1,133 @@
+#include "servers/rendering/FrustumCuller.hpp"
+
+#if defined(__AVX__) || defined(__SSE__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+namespace Crescendo {
+
+    // =========================================================
+    // FRUSTUM
+    // =========================================================
+
+    Frustum Frustum::FromMatrix(const glm::mat4& viewProj, bool sidesOnly) {
+        // glm is column-major, row r of the matrix is m[0][r], m[1][r], m[2][r], m[3][r]
+        auto row = [&](int r) { return glm::vec4(viewProj[0][r], viewProj[1][r], viewProj[2][r], viewProj[3][r]); };
+
+        Frustum frustum;
+        frustum.planes[0] = row(3) + row(0);    // Left
+        frustum.planes[1] = row(3) - row(0);    // Right
+        frustum.planes[2] = row(3) + row(1);    // Bottom (top with Vulkan's flipped Y, same pair)
+        frustum.planes[3] = row(3) - row(1);    // Top
+        frustum.planes[4] = row(2);             // Near, z >= 0 with zero-to-one depth
+        frustum.planes[5] = row(3) - row(2);    // Far
+        frustum.planeCount = sidesOnly ? 4 : 6;
+
+        for (glm::vec4& plane : frustum.planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f) plane /= length;
+        }
+        return frustum;
+    }
+
+    bool Frustum::ContainsSphere(const glm::vec4& sphere) const {
+        for (uint32_t p = 0; p < planeCount; p++) {
+            // Completely behind any one plane = outside
+            if (glm::dot(glm::vec3(planes[p]), glm::vec3(sphere)) + planes[p].w < -sphere.w) return false;
+        }
+        return true;
+    }
+
+    // =========================================================
+    // SPHERE BATCH
+    // =========================================================
+
+    void SphereBatch::Clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+        radius.clear();
+        count = 0;
+    }
+
+    void SphereBatch::Reserve(size_t capacity) {
+        x.reserve(capacity);
+        y.reserve(capacity);
+        z.reserve(capacity);
+        radius.reserve(capacity);
+    }
+
+    void SphereBatch::Add(const glm::vec4& sphere) {
+        x.push_back(sphere.x);
+        y.push_back(sphere.y);
+        z.push_back(sphere.z);
+        radius.push_back(sphere.w);
+        count++;
+    }
+
+    uint32_t SphereBatch::Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const {
+        visible.resize(count);
+        uint32_t drawn = 0;
+        size_t i = 0;
+
+#if defined(__AVX__)
+        // 8 spheres per step: d = n.c + w, inside while d >= -r for every plane
+        for (; i + 8 <= count; i += 8) {
+            __m256 cx = _mm256_loadu_ps(&x[i]);
+            __m256 cy = _mm256_loadu_ps(&y[i]);
+            __m256 cz = _mm256_loadu_ps(&z[i]);
+            __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&radius[i]));
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (uint32_t p = 0; p < frustum.planeCount; p++) {
+                const glm::vec4& plane = frustum.planes[p];
+                __m256 d = _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(plane.x)), _mm256_set1_ps(plane.w));
+                d = _mm256_add_ps(d, _mm256_mul_ps(cy, _mm256_set1_ps(plane.y)));
+                d = _mm256_add_ps(d, _mm256_mul_ps(cz, _mm256_set1_ps(plane.z)));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negR, _CMP_GE_OQ));
+            }
+
+            int mask = _mm256_movemask_ps(inside);
+            for (int lane = 0; lane < 8; lane++) {
+                uint8_t in = static_cast<uint8_t>((mask >> lane) & 1);
+                visible[i + lane] = in;
+                drawn += in;
+            }
+        }
+#endif
+
+#if defined(__SSE__) || defined(_M_X64)
+        // 4 at a time, the AVX remainder or the whole batch without AVX
+        for (; i + 4 <= count; i += 4) {
+            __m128 cx = _mm_loadu_ps(&x[i]);
+            __m128 cy = _mm_loadu_ps(&y[i]);
+            __m128 cz = _mm_loadu_ps(&z[i]);
+            __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&radius[i]));
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (uint32_t p = 0; p < frustum.planeCount; p++) {
+                const glm::vec4& plane = frustum.planes[p];
+                __m128 d = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+                d = _mm_add_ps(d, _mm_mul_ps(cy, _mm_set1_ps(plane.y)));
+                d = _mm_add_ps(d, _mm_mul_ps(cz, _mm_set1_ps(plane.z)));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+            }
+
+            int mask = _mm_movemask_ps(inside);
+            for (int lane = 0; lane < 4; lane++) {
+                uint8_t in = static_cast<uint8_t>((mask >> lane) & 1);
+                visible[i + lane] = in;
+                drawn += in;
+            }
+        }
+#endif
+
+        // Scalar tail (and the whole batch on targets without SSE)
+        for (; i < count; i++) {
+            uint8_t in = frustum.ContainsSphere(glm::vec4(x[i], y[i], z[i], radius[i])) ? 1 : 0;
+            visible[i] = in;
+            drawn += in;
+        }
+        return drawn;
+    }
+}
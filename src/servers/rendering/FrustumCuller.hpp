@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Crescendo {
+
+    // =========================================================
+    // FRUSTUM CULLING
+    // World-space bounding spheres are kept as separate x/y/z/radius
+    // arrays, so one plane test covers 8 spheres with AVX or 4 with
+    // SSE. Each view (the camera, every shadow cascade) runs over the
+    // same batch and gets one visibility byte per sphere back.
+    // =========================================================
+
+    struct Frustum {
+        glm::vec4 planes[6];        // xyz = normal pointing inside, w = distance, normalized
+        uint32_t planeCount = 0;
+
+        // Gribb-Hartmann extraction from Vulkan clip space (0..w depth, GLM_FORCE_DEPTH_ZERO_TO_ONE).
+        // Side planes only for views that clamp depth instead of clipping (shadow cascades).
+        static Frustum FromMatrix(const glm::mat4& viewProj, bool sidesOnly = false);
+
+        bool ContainsSphere(const glm::vec4& sphere) const;
+    };
+
+    // Objects offered to one view and how many of them survived
+    struct ViewCullStats {
+        uint32_t tested = 0;
+        uint32_t drawn = 0;
+
+        uint32_t Culled() const { return tested - drawn; }
+        void Add(uint32_t testedCount, uint32_t drawnCount) {
+            tested += testedCount;
+            drawn += drawnCount;
+        }
+    };
+
+    struct CullStats {
+        ViewCullStats camera;
+        ViewCullStats cascades[4];
+        double cullMs = 0.0;        // Every test of the frame, all views
+        bool gpu = false;           // Opaque rows culled on the GPU, their drawn counts are a frame late
+    };
+
+    class SphereBatch {
+    public:
+        void Clear();
+        void Reserve(size_t count);
+        void Add(const glm::vec4& sphere);   // xyz center + w radius
+        size_t Size() const { return count; }
+
+        // visible[i] = 1 if sphere i touches the frustum. Returns how many did.
+        uint32_t Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const;
+
+    private:
+        std::vector<float> x, y, z, radius;
+        size_t count = 0;
+    };
+}
@@ -0,0 +1,233 @@
+#include "servers/rendering/GeometryArena.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace Crescendo {
+
+    // =========================================================
+    // RANGE ALLOCATOR
+    // =========================================================
+
+    void RangeAllocator::Reset(uint32_t newCapacity) {
+        freeRanges.clear();
+        capacity = newCapacity;
+        used = 0;
+        if (capacity > 0) freeRanges[0] = capacity;
+    }
+
+    uint32_t RangeAllocator::Allocate(uint32_t count) {
+        if (count == 0) return INVALID;
+
+        // Best fit keeps the big ranges whole for the big meshes
+        auto best = freeRanges.end();
+        for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+            if (it->second < count) continue;
+            if (best == freeRanges.end() || it->second < best->second) best = it;
+            if (best->second == count) break;
+        }
+        if (best == freeRanges.end()) return INVALID;
+
+        uint32_t offset = best->first;
+        uint32_t remaining = best->second - count;
+        freeRanges.erase(best);
+        if (remaining > 0) freeRanges[offset + count] = remaining;
+
+        used += count;
+        return offset;
+    }
+
+    void RangeAllocator::Free(uint32_t offset, uint32_t count) {
+        if (count == 0 || offset == INVALID) return;
+
+        auto next = freeRanges.lower_bound(offset);
+
+        // Merge into the range that ends where this one starts
+        if (next != freeRanges.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                count += prev->second;
+                freeRanges.erase(prev);
+            }
+        }
+
+        // And swallow the one that starts where it ends
+        if (next != freeRanges.end() && offset + count == next->first) {
+            count += next->second;
+            freeRanges.erase(next);
+        }
+
+        freeRanges[offset] = count;
+        used -= std::min(used, count);
+    }
+
+    uint32_t RangeAllocator::LargestFree() const {
+        uint32_t largest = 0;
+        for (const auto& range : freeRanges) largest = std::max(largest, range.second);
+        return largest;
+    }
+
+#ifndef __EMSCRIPTEN__
+
+    // =========================================================
+    // GEOMETRY ARENA
+    // =========================================================
+
+    void GeometryArena::Initialize(VmaAllocator vmaAllocator, VkDeviceSize vertexStride) {
+        allocator = vmaAllocator;
+        stride = vertexStride;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        pages.push_back(CreatePage(PAGE_VERTICES, PAGE_INDICES));
+    }
+
+    void GeometryArena::Shutdown() {
+        std::lock_guard<std::mutex> lock(mutex);
+        pages.clear();
+    }
+
+    GeometryArena::Page GeometryArena::CreatePage(uint32_t vertexCapacity, uint32_t indexCapacity) {
+        // Transfer source too, so Compact can copy a page into its replacement
+        VkBufferUsageFlags transfer = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+        Page page;
+        page.vertices = VulkanBuffer(allocator, stride * vertexCapacity, transfer | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, 0, VMA_MEMORY_USAGE_GPU_ONLY);
+        page.indices = VulkanBuffer(allocator, sizeof(uint32_t) * static_cast<VkDeviceSize>(indexCapacity), transfer | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, 0, VMA_MEMORY_USAGE_GPU_ONLY);
+        page.vertexRanges.Reset(vertexCapacity);
+        page.indexRanges.Reset(indexCapacity);
+        return page;
+    }
+
+    GeometryAllocation GeometryArena::Allocate(uint32_t vertexCount, uint32_t indexCount) {
+        GeometryAllocation allocation;
+        if (vertexCount == 0 || indexCount == 0) return allocation;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto tryPage = [&](uint32_t p) {
+            Page& page = pages[p];
+            uint32_t vertexOffset = page.vertexRanges.Allocate(vertexCount);
+            if (vertexOffset == RangeAllocator::INVALID) return false;
+
+            uint32_t firstIndex = page.indexRanges.Allocate(indexCount);
+            if (firstIndex == RangeAllocator::INVALID) {
+                page.vertexRanges.Free(vertexOffset, vertexCount);
+                return false;
+            }
+
+            allocation.page = p;
+            allocation.vertexOffset = vertexOffset;
+            allocation.vertexCount = vertexCount;
+            allocation.firstIndex = firstIndex;
+            allocation.indexCount = indexCount;
+            page.allocations++;
+            return true;
+        };
+
+        for (uint32_t p = 0; p < pages.size(); p++) {
+            if (tryPage(p)) return allocation;
+        }
+
+        // Nothing fits: a new page, bigger than the default for meshes that would not fit in one
+        pages.push_back(CreatePage(std::max(PAGE_VERTICES, vertexCount), std::max(PAGE_INDICES, indexCount)));
+        std::cout << "[Geometry] Arena grew to " << pages.size() << " pages." << std::endl;
+        tryPage(static_cast<uint32_t>(pages.size() - 1));
+        return allocation;
+    }
+
+    void GeometryArena::Free(const GeometryAllocation& allocation) {
+        if (!allocation.IsValid()) return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (allocation.page >= pages.size()) return;
+
+        Page& page = pages[allocation.page];
+        page.vertexRanges.Free(allocation.vertexOffset, allocation.vertexCount);
+        page.indexRanges.Free(allocation.firstIndex, allocation.indexCount);
+        if (page.allocations > 0) page.allocations--;
+    }
+
+    VkBuffer GeometryArena::VertexBuffer(uint32_t page) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return page < pages.size() ? pages[page].vertices.handle : VK_NULL_HANDLE;
+    }
+
+    VkBuffer GeometryArena::IndexBuffer(uint32_t page) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return page < pages.size() ? pages[page].indices.handle : VK_NULL_HANDLE;
+    }
+
+    GeometryArenaStats GeometryArena::Stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        GeometryArenaStats stats;
+        stats.pages = static_cast<uint32_t>(pages.size());
+        for (const Page& page : pages) {
+            stats.vertexBytes += stride * page.vertexRanges.Capacity();
+            stats.vertexBytesUsed += stride * page.vertexRanges.Used();
+            stats.indexBytes += sizeof(uint32_t) * static_cast<uint64_t>(page.indexRanges.Capacity());
+            stats.indexBytesUsed += sizeof(uint32_t) * static_cast<uint64_t>(page.indexRanges.Used());
+            stats.allocations += page.allocations;
+            stats.freeRanges += page.vertexRanges.FreeRanges() + page.indexRanges.FreeRanges();
+        }
+        return stats;
+    }
+
+    std::vector<VulkanBuffer> GeometryArena::Compact(VkCommandBuffer cmd, const std::vector<GeometryAllocation*>& live) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<VulkanBuffer> retired;
+
+        for (uint32_t p = 0; p < pages.size(); p++) {
+            Page& page = pages[p];
+
+            std::vector<GeometryAllocation*> onPage;
+            for (GeometryAllocation* allocation : live) {
+                if (allocation->page == p) onPage.push_back(allocation);
+            }
+
+            // Pinned by an allocation nobody listed, or at most one hole that packing would only move
+            if (onPage.size() != page.allocations) continue;
+            if (page.vertexRanges.FreeRanges() <= 1 && page.indexRanges.FreeRanges() <= 1) continue;
+
+            Page packed = CreatePage(page.vertexRanges.Capacity(), page.indexRanges.Capacity());
+            std::vector<VkBufferCopy> vertexCopies, indexCopies;
+            vertexCopies.reserve(onPage.size());
+            indexCopies.reserve(onPage.size());
+
+            for (GeometryAllocation* allocation : onPage) {
+                uint32_t vertexOffset = packed.vertexRanges.Allocate(allocation->vertexCount);
+                uint32_t firstIndex = packed.indexRanges.Allocate(allocation->indexCount);
+
+                // Indices are relative to vertexOffset, so they copy over unchanged
+                vertexCopies.push_back({ stride * allocation->vertexOffset, stride * vertexOffset, stride * allocation->vertexCount });
+                indexCopies.push_back({ sizeof(uint32_t) * static_cast<VkDeviceSize>(allocation->firstIndex),
+                                        sizeof(uint32_t) * static_cast<VkDeviceSize>(firstIndex),
+                                        sizeof(uint32_t) * static_cast<VkDeviceSize>(allocation->indexCount) });
+
+                allocation->vertexOffset = vertexOffset;
+                allocation->firstIndex = firstIndex;
+                packed.allocations++;
+            }
+
+            if (!vertexCopies.empty()) {
+                vkCmdCopyBuffer(cmd, page.vertices.handle, packed.vertices.handle, static_cast<uint32_t>(vertexCopies.size()), vertexCopies.data());
+                vkCmdCopyBuffer(cmd, page.indices.handle, packed.indices.handle, static_cast<uint32_t>(indexCopies.size()), indexCopies.data());
+            }
+
+            retired.push_back(std::move(page.vertices));
+            retired.push_back(std::move(page.indices));
+            page = std::move(packed);
+        }
+
+        // The next frames read the packed pages as vertex and index input
+        VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        return retired;
+    }
+
+#endif
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#ifndef __EMSCRIPTEN__
+    #include "vulkan/VulkanResources.hpp"
+#endif
+
+namespace Crescendo {
+
+    // =========================================================
+    // RANGE ALLOCATOR
+    // Hands out [offset, offset + count) ranges of a fixed-size block.
+    // Free ranges are kept by offset so a freed range merges with its
+    // neighbours straight away, allocation takes the smallest range
+    // that fits. Units are whatever the owner counts in (vertices,
+    // indices), never bytes.
+    // =========================================================
+
+    class RangeAllocator {
+    public:
+        static constexpr uint32_t INVALID = UINT32_MAX;
+
+        void Reset(uint32_t capacity);
+        uint32_t Allocate(uint32_t count);      // Offset, INVALID when no free range is big enough
+        void Free(uint32_t offset, uint32_t count);
+
+        uint32_t Capacity() const { return capacity; }
+        uint32_t Used() const { return used; }
+        uint32_t LargestFree() const;
+        size_t FreeRanges() const { return freeRanges.size(); }
+
+    private:
+        std::map<uint32_t, uint32_t> freeRanges;    // Offset -> count
+        uint32_t capacity = 0;
+        uint32_t used = 0;
+    };
+
+    // --- GEOMETRY ALLOCATION ---
+    // Where a mesh lives inside the arena. The offsets go straight into
+    // vkCmdDrawIndexed as vertexOffset and firstIndex.
+    struct GeometryAllocation {
+        uint32_t page = RangeAllocator::INVALID;
+        uint32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+
+        bool IsValid() const { return page != RangeAllocator::INVALID; }
+    };
+
+    struct GeometryArenaStats {
+        uint32_t pages = 0;
+        uint64_t vertexBytes = 0;               // Capacity of every page
+        uint64_t vertexBytesUsed = 0;
+        uint64_t indexBytes = 0;
+        uint64_t indexBytesUsed = 0;
+        uint32_t allocations = 0;
+        size_t freeRanges = 0;                  // Holes, vertex and index side together
+    };
+
+#ifndef __EMSCRIPTEN__
+
+    // =========================================================
+    // GEOMETRY ARENA
+    // Every mesh's vertices and indices, sub-allocated out of a few
+    // large device-local buffers instead of one VMA allocation pair
+    // per mesh. A page is one vertex buffer plus one index buffer;
+    // a new page is only added when no existing page has room, so a
+    // pass normally binds geometry once and draws everything with
+    // firstIndex / vertexOffset.
+    //
+    // Pages never move or shrink while the engine runs, except in
+    // Compact, which the owner calls with the GPU idle.
+    // =========================================================
+
+    class GeometryArena {
+    public:
+        static constexpr uint32_t PAGE_VERTICES = 1u << 19;    // 42 MB of Vertex
+        static constexpr uint32_t PAGE_INDICES = 1u << 21;     // 8 MB of uint32
+
+        void Initialize(VmaAllocator vmaAllocator, VkDeviceSize vertexStride);
+        void Shutdown();
+
+        // Thread-safe, terrain bakes allocate from the job workers
+        GeometryAllocation Allocate(uint32_t vertexCount, uint32_t indexCount);
+        void Free(const GeometryAllocation& allocation);
+
+        VkBuffer VertexBuffer(uint32_t page);
+        VkBuffer IndexBuffer(uint32_t page);
+        VkDeviceSize VertexStride() const { return stride; }
+        GeometryArenaStats Stats();
+
+        // --- Defragmentation ---
+        // Packs each page's live ranges to the front of a fresh page, in the order given. A page is
+        // only rebuilt when every live range on it is in the list (a bake still waiting to be adopted
+        // pins its page). Records the copies into cmd and returns the buffers to destroy once the
+        // GPU has finished with them; the allocations are rewritten in place.
+        std::vector<VulkanBuffer> Compact(VkCommandBuffer cmd, const std::vector<GeometryAllocation*>& live);
+
+    private:
+        struct Page {
+            VulkanBuffer vertices;
+            VulkanBuffer indices;
+            RangeAllocator vertexRanges;
+            RangeAllocator indexRanges;
+            uint32_t allocations = 0;
+        };
+
+        Page CreatePage(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+        std::mutex mutex;
+        std::vector<Page> pages;
+        VmaAllocator allocator = nullptr;
+        VkDeviceSize stride = 0;
+    };
+
+#endif
+}
@@ -1,11 +1,13 @@
 #pragma once
 #include "RenderTypes.hpp"
+#include "RenderPacket.hpp"
 #include "core/EngineState.hpp"
 #include <memory>
 
 namespace Crescendo {
     // Forward declare to keep compile times fast
     class DisplayServer;
+    class Camera;
     class Scene;
     class SceneManager;
     
@@ -16,7 +18,17 @@ namespace Crescendo {
         // Signatures must exactly match your Vulkan implementation!
         virtual bool initialize(DisplayServer* display) = 0;
         virtual void shutdown() = 0;
-        virtual void render(Scene* scene, SceneManager* sceneManager, EngineState& engineState) = 0;
+
+        // A frame is built and drawn in two halves so they can run on different threads:
+        // buildPacket reads the scene on the simulation thread, renderPacket only sees the packet.
+        // The camera belongs to the engine, the editor may fly it while the frame is built.
+        virtual void buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) = 0;
+        virtual void renderPacket(RenderPacket& packet) = 0;
+
+        // Runs on a background job. Collision data is filled when needsCollision is set.
         virtual ChunkBakeResult buildChunkMesh(const TerrainComputePush& pushData, bool needsCollision) = 0;
+
+        // Takes ownership of a finished mesh (e.g. a baked chunk), returns its mesh ID
+        virtual int adoptMesh(MeshResource&& mesh) = 0;
     };
 }
\ No newline at end of file
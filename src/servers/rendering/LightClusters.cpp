@@ -0,0 +1,173 @@
+#include "servers/rendering/LightClusters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__AVX__) || defined(__SSE__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+namespace Crescendo {
+
+    void LightClusterBuilder::Clear() {
+        source.clear();
+        x.clear();
+        y.clear();
+        z.clear();
+        radius.clear();
+    }
+
+    void LightClusterBuilder::Add(const PointLight& light) {
+        source.push_back(light);
+        x.push_back(light.positionAndRadius.x);
+        y.push_back(light.positionAndRadius.y);
+        z.push_back(light.positionAndRadius.z);
+        radius.push_back(light.positionAndRadius.w);
+    }
+
+    glm::vec2 LightClusterBuilder::SliceParams(float zNear) {
+        return glm::vec2(zNear, static_cast<float>(CLUSTER_Z) / std::log(CLUSTER_FAR / zNear));
+    }
+
+    LightClusterStats LightClusterBuilder::Build(const glm::mat4& view, const glm::mat4& proj, float zNear,
+                                                 std::vector<PointLight>& lights, std::vector<glm::uvec2>& ranges, std::vector<uint32_t>& indices) {
+        auto start = std::chrono::steady_clock::now();
+
+        LightClusterStats stats;
+        const size_t count = source.size();
+        stats.lights = static_cast<uint32_t>(count);
+
+        lights.clear();
+        indices.clear();
+        ranges.assign(CLUSTER_COUNT, glm::uvec2(0));
+        bounds.clear();
+        visibleSource.clear();
+
+        // --- View space ---
+        // Depth is the distance in front of the camera, what the shaders get back from clip.w
+        viewX.resize(count);
+        viewY.resize(count);
+        viewDepth.resize(count);
+        auto row = [&](int r) { return glm::vec4(view[0][r], view[1][r], view[2][r], view[3][r]); };
+        const glm::vec4 rowX = row(0), rowY = row(1), rowZ = -row(2);
+        size_t i = 0;
+
+#if defined(__SSE__) || defined(_M_X64)
+        // 4 lights per step
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_loadu_ps(&x[i]);
+            __m128 py = _mm_loadu_ps(&y[i]);
+            __m128 pz = _mm_loadu_ps(&z[i]);
+            auto transform = [&](const glm::vec4& r) {
+                __m128 v = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(r.x)), _mm_set1_ps(r.w));
+                v = _mm_add_ps(v, _mm_mul_ps(py, _mm_set1_ps(r.y)));
+                return _mm_add_ps(v, _mm_mul_ps(pz, _mm_set1_ps(r.z)));
+            };
+            _mm_storeu_ps(&viewX[i], transform(rowX));
+            _mm_storeu_ps(&viewY[i], transform(rowY));
+            _mm_storeu_ps(&viewDepth[i], transform(rowZ));
+        }
+#endif
+
+        // Scalar tail (and every light on targets without SSE)
+        for (; i < count; i++) {
+            glm::vec4 p(x[i], y[i], z[i], 1.0f);
+            viewX[i] = glm::dot(rowX, p);
+            viewY[i] = glm::dot(rowY, p);
+            viewDepth[i] = glm::dot(rowZ, p);
+        }
+
+        // --- Cluster ranges ---
+        glm::vec2 slices = SliceParams(zNear);
+        auto sliceOf = [&](float depth) {
+            float s = std::log(std::max(depth, zNear) / zNear) * slices.y;
+            return static_cast<uint16_t>(std::clamp(s, 0.0f, static_cast<float>(CLUSTER_Z - 1)));
+        };
+        auto tileOf = [](float uv, uint32_t tiles) {
+            return static_cast<uint16_t>(std::clamp(uv * static_cast<float>(tiles), 0.0f, static_cast<float>(tiles - 1)));
+        };
+
+        for (size_t l = 0; l < count; l++) {
+            float r = radius[l];
+            float depth = viewDepth[l];
+            if (depth + r <= zNear) continue;   // Behind the camera
+
+            Bounds b;
+            b.min[2] = sliceOf(depth - r);
+            b.max[2] = sliceOf(depth + r);
+
+            if (depth - r <= zNear) {
+                // Reaches past the near plane, its screen box is unbounded
+                b.min[0] = b.min[1] = 0;
+                b.max[0] = CLUSTER_X - 1;
+                b.max[1] = CLUSTER_Y - 1;
+            } else {
+                // Screen box of the sphere's view-space box: x / depth is monotonic in both, so the corners bound it
+                float nearDepth = depth - r, farDepth = depth + r;
+                float u[4] = { (viewX[l] - r) / nearDepth, (viewX[l] - r) / farDepth, (viewX[l] + r) / nearDepth, (viewX[l] + r) / farDepth };
+                float v[4] = { (viewY[l] - r) / nearDepth, (viewY[l] - r) / farDepth, (viewY[l] + r) / nearDepth, (viewY[l] + r) / farDepth };
+                float minU = 1e30f, maxU = -1e30f, minV = 1e30f, maxV = -1e30f;
+                for (int c = 0; c < 4; c++) {
+                    // NDC to 0..1, the projection's sign (Vulkan flips Y) is folded in by the min/max
+                    float cu = u[c] * proj[0][0] * 0.5f + 0.5f;
+                    float cv = v[c] * proj[1][1] * 0.5f + 0.5f;
+                    minU = std::min(minU, cu);
+                    maxU = std::max(maxU, cu);
+                    minV = std::min(minV, cv);
+                    maxV = std::max(maxV, cv);
+                }
+                if (maxU < 0.0f || minU > 1.0f || maxV < 0.0f || minV > 1.0f) continue;
+
+                b.min[0] = tileOf(minU, CLUSTER_X);
+                b.max[0] = tileOf(maxU, CLUSTER_X);
+                b.min[1] = tileOf(minV, CLUSTER_Y);
+                b.max[1] = tileOf(maxV, CLUSTER_Y);
+            }
+
+            if (bounds.size() >= MAX_POINT_LIGHTS) {
+                stats.truncated = true;
+                break;
+            }
+            bounds.push_back(b);
+            visibleSource.push_back(static_cast<uint32_t>(l));
+        }
+
+        auto forEachCluster = [](const Bounds& b, auto&& fn) {
+            for (uint32_t cz = b.min[2]; cz <= b.max[2]; cz++) {
+                for (uint32_t cy = b.min[1]; cy <= b.max[1]; cy++) {
+                    uint32_t rowStart = (cz * CLUSTER_Y + cy) * CLUSTER_X;
+                    for (uint32_t cx = b.min[0]; cx <= b.max[0]; cx++) fn(rowStart + cx);
+                }
+            }
+        };
+
+        // --- Index lists ---
+        // Counted first, so every cluster's list is one contiguous run of indices
+        for (const Bounds& b : bounds) forEachCluster(b, [&](uint32_t cluster) { ranges[cluster].y++; });
+
+        uint32_t offset = 0;
+        for (glm::uvec2& range : ranges) {
+            uint32_t kept = std::min(range.y, MAX_CLUSTER_LIGHT_INDICES - offset);
+            if (kept < range.y) stats.truncated = true;
+            range = glm::uvec2(offset, kept);
+            offset += kept;
+            stats.busiestCluster = std::max(stats.busiestCluster, kept);
+        }
+
+        indices.resize(offset);
+        cursors.assign(CLUSTER_COUNT, 0);
+        for (uint32_t v = 0; v < bounds.size(); v++) {
+            forEachCluster(bounds[v], [&](uint32_t cluster) {
+                if (cursors[cluster] < ranges[cluster].y) indices[ranges[cluster].x + cursors[cluster]++] = v;
+            });
+        }
+
+        lights.reserve(visibleSource.size());
+        for (uint32_t l : visibleSource) lights.push_back(source[l]);
+
+        stats.visible = static_cast<uint32_t>(lights.size());
+        stats.indices = offset;
+        stats.binMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "servers/rendering/RenderPacket.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // CLUSTERED LIGHTS
+    // The camera frustum is cut into a froxel grid: CLUSTER_X by
+    // CLUSTER_Y screen tiles and CLUSTER_Z depth slices, spaced
+    // exponentially so a near slice and a far one cover similar
+    // shares of the screen. Every point light is listed in each
+    // cluster its sphere's screen box and depth range reach; a
+    // fragment finds its cluster from its clip position and shades
+    // only the lights listed there, so the cost follows the lights
+    // that overlap a pixel, not the lights in the scene.
+    // =========================================================
+
+    static constexpr uint32_t CLUSTER_X = 16;
+    static constexpr uint32_t CLUSTER_Y = 9;
+    static constexpr uint32_t CLUSTER_Z = 24;
+    static constexpr uint32_t CLUSTER_COUNT = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+    static constexpr float CLUSTER_FAR = 4000.0f;                   // The last slice runs on to infinity
+    static constexpr uint32_t MAX_POINT_LIGHTS = 8192;               // Visible ones, per frame
+    static constexpr uint32_t MAX_CLUSTER_LIGHT_INDICES = 1u << 19;  // Light references over every cluster
+
+    struct LightClusterStats {
+        uint32_t lights = 0;                    // Offered
+        uint32_t visible = 0;                   // In at least one cluster
+        uint32_t indices = 0;                   // Cluster list entries
+        uint32_t busiestCluster = 0;            // Most lights one cluster shades
+        bool truncated = false;                 // A cap was hit, some lights are missing
+        double binMs = 0.0;
+    };
+
+    class LightClusterBuilder {
+    public:
+        void Clear();
+        void Add(const PointLight& light);      // World space
+        size_t Size() const { return source.size(); }
+
+        // Bins every light added since Clear against the camera. Lights in no cluster are dropped,
+        // the others are written to lights in the order the index list refers to them.
+        // ranges gets CLUSTER_COUNT entries: x = first entry in indices, y = count.
+        LightClusterStats Build(const glm::mat4& view, const glm::mat4& proj, float zNear,
+                                std::vector<PointLight>& lights, std::vector<glm::uvec2>& ranges, std::vector<uint32_t>& indices);
+
+        // What the shaders need to find a fragment's slice: x = near, y = slices / log(far / near)
+        static glm::vec2 SliceParams(float zNear);
+
+    private:
+        struct Bounds {
+            uint16_t min[3];
+            uint16_t max[3];
+        };
+
+        std::vector<PointLight> source;
+        std::vector<float> x, y, z, radius;     // World centers and radii, SoA for the view transform
+        std::vector<float> viewX, viewY, viewDepth;
+        std::vector<Bounds> bounds;             // Per visible light, inclusive cluster ranges
+        std::vector<uint32_t> visibleSource;
+        std::vector<uint32_t> cursors;
+    };
+}
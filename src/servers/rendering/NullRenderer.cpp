@@ -0,0 +1,55 @@
+#include "NullRenderer.hpp"
+#include "modules/terrain/VoxelGenerator.hpp"
+#include <iostream>
+#include <utility>
+
+namespace Crescendo {
+
+    bool NullRenderer::initialize(DisplayServer* display) {
+        std::cout << "[NullRenderer] Headless, nothing will be drawn." << std::endl;
+        return true;
+    }
+
+    void NullRenderer::shutdown() {
+        std::cout << "[NullRenderer] Shut down after adopting " << meshCount << " meshes." << std::endl;
+    }
+
+    void NullRenderer::buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) {
+        packet.Reset();
+    }
+
+    void NullRenderer::renderPacket(RenderPacket& packet) {}
+
+    ChunkBakeResult NullRenderer::buildChunkMesh(const TerrainComputePush& pushData, bool needsCollision) {
+        ChunkBakeResult result;
+
+        // Same density field the compute shaders evaluate, on the calling worker
+        Terrain::VoxelSettings settings;
+        settings.radius = pushData.planetRadius;
+        settings.amplitude = pushData.amplitude;
+        settings.frequency = pushData.frequency;
+        settings.octaves = pushData.octaves;
+
+        Terrain::ChunkData chunk = Terrain::VoxelGenerator::GenerateChunk(pushData.chunkOrigin, pushData.resolution, pushData.chunkSize, settings, pushData.lod);
+        if (chunk.vertices.empty() || chunk.indices.empty()) return result;
+
+        result.generatedMesh.name = "CPU_Chunk";
+        result.generatedMesh.indexCount = static_cast<uint32_t>(chunk.indices.size());
+        result.generatedMesh.textureID = 0;
+        result.generatedMesh.bounds = MeshBounds::FromVertices(chunk.vertices);
+        result.hasMesh = true;
+
+        if (needsCollision) {
+            // Laid out like the GPU readback: whole vertices as floats, position first
+            const int STRIDE = sizeof(Vertex) / sizeof(float);
+            const float* rawVerts = reinterpret_cast<const float*>(chunk.vertices.data());
+            result.collisionVerts.assign(rawVerts, rawVerts + chunk.vertices.size() * STRIDE);
+            result.collisionIndices = std::move(chunk.indices);
+        }
+        return result;
+    }
+
+    int NullRenderer::adoptMesh(MeshResource&& mesh) {
+        return meshCount++;
+    }
+}
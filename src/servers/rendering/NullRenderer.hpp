@@ -0,0 +1,29 @@
+#pragma once
+#include "servers/rendering/IRenderer.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // NULL RENDERER
+    // For dedicated servers and CI runs: no window, no device, no
+    // frames. Terrain still bakes through the CPU voxel generator so
+    // planets stream and get their colliders, the meshes themselves
+    // are only counted.
+    // =========================================================
+
+    class NullRenderer : public IRenderer {
+    public:
+        NullRenderer() = default;
+        ~NullRenderer() override = default;
+
+        bool initialize(DisplayServer* display) override;
+        void shutdown() override;
+        void buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) override;
+        void renderPacket(RenderPacket& packet) override;
+        ChunkBakeResult buildChunkMesh(const TerrainComputePush& pushData, bool needsCollision) override;
+        int adoptMesh(MeshResource&& mesh) override;
+
+    private:
+        int meshCount = 0;      // Adopted meshes, IDs only mark a chunk as baked
+    };
+}
@@ -0,0 +1,121 @@
+#include "servers/rendering/PipelineCache.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "servers/rendering/vulkan/VulkanUtils.hpp"
+
+namespace Crescendo {
+
+    bool PipelineCache::Initialize(VkPhysicalDevice physicalDevice, VkDevice device, const std::string& path) {
+        this->device = device;
+        this->path = path;
+        stats = PipelineCacheStats{};
+
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        deviceHeader = FileHeader{};
+        deviceHeader.magic = FILE_MAGIC;
+        deviceHeader.version = FILE_VERSION;
+        deviceHeader.vendorID = properties.vendorID;
+        deviceHeader.deviceID = properties.deviceID;
+        deviceHeader.driverVersion = properties.driverVersion;
+        std::memcpy(deviceHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+        // --- Seed from disk ---
+        std::vector<char> data;
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (file.is_open()) {
+            size_t fileSize = static_cast<size_t>(file.tellg());
+            FileHeader header{};
+            file.seekg(0);
+            if (fileSize >= sizeof(FileHeader) && file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader))) {
+                // Compared field by field, the struct's padding is never written
+                bool match = header.magic == deviceHeader.magic && header.version == deviceHeader.version &&
+                             header.vendorID == deviceHeader.vendorID && header.deviceID == deviceHeader.deviceID &&
+                             header.driverVersion == deviceHeader.driverVersion &&
+                             std::memcmp(header.pipelineCacheUUID, deviceHeader.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+                             header.dataSize == fileSize - sizeof(FileHeader);
+                if (match) {
+                    data.resize(static_cast<size_t>(header.dataSize));
+                    if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) data.clear();
+                } else {
+                    std::cout << "[PipelineCache] " << path << " was written by another device or driver, starting cold" << std::endl;
+                }
+            }
+        }
+
+        VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.empty() ? nullptr : data.data();
+        if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+            if (data.empty()) {
+                std::cerr << "[PipelineCache] Failed to create the pipeline cache!" << std::endl;
+                return false;
+            }
+            // The driver refused the blob, a cold cache still works
+            std::cerr << "[PipelineCache] Driver rejected " << path << ", starting cold" << std::endl;
+            data.clear();
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) return false;
+        }
+
+        stats.warm = !data.empty();
+        stats.loadedBytes = data.size();
+        return true;
+    }
+
+    bool PipelineCache::Save() {
+        if (cache == VK_NULL_HANDLE) return false;
+
+        size_t size = 0;
+        if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS) return false;
+        std::vector<char> data(size);
+        if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) return false;
+        data.resize(size);
+
+        FileHeader header = deviceHeader;
+        header.dataSize = size;
+
+        // A crash mid-write leaves the old file whole
+        std::error_code error;
+        std::filesystem::path target(path);
+        if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), error);
+        std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "[PipelineCache] Could not write " << temp << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file) return false;
+        }
+        std::filesystem::rename(temp, target, error);
+        if (error) {
+            std::cerr << "[PipelineCache] Could not replace " << path << ": " << error.message() << std::endl;
+            return false;
+        }
+
+        stats.savedBytes = size;
+        return true;
+    }
+
+    void PipelineCache::Destroy() {
+        if (cache != VK_NULL_HANDLE) vkDestroyPipelineCache(device, cache, nullptr);
+        cache = VK_NULL_HANDLE;
+
+        std::lock_guard<std::mutex> lock(shaderMutex);
+        shaders.clear();
+    }
+
+    const std::vector<char>& PipelineCache::Shader(const std::string& path) {
+        // Held over the read: a shader is only ever loaded once, and they're small
+        std::lock_guard<std::mutex> lock(shaderMutex);
+        auto it = shaders.find(path);
+        if (it == shaders.end()) it = shaders.emplace(path, ReadFile(path)).first;
+        return it->second;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Crescendo {
+
+    // =========================================================
+    // PIPELINE CACHE
+    // One VkPipelineCache for every pipeline the renderer builds,
+    // saved to disk so the driver can skip compiling shaders it has
+    // already compiled on an earlier run. The file starts with the
+    // device's vendor, device, driver version and cache UUID; a file
+    // written by another GPU or driver is ignored and the cache starts
+    // cold. Pipelines are built on several threads at once, which the
+    // VkPipelineCache handles itself.
+    //
+    // It also keeps the SPIR-V of every shader it was asked for, so
+    // pipelines that share a stage read the file once.
+    // =========================================================
+
+    struct PipelineCacheStats {
+        bool warm = false;                      // The file matched this device and was loaded
+        size_t loadedBytes = 0;
+        size_t savedBytes = 0;
+    };
+
+    class PipelineCache {
+    public:
+        // Creates the cache, seeded from the file when it matches this device
+        bool Initialize(VkPhysicalDevice physicalDevice, VkDevice device, const std::string& path);
+
+        // Writes the cache's current contents next to the old file, then swaps it in
+        bool Save();
+        void Destroy();
+
+        VkPipelineCache Handle() const { return cache; }
+        const PipelineCacheStats& Stats() const { return stats; }
+
+        // SPIR-V of a shader, read on first use. Safe from any thread, the data stays put until Destroy.
+        const std::vector<char>& Shader(const std::string& path);
+
+    private:
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+            uint64_t dataSize;
+        };
+        static constexpr uint32_t FILE_MAGIC = 0x43504343;     // "CCPC"
+        static constexpr uint32_t FILE_VERSION = 1;
+
+        VkDevice device = VK_NULL_HANDLE;
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        FileHeader deviceHeader{};              // What a file has to start with to be ours
+        std::string path;
+        PipelineCacheStats stats;
+
+        std::mutex shaderMutex;
+        std::unordered_map<std::string, std::vector<char>> shaders;
+    };
+}
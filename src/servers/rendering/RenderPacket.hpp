@@ -0,0 +1,282 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <imgui.h>
+
+namespace Crescendo {
+
+    // =========================================================
+    // GPU-FACING FRAME DATA
+    // Laid out exactly as the shaders read them
+    // =========================================================
+
+    struct EntityData {
+        glm::mat4 model;                        // World matrix from TransformSystem, no per-vertex Euler rebuild
+        glm::vec4 sphereBounds;
+        glm::vec4 albedoTint;
+        glm::vec4 pbrParams;
+        glm::vec4 volumeParams;
+        glm::vec4 volumeColor;
+        glm::vec4 advancedPbr;                  // x = Clearcoat, y = CoatRough, z = Sheen, w = ormTexID
+        glm::vec4 extendedPbr;                  // x = Subsurface, y = Specular, z = SpecularTint, w = Anisotropic
+        glm::vec4 drawParams;                   // x = meshID, y = EntityDrawFlags, read by the GPU culler
+    };
+
+    // Must match the std430 layout in every shader that declares EntityData
+    static_assert(sizeof(EntityData) == 192, "EntityData layout changed, update the shaders");
+
+    // EntityData::drawParams.y, the GPU-culled views that want the row
+    enum EntityDrawFlags : uint32_t {
+        DRAW_FLAG_OPAQUE  = 1u << 0,            // Main pass
+        DRAW_FLAG_SHADOW  = 1u << 1,            // Every shadow cascade, each frame
+        DRAW_FLAG_OUTLINE = 1u << 2,            // Editor selection outline
+        DRAW_FLAG_STATIC_SHADOW = 1u << 3       // Cached shadow layers, only the ones being redrawn
+    };
+
+    struct PointLight {
+        glm::vec4 positionAndRadius;
+        glm::vec4 colorAndIntensity;
+    };
+
+    struct GlobalUniforms {
+        glm::mat4 viewProj;
+        glm::mat4 view;
+        glm::mat4 proj;
+        glm::mat4 lightSpaceMatrices[4];
+        glm::vec4 cascadeSplits;
+        glm::vec4 cameraPos;
+        glm::vec4 sunDirection;
+        glm::vec4 sunColor;
+        glm::vec4 params;
+        glm::vec4 fogColor;
+        glm::vec4 fogParams;
+        glm::vec4 skyColor;
+        glm::vec4 groundColor;
+
+        // --- CLUSTERED LIGHTS ---
+        glm::vec4 clusterParams;                // x = near, y = slices / log(far / near), z = visible lights
+        glm::uvec4 clusterGrid;                 // xyz = clusters across, down and in depth
+    };
+
+    struct AtmospherePush {
+        glm::mat4 vp;                              // 64 bytes
+        glm::vec4 sunDirection_planetRadius;       // 16 bytes
+        glm::vec4 planetCenter_atmosphereRadius;   // 16 bytes
+        glm::vec4 cameraPos_sunIntensity;          // 16 bytes
+        glm::vec4 rayleigh_mie;                    // 16 bytes
+    };
+
+    struct PostProcessPushConstants {
+       float exposure;
+       float gamma;
+       float bloomStrength;
+       float bloomThreshold;
+       float blurRadius;
+       float ssaoUVScale;
+       float ssrUVScale;
+    };
+
+    struct RenderSettings {
+        bool enableSSAO = true;
+        bool halfResSSAO = false;
+        bool enableSSR = true;
+        bool halfResSSR = false;
+        bool frustumCulling = true;             // Off draws everything, to compare against
+        bool gpuCulling = true;                 // Opaque, shadow and outline culled and drawn indirect, when the device can
+        bool shadowCache = true;                // Static casters kept in cached layers, off redraws them every frame
+    };
+
+    // =========================================================
+    // UI DRAW DATA
+    // ImGui rebuilds its draw lists on every NewFrame, so the packet
+    // keeps its own copy of the frame's UI for the render thread.
+    // Texture uploads are done before the copy, on the thread that
+    // built the frame, so the copy never carries any.
+    // =========================================================
+
+    class UIDrawData {
+    public:
+        UIDrawData() = default;
+        ~UIDrawData() { Clear(); }
+        UIDrawData(const UIDrawData&) = delete;
+        UIDrawData& operator=(const UIDrawData&) = delete;
+
+        void Capture(const ImDrawData* source) {
+            Clear();
+            if (!source || !source->Valid) return;
+
+            data.Valid = true;
+            data.DisplayPos = source->DisplayPos;
+            data.DisplaySize = source->DisplaySize;
+            data.FramebufferScale = source->FramebufferScale;
+            data.OwnerViewport = source->OwnerViewport;
+            for (ImDrawList* list : source->CmdLists) data.CmdLists.push_back(list->CloneOutput());
+            data.CmdListsCount = source->CmdListsCount;
+            data.TotalIdxCount = source->TotalIdxCount;
+            data.TotalVtxCount = source->TotalVtxCount;
+        }
+
+        void Clear() {
+            for (ImDrawList* list : data.CmdLists) IM_DELETE(list);
+            data.Clear();
+        }
+
+        ImDrawData* Get() { return data.Valid ? &data : nullptr; }
+
+    private:
+        ImDrawData data;
+    };
+
+    // =========================================================
+    // RENDER PACKET
+    // Everything one frame needs from the simulation, copied out of
+    // the scene so the render thread never reads a live entity.
+    // Built on the simulation thread, consumed by the render thread.
+    // =========================================================
+
+    struct DrawItem {
+        uint32_t meshID;
+        uint32_t entityIndex;                   // Entity SSBO row, the entity's scene index
+    };
+
+    // A run of one mesh's instances, drawn with a single instanced call. The entity rows sit in
+    // RenderPacket::instances from firstInstance on, the vertex shaders read them by gl_InstanceIndex.
+    struct DrawBatch {
+        uint32_t meshID;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+    // Render passes the mesh draws' state changes are counted in
+    enum StatePass : uint32_t {
+        STATE_PASS_SHADOW = 0,                  // Every cascade together
+        STATE_PASS_OPAQUE,                      // Opaque and terrain
+        STATE_PASS_TRANSPARENT,
+        STATE_PASS_WATER,
+        STATE_PASS_OUTLINE,
+        STATE_PASS_COUNT
+    };
+
+    // Binds that reached the command buffer, the redundant ones are skipped before it
+    struct PassStateStats {
+        uint32_t pipelines = 0;
+        uint32_t descriptorSets = 0;
+        uint32_t geometry = 0;                  // Vertex + index buffer pair of an arena page
+        uint32_t draws = 0;
+    };
+
+    // Mesh draws recorded for one packet, before and after instancing
+    struct DrawCallStats {
+        uint32_t items = 0;                     // Keyed draws of the CPU queues
+        uint32_t drawCalls = 0;                 // Instanced calls they were batched into
+        uint32_t indirectDraws = 0;             // GPU-culled mesh blocks, one indirect call each
+        double sortMs = 0.0;                    // Radix sort of the draw keys
+        PassStateStats passes[STATE_PASS_COUNT]; // Recorded by the render thread, a frame late
+    };
+
+    // One entity SSBO row that changed since the previous packet
+    struct EntityUpdate {
+        uint32_t slot;
+        EntityData data;
+    };
+
+    // One mesh's block of indirect commands, the same in every GPU-culled view
+    struct MeshDrawRange {
+        uint32_t indexCount;
+        uint32_t firstCommand;
+        uint32_t capacity;                      // Live rows using the mesh
+        uint32_t firstIndex = 0;                // Geometry arena offsets, set by the render thread
+        int32_t vertexOffset = 0;
+        uint32_t padding[3] = {};
+    };
+
+    struct AtmosphereDraw {
+        AtmospherePush push;
+        uint32_t meshID;
+    };
+
+    struct RenderPacket {
+        uint64_t frame = 0;
+        uint32_t swapchainGeneration = 0;       // Built against this swapchain, stale after a resize
+
+        // --- Camera ---
+        glm::mat4 view = glm::mat4(1.0f);
+        glm::mat4 proj = glm::mat4(1.0f);
+        glm::vec3 cameraPosition = glm::vec3(0.0f);
+        glm::vec3 cameraRight = glm::vec3(1.0f, 0.0f, 0.0f);
+        glm::vec3 cameraUp = glm::vec3(0.0f, 0.0f, 1.0f);
+
+        // --- Environment & lights ---
+        GlobalUniforms globals{};               // Camera, sun, fog, point lights and shadow cascades
+        glm::vec4 skySun = glm::vec4(0.0f);     // xyz = direction, w = intensity
+        glm::vec4 skyZenith = glm::vec4(0.0f);
+        glm::vec4 skyHorizon = glm::vec4(0.0f);
+        float shadowBiasConstant = 0.0f;
+        float shadowBiasSlope = 0.0f;
+        uint32_t shadowRebuild = 0;             // Cascades whose cached static layer is redrawn, bit per cascade
+
+        // --- Point lights ---
+        // Only the visible ones, binned into the froxel grid on the simulation thread
+        std::vector<PointLight> lights;
+        std::vector<glm::uvec2> clusterRanges;  // One per cluster: x = first entry of clusterLights, y = count
+        std::vector<uint32_t> clusterLights;    // Indices into lights
+
+        // --- Transforms & materials ---
+        // Only the changed rows: the render thread keeps every row and catches each frame in flight up
+        std::vector<EntityUpdate> entityUpdates;
+
+        // --- Instanced batches ---
+        // Culled on the simulation thread (shadow casters against each cascade), sorted by draw key
+        // and grouped by mesh, in the order the render thread records them
+        std::vector<uint32_t> instances;        // Entity rows, uploaded to the front of the instance buffer
+        std::vector<DrawBatch> opaqueBatches;   // Near to far inside each mesh
+        std::vector<DrawBatch> transparentBatches;  // One per item, back to front
+        std::vector<DrawBatch> waterBatches;
+        std::vector<DrawBatch> terrainBatches;  // Baked planet chunks
+        std::vector<DrawBatch> outlineBatches;  // Editor selection and its children
+        std::vector<DrawBatch> shadowBatches[4];        // Dynamic casters, drawn over the cached layer
+        std::vector<DrawBatch> staticShadowBatches[4];  // Static casters, only for the cascades in shadowRebuild
+        std::vector<AtmosphereDraw> atmospheres;
+
+        // --- GPU-driven draws ---
+        // Set instead of the opaque, shadow and outline batches: the render thread culls every row on the GPU
+        bool gpuCulling = false;
+        bool gpuOutline = false;                // Some row carries DRAW_FLAG_OUTLINE
+        bool gpuDynamicShadows = false;         // Some row carries DRAW_FLAG_SHADOW
+        uint32_t gpuRowCount = 0;               // Rows below this can hold a drawable entity
+        uint32_t gpuCommandsPerView = 0;
+        std::vector<MeshDrawRange> meshDraws;   // Indexed by meshID
+
+        // --- Settings ---
+        PostProcessPushConstants postProcess{};
+        RenderSettings settings;
+
+        UIDrawData ui;
+
+        void Reset() {
+            entityUpdates.clear();
+            lights.clear();
+            clusterRanges.clear();
+            clusterLights.clear();
+            instances.clear();
+            opaqueBatches.clear();
+            transparentBatches.clear();
+            waterBatches.clear();
+            terrainBatches.clear();
+            outlineBatches.clear();
+            for (std::vector<DrawBatch>& batches : shadowBatches) batches.clear();
+            for (std::vector<DrawBatch>& batches : staticShadowBatches) batches.clear();
+            atmospheres.clear();
+            shadowRebuild = 0;
+            gpuCulling = false;
+            gpuOutline = false;
+            gpuDynamicShadows = false;
+            gpuRowCount = 0;
+            gpuCommandsPerView = 0;
+            meshDraws.clear();
+            ui.Clear();
+        }
+    };
+}
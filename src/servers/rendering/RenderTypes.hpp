@@ -1,11 +1,11 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
 
-#ifndef __EMSCRIPTEN__
-    #include "vulkan/VulkanResources.hpp"
-#endif
+#include "servers/rendering/GeometryArena.hpp"
 
 namespace Crescendo {
     
@@ -19,13 +19,55 @@ namespace Crescendo {
         typedef Crescendo::VulkanBuffer GPUBufferHandle; 
     #endif
 
+    // --- MESH BOUNDS ---
+    // Object space, computed once when the mesh is created. The sphere is what
+    // the culler and the spatial index test, the box is kept for tighter tests.
+    struct MeshBounds {
+        glm::vec3 min = glm::vec3(0.0f);
+        glm::vec3 max = glm::vec3(0.0f);
+        glm::vec4 sphere = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);     // xyz center + w radius, negative = no bounds
+
+        bool IsValid() const { return sphere.w >= 0.0f; }
+
+        // Sphere around the box center, out to the farthest vertex
+        template <typename VertexType>
+        static MeshBounds FromVertices(const std::vector<VertexType>& vertices) {
+            MeshBounds bounds;
+            if (vertices.empty()) return bounds;
+
+            bounds.min = bounds.max = vertices[0].pos;
+            for (const VertexType& v : vertices) {
+                bounds.min = glm::min(bounds.min, v.pos);
+                bounds.max = glm::max(bounds.max, v.pos);
+            }
+
+            glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+            float radiusSq = 0.0f;
+            for (const VertexType& v : vertices) {
+                glm::vec3 d = v.pos - center;
+                radiusSq = std::max(radiusSq, glm::dot(d, d));
+            }
+            bounds.sphere = glm::vec4(center, std::sqrt(radiusSq));
+            return bounds;
+        }
+
+        // For geometry that never reaches the CPU (GPU-baked terrain), the box it was built in
+        static MeshBounds FromBox(const glm::vec3& boxMin, const glm::vec3& boxMax) {
+            MeshBounds bounds;
+            bounds.min = boxMin;
+            bounds.max = boxMax;
+            bounds.sphere = glm::vec4((boxMin + boxMax) * 0.5f, glm::length(boxMax - boxMin) * 0.5f);
+            return bounds;
+        }
+    };
+
     struct MeshResource {
        
         std::string name;
-        GPUBufferHandle vertexBuffer;
-        GPUBufferHandle indexBuffer; 
+        GeometryAllocation geometry;        // Vertices and indices inside the geometry arena
         uint32_t indexCount;
         uint32_t textureID; // 0 default
+        MeshBounds bounds;
 
         MeshResource() = default;
         MeshResource(const MeshResource&) = delete;
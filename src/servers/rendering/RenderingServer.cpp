@@ -11,14 +11,22 @@
 #include "deps/vk_mem_alloc.h"
 
 #include <array>
+#include <chrono>
+#include <map>
 #include <set>
+#include <thread>
 #include "scene/Scene.hpp"
 #include "scene/components/ProceduralPlanetComponent.hpp"
+#include "scene/components/PointLightComponent.hpp"
+#include "scene/TransformSystem.hpp"
+#include "core/Profiler.hpp"
+#include "core/JobSystem.hpp"
 #include <cstring>
 #include <fstream>
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "modules/image/ImageLoader.hpp"
 #include <SDL2/SDL_vulkan.h>
@@ -39,23 +47,13 @@
 
 
 namespace Crescendo {
-    
-    static std::vector<char> readFile(const std::string& filename) {
-        std::ifstream file(filename, std::ios::ate | std::ios::binary);
-        if (!file.is_open()) throw std::runtime_error("failed to open file: " + filename);
-        size_t fileSize = (size_t) file.tellg();
-        std::vector<char> buffer(fileSize);
-        file.seekg(0);
-        file.read(buffer.data(), fileSize);
-        file.close();
-        return buffer;
-    }
 
     RenderingServer::RenderingServer() {
         // Empty! 
     }
 
     bool RenderingServer::initialize(DisplayServer* display) {
+        auto startupStart = std::chrono::steady_clock::now();
         this->display_ref = display;
         this->window = display->get_window(); 
 
@@ -102,17 +100,28 @@ namespace Crescendo {
             return false;
         }
 
+        if (!pipelineCache.Initialize(physicalDevice, device, "cache/pipeline_cache.bin")) return false;
+
         std::cout << "[2/5] Setting up Command Infrastructure..." << std::endl;
         if (!createSwapChain()) return false;
         if (!createImageViews()) return false;
         if (!createRenderPass()) return false;
         if (!createCommandPool()) return false;
+        {
+            QueueFamilyIndices families = findQueueFamilies(physicalDevice);
+            uint32_t graphicsFamily = families.graphicsFamily.value();
+            uint32_t transferFamily = families.transferFamily.value_or(graphicsFamily);
+            // A queue of its own needs no lock, the graphics queue is shared with the frame
+            if (!uploads.Initialize(device, allocator, transferQueue, transferFamily, graphicsFamily, MAX_FRAMES_IN_FLIGHT,
+                                    transferFamily == graphicsFamily ? &queueMutex : nullptr)) return false;
+        }
         if (!createDepthResources()) return false;
         if (!createTextureSampler()) return false;
         if (!createDescriptorSetLayout()) return false;
         if (!createDescriptorPool()) return false;
         createStorageBuffers(); 
         createGlobalUniformBuffer();
+        geometryArena.Initialize(allocator, sizeof(Vertex));
         if (!createShadowResources()) return false; 
         if (!createTextureImage()) return false; 
         createTextureImage("assets/textures/speakersymbol.png", speakerTexture);
@@ -138,6 +147,7 @@ namespace Crescendo {
         // ---------------------------------------------------------
         if (!createViewportResources()) return false;
         if (!createDescriptorSets()) return false; 
+        if (!createGpuCullingPipelines()) return false;
         
         // --- UI & Viewport ---
         QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
@@ -150,25 +160,33 @@ namespace Crescendo {
 
         // --- Graphics Pipelines ---
         // Pass transparentRenderPass because it perfectly supports 4x MSAA without erasing the screen!
-        symbolServer.Initialize(device, transparentRenderPass, descriptorSetLayout, symbolTextureLayout);
-        if (!createGraphicsPipeline()) return false;
-        if (!createWaterPipeline()) return false;       
-        if (!createAtmospherePipeline()) return false; 
-        if (!createTransparentPipeline()) return false;
-        if (!createOpaquePipeline()) return false;
-        if (!createBloomPipeline()) return false;
-        if (!createCompositePipeline()) return false;
-        if (!createShadowPipeline()) return false;
-        if (!createSSRPipeline()) return false;
+        symbolServer.Initialize(device, transparentRenderPass, descriptorSetLayout, symbolTextureLayout, pipelineCache.Handle());
+        if (!createPipelineLayouts()) return false;
 
         // --- Bakerline ---
         if (!createBakeRenderPass()) return false;
         if (!createBakeFramebuffer()) return false;
-        if (!createBakePipeline()) return false;
-        
-        // --- wireframe view ---
-        if (!createOutlinePipeline()) return false;
+
+        // Every layout and render pass exists now, the builders only add their own pipelines
+        std::vector<PipelineBuild> builds = {
+            { "Graphics", &RenderingServer::createGraphicsPipeline },
+            { "Water", &RenderingServer::createWaterPipeline },
+            { "Atmosphere", &RenderingServer::createAtmospherePipeline },
+            { "Transparent", &RenderingServer::createTransparentPipeline },
+            { "Opaque", &RenderingServer::createOpaquePipeline },
+            { "Bloom", &RenderingServer::createBloomPipeline },
+            { "Composite", &RenderingServer::createCompositePipeline },
+            { "Shadow", &RenderingServer::createShadowPipeline },
+            { "SSR", &RenderingServer::createSSRPipeline },
+            { "Bake", &RenderingServer::createBakePipeline },
+            { "Outline", &RenderingServer::createOutlinePipeline },     // --- wireframe view ---
+        };
         // if (!createBillboardPipeline()) return false;
+        auto pipelineStart = std::chrono::steady_clock::now();
+        if (!buildPipelines(builds)) return false;
+        double pipelineMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pipelineStart).count();
+        std::cout << "[RenderingServer] " << builds.size() << " pipelines built in " << pipelineMs << " ms ("
+                  << (pipelineCache.Stats().warm ? "warm" : "cold") << " cache)" << std::endl;
        
         if (!createFramebuffers()) return false;
 
@@ -182,8 +200,11 @@ namespace Crescendo {
         updateCompositeDescriptors();
         updateSSRDescriptors();
 
-        mainCamera.SetPosition(glm::vec3(0.0f, -10.0f, 5.0f)); 
-        mainCamera.SetRotation(glm::vec3(25.0f, 0.0f, 0.0f)); 
+        // Saved now as well as at shutdown, so a run that crashes still leaves tomorrow's start warm
+        pipelineCache.Save();
+        double startupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupStart).count();
+        std::cout << "[RenderingServer] Startup took " << startupMs << " ms, pipeline cache "
+                  << (pipelineCache.Stats().warm ? "warm" : "cold") << " (" << pipelineCache.Stats().loadedBytes << " bytes loaded)" << std::endl;
 
         std::cout << ">>> ENGINE READY! <<<" << std::endl;
         return true;
@@ -414,7 +435,7 @@ namespace Crescendo {
         imageInfo.format = VK_FORMAT_D32_SFLOAT;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
@@ -531,6 +552,67 @@ namespace Crescendo {
 
             vkCreateFramebuffer(device, &fbInfo, nullptr, &shadowFramebuffers[i]);
         }
+
+        // 7. Static Caster Cache (same layers, only ever rendered into and copied from)
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        shadowCacheImage.allocator = allocator;
+        if (vmaCreateImage(allocator, &imageInfo, &allocInfo, &shadowCacheImage.handle, &shadowCacheImage.allocation, nullptr) != VK_SUCCESS) {
+            return false;
+        }
+
+        shadowCacheViews.resize(SHADOW_CASCADES);
+        for (uint32_t i = 0; i < SHADOW_CASCADES; i++) {
+            VkImageViewCreateInfo layerInfo = viewInfo;
+            layerInfo.image = shadowCacheImage.handle;
+            layerInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            layerInfo.subresourceRange.baseArrayLayer = i;
+            layerInfo.subresourceRange.layerCount = 1;
+            if (vkCreateImageView(device, &layerInfo, nullptr, &shadowCacheViews[i]) != VK_SUCCESS) return false;
+        }
+
+        // Both passes are compatible with the shadow pass (one D32 attachment), so they share its pipeline
+        auto createDepthPass = [&](VkAttachmentLoadOp loadOp, VkImageLayout initialLayout, VkImageLayout finalLayout,
+                                   const std::array<VkSubpassDependency, 2>& passDependencies, VkRenderPass& pass) {
+            VkAttachmentDescription depthAttachment = attachment;
+            depthAttachment.loadOp = loadOp;
+            depthAttachment.initialLayout = initialLayout;
+            depthAttachment.finalLayout = finalLayout;
+
+            VkRenderPassCreateInfo passInfo = renderPassInfo;
+            passInfo.pAttachments = &depthAttachment;
+            passInfo.dependencyCount = static_cast<uint32_t>(passDependencies.size());
+            passInfo.pDependencies = passDependencies.data();
+            return vkCreateRenderPass(device, &passInfo, nullptr, &pass) == VK_SUCCESS;
+        };
+
+        VkPipelineStageFlags depthStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        VkAccessFlags depthAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        // Cache: earlier copies out of the layer finish first, the copy after waits for the depth writes
+        std::array<VkSubpassDependency, 2> cacheDependencies = {};
+        cacheDependencies[0] = { VK_SUBPASS_EXTERNAL, 0, VK_PIPELINE_STAGE_TRANSFER_BIT, depthStages, VK_ACCESS_TRANSFER_READ_BIT, depthAccess, 0 };
+        cacheDependencies[1] = { 0, VK_SUBPASS_EXTERNAL, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, 0 };
+        if (!createDepthPass(VK_ATTACHMENT_LOAD_OP_CLEAR, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, cacheDependencies, shadowCacheRenderPass)) return false;
+
+        // Compose: tests against the copied static depth, the scene samples the result
+        std::array<VkSubpassDependency, 2> composeDependencies = {};
+        composeDependencies[0] = { VK_SUBPASS_EXTERNAL, 0, VK_PIPELINE_STAGE_TRANSFER_BIT, depthStages, VK_ACCESS_TRANSFER_WRITE_BIT, depthAccess, 0 };
+        composeDependencies[1] = { 0, VK_SUBPASS_EXTERNAL, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                   VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, 0 };
+        if (!createDepthPass(VK_ATTACHMENT_LOAD_OP_LOAD, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, composeDependencies, shadowComposeRenderPass)) return false;
+
+        shadowCacheFramebuffers.resize(SHADOW_CASCADES);
+        for (size_t i = 0; i < SHADOW_CASCADES; i++) {
+            VkFramebufferCreateInfo fbInfo{VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+            fbInfo.renderPass = shadowCacheRenderPass;
+            fbInfo.attachmentCount = 1;
+            fbInfo.pAttachments = &shadowCacheViews[i];
+            fbInfo.width = SHADOW_DIM;
+            fbInfo.height = SHADOW_DIM;
+            fbInfo.layers = 1;
+            if (vkCreateFramebuffer(device, &fbInfo, nullptr, &shadowCacheFramebuffers[i]) != VK_SUCCESS) return false;
+        }
         
         return true;
         }
@@ -558,98 +640,26 @@ namespace Crescendo {
         globalData.cascadeSplits = glm::vec4(cascadeLevels[1], cascadeLevels[2], cascadeLevels[3], cascadeLevels[4]);
 
         glm::vec3 lightDir = glm::normalize(glm::vec3(scene->environment.sunDirection));
+        glm::mat4 view = camera.GetViewMatrix();
+        ShadowCacheSettings cacheSettings{ config.shadowCacheMargin, config.shadowCacheSunAngle };
 
-        for (uint32_t i = 0; i < 4; i++) {
-            float nearPlane = cascadeLevels[i];
-            float farPlane  = cascadeLevels[i + 1];
-
-            glm::mat4 proj = glm::perspective(glm::radians(camera.fov), aspectRatio, nearPlane, farPlane);
-            glm::mat4 view = camera.GetViewMatrix();
-            glm::mat4 invCam = glm::inverse(proj * view);
-
-            std::vector<glm::vec3> frustumCorners;
-            for (int x = 0; x < 2; ++x) {
-                for (int y = 0; y < 2; ++y) {
-                    for (int z = 0; z < 2; ++z) {
-                        glm::vec4 pt = invCam * glm::vec4(2.0f * x - 1.0f, 2.0f * y - 1.0f, 2.0f * z - 1.0f, 1.0f);
-                        frustumCorners.push_back(glm::vec3(pt) / pt.w);
-                    }
-                }
-            }
-
-            glm::vec3 center = glm::vec3(0.0f);
-            for (const auto& v : frustumCorners) {
-                center += v;
-            }
-            center /= frustumCorners.size();
-
-            // --- THE FIX ---
-            // 1. Provide a safe "Up" vector so lookAt doesn't flip out when the sun is straight up
-            glm::vec3 up = glm::vec3(0.0f, 0.0f, 1.0f);
-            if (std::abs(lightDir.z) > 0.999f) {
-                up = glm::vec3(0.0f, 1.0f, 0.0f); 
-            }
-
-            // 2. Position the camera AT the sun (+lightDir) looking DOWN at the center!
-            glm::mat4 lightView = glm::lookAt(center + lightDir, center, up);
-
-            float minX = std::numeric_limits<float>::max();
-            float maxX = std::numeric_limits<float>::lowest();
-            float minY = std::numeric_limits<float>::max();
-            float maxY = std::numeric_limits<float>::lowest();
-            float minZ = std::numeric_limits<float>::max();
-            float maxZ = std::numeric_limits<float>::lowest();
-
-            for (const auto& v : frustumCorners) {
-                glm::vec4 trf = lightView * glm::vec4(v, 1.0f);
-                minX = std::min(minX, trf.x);
-                maxX = std::max(maxX, trf.x);
-                minY = std::min(minY, trf.y);
-                maxY = std::max(maxY, trf.y);
-                minZ = std::min(minZ, trf.z);
-                maxZ = std::max(maxZ, trf.z);
-            }
-
-            // 3. Texel snapping to stabilize the shadow map edges
-            float worldUnitsPerTexel = (maxX - minX) / SHADOW_DIM;
-            minX = std::floor(minX / worldUnitsPerTexel) * worldUnitsPerTexel;
-            maxX = std::floor(maxX / worldUnitsPerTexel) * worldUnitsPerTexel;
-            minY = std::floor(minY / worldUnitsPerTexel) * worldUnitsPerTexel;
-            maxY = std::floor(maxY / worldUnitsPerTexel) * worldUnitsPerTexel;
-
-            // 4. Brute-force the light frustum depth to catch ALL shadow casters!
-            // This completely fixes the shadows popping out when you look down.
-            minZ -= 2000.0f;
-            maxZ += 2000.0f;
-            
-            glm::mat4 lightProj = glm::ortho(minX, maxX, minY, maxY, minZ, maxZ);
-
-            globalData.lightSpaceMatrices[i] = lightProj * lightView;
+        // Sphere-fit and texel-snapped, a cascade only moves when its slice drifts out of the margin
+        for (uint32_t i = 0; i < SHADOW_CASCADES; i++) {
+            glm::mat4 proj = glm::perspective(glm::radians(camera.fov), aspectRatio, cascadeLevels[i], cascadeLevels[i + 1]);
+            globalData.lightSpaceMatrices[i] = shadowCache.Fit(i, glm::inverse(proj * view), lightDir, SHADOW_DIM, cacheSettings);
         }
     }
 
     VulkanImage RenderingServer::UploadTexture(void* pixels, int width, int height, VkFormat format) {
         VkDeviceSize imageSize = width * height * 4;
 
-        // 1. Create Staging Buffer (RAII handles create & destroy)
-        VulkanBuffer stagingBuffer(allocator, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                                   VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
-
-        // 2. Map & Copy
-        void* data;
-        vmaMapMemory(allocator, stagingBuffer.allocation, &data);
-        memcpy(data, pixels, (size_t)imageSize);
-        vmaUnmapMemory(allocator, stagingBuffer.allocation);
-
-        // 3. Create Target Image (RAII handles Image & View creation)
+        // 1. Create Target Image (RAII handles Image & View creation)
         VulkanImage newImage(allocator, device, width, height, format, 
                              VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 
                              VK_IMAGE_ASPECT_COLOR_BIT);
 
-        // 4. Copy (Transitions & Blit)
-        transitionImageLayout(newImage.handle, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        copyBufferToImage(stagingBuffer.handle, newImage.handle, width, height);
-        transitionImageLayout(newImage.handle, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        // 2. Through the staging ring; it is SHADER_READ_ONLY by the first frame that can sample it
+        uploads.UploadImage(newImage.handle, static_cast<uint32_t>(width), static_cast<uint32_t>(height), pixels, imageSize);
 
         return newImage; // Transfers ownership to caller
     }
@@ -725,6 +735,7 @@ namespace Crescendo {
     }
 
     void RenderingServer::loadSkybox(const std::string& path, Scene* scene) {
+        std::lock_guard<std::mutex> resources(resourceMutex);
         vkDeviceWaitIdle(device); 
 
         // Use the Compute GPU Baker!
@@ -768,15 +779,12 @@ namespace Crescendo {
                     scene->environment.sunIntensity = sunInt;
 
                     // Update UI Entity
-                    for (auto* ent : scene->entities) {
-                        if (ent && ent->className == "env_sky") {
-                            ent->albedoColor = sunColor;
-                            ent->emission = sunInt; 
-                            float pitch = std::asin(sunDir.z);
-                            float yaw = std::atan2(sunDir.y, sunDir.x);
-                            ent->angles = glm::degrees(glm::vec3(pitch, 0.0f, yaw));
-                            break;
-                        }
+                    if (CBaseEntity* ent = scene->FirstOfClass(CLASS_ENV_SKY)) {
+                        ent->Material().albedoColor = sunColor;
+                        ent->Material().emission = sunInt; 
+                        float pitch = std::asin(sunDir.z);
+                        float yaw = std::atan2(sunDir.y, sunDir.x);
+                        ent->SetAngles(glm::degrees(glm::vec3(pitch, 0.0f, yaw)));
                     }
                     std::cout << "[Engine] HDR Sun Extracted -> Intensity: " << sunInt << std::endl;
                 }
@@ -903,12 +911,31 @@ namespace Crescendo {
         depthBinding.pImmutableSamplers = nullptr;
         depthBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
+        // Binding 10: Instances (entity row per gl_InstanceIndex)
+        VkDescriptorSetLayoutBinding instanceBinding{};
+        instanceBinding.binding = 10;
+        instanceBinding.descriptorCount = 1;
+        instanceBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        instanceBinding.pImmutableSamplers = nullptr;
+        instanceBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+        // Binding 11-13: Clustered point lights (lights, per-cluster ranges, the ranges' light indices)
+        std::array<VkDescriptorSetLayoutBinding, 3> clusterBindings{};
+        for (uint32_t b = 0; b < clusterBindings.size(); b++) {
+            clusterBindings[b].binding = 11 + b;
+            clusterBindings[b].descriptorCount = 1;
+            clusterBindings[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            clusterBindings[b].pImmutableSamplers = nullptr;
+            clusterBindings[b].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        }
+
 
         globalBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
         
-        std::array<VkDescriptorSetLayoutBinding, 10> bindings = { 
+        std::array<VkDescriptorSetLayoutBinding, 14> bindings = { 
             samplerLayoutBinding, skyLayoutBinding, ssboBinding, globalBinding, 
-            shadowBinding, refractionBinding, irradianceBinding, prefilterBinding, brdfBinding, depthBinding 
+            shadowBinding, refractionBinding, irradianceBinding, prefilterBinding, brdfBinding, depthBinding,
+            instanceBinding, clusterBindings[0], clusterBindings[1], clusterBindings[2]
         };
 
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
@@ -1014,9 +1041,9 @@ namespace Crescendo {
        poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
        poolSizes[1].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * (MAX_TEXTURES + 10) + 100); 
 
-       // 3. Storage Buffers (Entity Data)
+       // 3. Storage Buffers (Entity Data, instances, light clusters, terrain compute, GPU culling: 6 per frame + the pyramid)
        poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-       poolSizes[2].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 5);
+       poolSizes[2].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 15 + 4);
 
        // 4. STORAGE IMAGES (Compute Shader IBL Bakers)
        poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
@@ -1182,10 +1209,41 @@ namespace Crescendo {
             depthWrite.descriptorCount = 1;
             depthWrite.pImageInfo = &depthInfo;
 
-            // Update the array size to 10 and add depthWrite to the end
-            std::array<VkWriteDescriptorSet, 10> writes = {
+            // 10 Instances, this frame's
+            VkDescriptorBufferInfo instanceInfo{};
+            instanceInfo.buffer = instanceBuffers[i].handle;
+            instanceInfo.offset = 0;
+            instanceInfo.range = VK_WHOLE_SIZE;
+
+            VkWriteDescriptorSet instanceWrite{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+            instanceWrite.dstSet = descriptorSets[i];
+            instanceWrite.dstBinding = 10;
+            instanceWrite.dstArrayElement = 0;
+            instanceWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            instanceWrite.descriptorCount = 1;
+            instanceWrite.pBufferInfo = &instanceInfo;
+
+            // 11-13 Clustered lights, this frame's
+            VkDescriptorBufferInfo clusterInfos[3] = {
+                { lightBuffers[i].handle, 0, VK_WHOLE_SIZE },
+                { clusterRangeBuffers[i].handle, 0, VK_WHOLE_SIZE },
+                { clusterLightBuffers[i].handle, 0, VK_WHOLE_SIZE }
+            };
+            VkWriteDescriptorSet clusterWrites[3];
+            for (uint32_t b = 0; b < 3; b++) {
+                clusterWrites[b] = VkWriteDescriptorSet{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+                clusterWrites[b].dstSet = descriptorSets[i];
+                clusterWrites[b].dstBinding = 11 + b;
+                clusterWrites[b].dstArrayElement = 0;
+                clusterWrites[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                clusterWrites[b].descriptorCount = 1;
+                clusterWrites[b].pBufferInfo = &clusterInfos[b];
+            }
+
+            std::array<VkWriteDescriptorSet, 14> writes = {
                 descriptorWrite, skyWrite, ssboWrite, globalWrite, shadowWrite, refWrite,
-                irradianceWrite, prefilterWrite, brdfWrite, depthWrite
+                irradianceWrite, prefilterWrite, brdfWrite, depthWrite, instanceWrite,
+                clusterWrites[0], clusterWrites[1], clusterWrites[2]
             };
             vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
             
@@ -1239,6 +1297,8 @@ namespace Crescendo {
     }
 
     int RenderingServer::acquireMesh(const std::string& path, const std::string& name, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        std::lock_guard<std::mutex> resources(resourceMutex);
+
         // 1. Check cache first (unless it's a dynamic procedural mesh)
         if (path != "PROCEDURAL" && cache.meshes.find(path) != cache.meshes.end()) {
             return cache.meshes[path];
@@ -1249,10 +1309,10 @@ namespace Crescendo {
         newMesh.name = name;
         newMesh.indexCount = static_cast<uint32_t>(indices.size());
         
-        // 3. Send the raw vertices/indices to the Vulkan GPU buffers
-        newMesh.vertexBuffer = createVertexBuffer(vertices);
-        newMesh.indexBuffer = createIndexBuffer(indices);
+        // 3. Send the raw vertices/indices to their range of the geometry arena
+        newMesh.geometry = uploadGeometry(vertices, indices);
         newMesh.textureID = 0; // Default white texture
+        newMesh.bounds = MeshBounds::FromVertices(vertices);
 
         // 4. Store it in the engine's master list
         int meshID = static_cast<int>(meshes.size());
@@ -1267,7 +1327,70 @@ namespace Crescendo {
         return meshID;
     }
 
+    int RenderingServer::adoptMesh(MeshResource&& mesh) {
+        std::lock_guard<std::mutex> resources(resourceMutex);
+        meshes.push_back(std::move(mesh));
+        return static_cast<int>(meshes.size() - 1);
+    }
+
+    void RenderingServer::releaseMesh(int meshID) {
+        std::lock_guard<std::mutex> resources(resourceMutex);
+        if (meshID < 0 || meshID >= static_cast<int>(meshes.size())) return;
+
+        MeshResource& mesh = meshes[meshID];
+        if (!mesh.geometry.IsValid()) return;
+
+        // The ID stays taken so nothing else shifts, it just draws nothing from now on.
+        // Frames in flight may still read the range, it goes back to the arena once they retire.
+        retiredGeometry.push_back({ renderedFrames, mesh.geometry });
+        mesh.geometry = GeometryAllocation{};
+        mesh.indexCount = 0;
+
+        for (auto it = cache.meshes.begin(); it != cache.meshes.end();) {
+            if (it->second == meshID) {
+                meshMap.erase(it->first);
+                it = cache.meshes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void RenderingServer::compactGeometry() {
+        // No recording, no new meshes, and (after the copy's wait) no frame still reading the old pages
+        std::lock_guard<std::mutex> resources(resourceMutex);
+
+        std::vector<GeometryAllocation*> live;
+        live.reserve(meshes.size());
+        for (MeshResource& mesh : meshes) {
+            if (mesh.geometry.IsValid()) live.push_back(&mesh.geometry);
+        }
+
+        GeometryArenaStats before = geometryArena.Stats();
+
+        // Copies still headed for the old pages land first, and become the graphics queue's to move
+        uploads.WaitIdle();
+
+        VkCommandPool localPool;
+        VkCommandBuffer cmd = beginAsyncCommands(localPool);
+        uploads.RecordAcquires(cmd);
+        std::vector<VulkanBuffer> retired = geometryArena.Compact(cmd, live);
+        endAsyncCommands(cmd, localPool);
+
+        {
+            // Frames submitted before the lock may still read the old pages
+            std::lock_guard<std::mutex> lock(queueMutex);
+            vkQueueWaitIdle(graphicsQueue);
+        }
+        retired.clear();
+
+        GeometryArenaStats after = geometryArena.Stats();
+        std::cout << "[Geometry] Compacted " << before.freeRanges << " free ranges into " << after.freeRanges << "." << std::endl;
+    }
+
     int RenderingServer::acquireTexture(const std::string& path) {
+        std::lock_guard<std::mutex> resources(resourceMutex);
+
         if (cache.textures.find(path) != cache.textures.end()) {
             return cache.textures[path];
         }
@@ -1331,9 +1454,66 @@ namespace Crescendo {
     // PIPELINE LOGIC
     //===============================================
 
+    bool RenderingServer::createPipelineLayouts() {
+        // Shared by several builders, made up front so the builders can run side by side
+        VkPushConstantRange pushConstant{};
+        pushConstant.offset = 0;
+        
+        // [FIX] Change this from sizeof(PushConsts) to 128.
+        // The Skybox uses this same layout and needs 64 bytes.
+        // If this is too small, the Skybox crashes and the Entity ID gets corrupted.
+        pushConstant.size = 128; 
+        
+        pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout; 
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) return false;
+
+        // [FIX] Ensure Layout has Push Constants (even if unused by Bloom)
+        // This makes it compatible with the Composite Pass which DOES use them.
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PostProcessPushConstants);
+
+        VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &postProcessLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+        return vkCreatePipelineLayout(device, &layoutInfo, nullptr, &compositePipelineLayout) == VK_SUCCESS;
+    }
+
+    bool RenderingServer::buildPipelines(const std::vector<PipelineBuild>& builds) {
+        std::vector<uint8_t> built(builds.size(), 0);
+        JobSystem::Get().ParallelFor(builds.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                // A missing shader throws, keep it from taking a worker down with it
+                try {
+                    built[i] = (this->*builds[i].create)() ? 1 : 0;
+                } catch (const std::exception& e) {
+                    std::cerr << "[RenderingServer] " << builds[i].name << " pipeline: " << e.what() << std::endl;
+                }
+            }
+        });
+
+        bool ok = true;
+        for (size_t i = 0; i < builds.size(); i++) {
+            if (built[i]) continue;
+            std::cerr << "[RenderingServer] Failed to build the " << builds[i].name << " pipeline!" << std::endl;
+            ok = false;
+        }
+        return ok;
+    }
+
     bool RenderingServer::createGraphicsPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/shader.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/shader.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/shader.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/shader.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -1442,28 +1622,6 @@ namespace Crescendo {
         dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
         dynamicState.pDynamicStates = dynamicStates.data();
 
-        VkPushConstantRange pushConstant{};
-        pushConstant.offset = 0;
-        
-        // [FIX] Change this from sizeof(PushConsts) to 128.
-        // The Skybox uses this same layout and needs 64 bytes.
-        // If this is too small, the Skybox crashes and the Entity ID gets corrupted.
-        pushConstant.size = 128; 
-        
-        pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 1;
-        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout; 
-        pipelineLayoutInfo.pushConstantRangeCount = 1;
-        pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
-        
-        // --- ONLY CREATE IF IT DOESN'T EXIST YET ---
-        if (pipelineLayout == VK_NULL_HANDLE) {
-            if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) return false;
-        }
-
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         pipelineInfo.stageCount = 2;
@@ -1480,10 +1638,10 @@ namespace Crescendo {
         pipelineInfo.renderPass = viewportRenderPass;
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) return false;
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) return false;
 
-        auto skyVertCode = readFile("assets/shaders/sky.vert.spv");
-        auto skyFragCode = readFile("assets/shaders/sky.frag.spv");
+        const auto& skyVertCode = pipelineCache.Shader("assets/shaders/sky.vert.spv");
+        const auto& skyFragCode = pipelineCache.Shader("assets/shaders/sky.frag.spv");
         VkShaderModule skyVertShaderModule = createShaderModule(skyVertCode);
         VkShaderModule skyFragShaderModule = createShaderModule(skyFragCode);
         
@@ -1514,7 +1672,7 @@ namespace Crescendo {
         pipelineInfo.subpass = 0;
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &skyPipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &skyPipeline) != VK_SUCCESS) {
             throw std::runtime_error("failed to create sky pipeline");
         }
         vkDestroyShaderModule(device, skyVertShaderModule, nullptr);
@@ -1527,8 +1685,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createTransparentPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/shader.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/transparent.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/shader.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/transparent.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -1636,7 +1794,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = viewportRenderPass;
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &transparentPipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &transparentPipeline) != VK_SUCCESS) {
             return false;
         }
 
@@ -1648,8 +1806,8 @@ namespace Crescendo {
 
     bool RenderingServer::createOpaquePipeline() {
         // --- 1. SHADER MODULES ---
-        auto vertShaderCode = readFile("assets/shaders/shader.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/opaque.frag.spv"); 
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/shader.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/opaque.frag.spv"); 
         
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -1743,7 +1901,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = viewportRenderPass; 
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &opaquePipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &opaquePipeline) != VK_SUCCESS) {
             return false;
         }
 
@@ -1754,8 +1912,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createWaterPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/water.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/water.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/water.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/water.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -1860,7 +2018,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = viewportRenderPass;
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &waterPipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &waterPipeline) != VK_SUCCESS) {
              return false;
         }
 
@@ -1871,8 +2029,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createAtmospherePipeline() {
-        auto vertShaderCode = readFile("assets/shaders/atmosphere.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/atmosphere.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/atmosphere.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/atmosphere.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -1961,7 +2119,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = viewportRenderPass;
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &atmospherePipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &atmospherePipeline) != VK_SUCCESS) {
             return false;
         }
 
@@ -1971,8 +2129,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createCompositePipeline() {
-        auto vertShaderCode = readFile("assets/shaders/fullscreen_vert.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/bloom_composite.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/fullscreen_vert.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/bloom_composite.frag.spv");
         
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -2002,23 +2160,6 @@ namespace Crescendo {
         
         std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
         VkPipelineDynamicStateCreateInfo dynamicState{VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO, nullptr, 0, (uint32_t)dynamicStates.size(), dynamicStates.data()};
-        
-        if (compositePipelineLayout == VK_NULL_HANDLE) {
-            VkPushConstantRange pushConstantRange{};
-            pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-            pushConstantRange.offset = 0;
-            pushConstantRange.size = sizeof(PostProcessPushConstants);
-
-            VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
-            layoutInfo.setLayoutCount = 1;
-            layoutInfo.pSetLayouts = &postProcessLayout;
-            layoutInfo.pushConstantRangeCount = 1;
-            layoutInfo.pPushConstantRanges = &pushConstantRange;
-
-            if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &compositePipelineLayout) != VK_SUCCESS) {
-                return false;
-            }
-        }
     
         VkGraphicsPipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
         pipelineInfo.stageCount = 2;
@@ -2035,7 +2176,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = compositeRenderPass; 
         pipelineInfo.subpass = 0;
     
-        VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &compositePipeline);
+        VkResult result = vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &compositePipeline);
         
         vkDestroyShaderModule(device, fragShaderModule, nullptr);
         vkDestroyShaderModule(device, vertShaderModule, nullptr);
@@ -2044,7 +2185,7 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createShadowPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/shadow.vert.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/shadow.vert.spv");
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         
         VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
@@ -2117,7 +2258,7 @@ namespace Crescendo {
         VkPushConstantRange pushConstant{};
         pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; // Only Vertex needed
         pushConstant.offset = 0;
-        pushConstant.size = sizeof(ShadowPushConsts); // 64 (mat4) + 4 (uint)
+        pushConstant.size = sizeof(ShadowPushConsts); // 64 (mat4)
     
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -2144,15 +2285,15 @@ namespace Crescendo {
         pipelineInfo.renderPass = shadowRenderPass;
         pipelineInfo.subpass = 0;
     
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &shadowPipeline) != VK_SUCCESS) return false;
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &shadowPipeline) != VK_SUCCESS) return false;
     
         vkDestroyShaderModule(device, vertShaderModule, nullptr);
         return true;
     }
 
     bool RenderingServer::createSSRPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/fullscreen_vert.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/ssr.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/fullscreen_vert.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/ssr.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -2213,7 +2354,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = ssrRenderPass;
         pipelineInfo.subpass = 0;
 
-        VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &ssrPipeline);
+        VkResult result = vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &ssrPipeline);
 
         vkDestroyShaderModule(device, fragShaderModule, nullptr);
         vkDestroyShaderModule(device, vertShaderModule, nullptr);
@@ -2222,8 +2363,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createBloomPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/fullscreen_vert.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/bloom_bright.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/fullscreen_vert.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/bloom_bright.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -2262,25 +2403,6 @@ namespace Crescendo {
         std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
         VkPipelineDynamicStateCreateInfo dynamicState{VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO, nullptr, 0, (uint32_t)dynamicStates.size(), dynamicStates.data()};
 
-        // [FIX] Ensure Layout has Push Constants (even if unused by Bloom)
-        // This makes it compatible with the Composite Pass which DOES use them.
-        if (compositePipelineLayout == VK_NULL_HANDLE) {
-            VkPushConstantRange pushConstantRange{};
-            pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-            pushConstantRange.offset = 0;
-            pushConstantRange.size = sizeof(PostProcessPushConstants);
-
-            VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
-            layoutInfo.setLayoutCount = 1;
-            layoutInfo.pSetLayouts = &postProcessLayout;
-            layoutInfo.pushConstantRangeCount = 1; 
-            layoutInfo.pPushConstantRanges = &pushConstantRange;
-
-            if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &compositePipelineLayout) != VK_SUCCESS) {
-                return false;
-            }
-        }
-
         VkGraphicsPipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
         pipelineInfo.stageCount = 2;
         pipelineInfo.pStages = stages;
@@ -2296,7 +2418,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = bloomRenderPass;
         pipelineInfo.subpass = 0;
 
-        VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &bloomPipeline);
+        VkResult result = vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &bloomPipeline);
 
         vkDestroyShaderModule(device, fragShaderModule, nullptr);
         vkDestroyShaderModule(device, vertShaderModule, nullptr);
@@ -2306,8 +2428,8 @@ namespace Crescendo {
 
     bool RenderingServer::createBakePipeline() {
         //1. Load the compiled SPIR-V shaders
-        auto vertShaderCode = readFile("assets/shaders/bake.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/bake.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/bake.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/bake.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -2432,7 +2554,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = bakeRenderPass;
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &bakePipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &bakePipeline) != VK_SUCCESS) {
             std::cerr << "Failed to create bake graphics pipeline!" << std::endl;
             return false;
         }
@@ -2477,7 +2599,7 @@ namespace Crescendo {
         if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &computePipelineLayout) != VK_SUCCESS) return false;
 
         // 3. Load the Shader & Build the Pipeline
-        auto compShaderCode = readFile("assets/shaders/equirect2cube.comp.spv");
+        const auto& compShaderCode = pipelineCache.Shader("assets/shaders/equirect2cube.comp.spv");
         VkShaderModule compShaderModule = createShaderModule(compShaderCode);
 
         VkComputePipelineCreateInfo pipelineInfo{};
@@ -2488,7 +2610,7 @@ namespace Crescendo {
         pipelineInfo.stage.module = compShaderModule;
         pipelineInfo.stage.pName = "main";
 
-        if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &equirectToCubePipeline) != VK_SUCCESS) {
+        if (vkCreateComputePipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &equirectToCubePipeline) != VK_SUCCESS) {
             std::cerr << "Failed to create Compute Pipeline!" << std::endl;
             return false;
         }
@@ -2543,8 +2665,8 @@ namespace Crescendo {
         if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &terrainComputePipelineLayout) != VK_SUCCESS) return false;
         
         // 2. Load the Compute Shaders
-        auto densityCode = readFile("assets/shaders/terrain_density.comp.spv");
-        auto marchingCode = readFile("assets/shaders/terrain_marching_cubes.comp.spv");
+        const auto& densityCode = pipelineCache.Shader("assets/shaders/terrain_density.comp.spv");
+        const auto& marchingCode = pipelineCache.Shader("assets/shaders/terrain_marching_cubes.comp.spv");
         
         VkShaderModule densityModule = createShaderModule(densityCode);
         VkShaderModule marchingModule = createShaderModule(marchingCode);
@@ -2561,7 +2683,7 @@ namespace Crescendo {
         computeInfo.layout = terrainComputePipelineLayout;
         computeInfo.stage = densityStage;
         
-        vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &computeInfo, nullptr, &densityComputePipeline);
+        vkCreateComputePipelines(device, pipelineCache.Handle(), 1, &computeInfo, nullptr, &densityComputePipeline);
         
         // Swap to Marching Cubes Pipeline
         VkPipelineShaderStageCreateInfo marchingStage{};
@@ -2571,7 +2693,7 @@ namespace Crescendo {
         marchingStage.pName = "main";
         
         computeInfo.stage = marchingStage;
-        vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &computeInfo, nullptr, &marchingCubesComputePipeline);
+        vkCreateComputePipelines(device, pipelineCache.Handle(), 1, &computeInfo, nullptr, &marchingCubesComputePipeline);
         
         vkDestroyShaderModule(device, densityModule, nullptr);
         vkDestroyShaderModule(device, marchingModule, nullptr);
@@ -2682,8 +2804,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createOutlinePipeline() {
-        auto vertShaderCode = readFile("assets/shaders/shader.vert.spv"); 
-        auto fragShaderCode = readFile("assets/shaders/outline.frag.spv"); 
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/shader.vert.spv"); 
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/outline.frag.spv"); 
         
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -2758,7 +2880,7 @@ namespace Crescendo {
         pipelineInfo.renderPass = viewportRenderPass; 
         pipelineInfo.subpass = 0;
 
-        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &outlinePipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(device, pipelineCache.Handle(), 1, &pipelineInfo, nullptr, &outlinePipeline) != VK_SUCCESS) {
             return false;
         }
 
@@ -2769,8 +2891,8 @@ namespace Crescendo {
     }
 
     bool RenderingServer::createSkyPipeline() {
-        auto vertShaderCode = readFile("assets/shaders/sky.vert.spv");
-        auto fragShaderCode = readFile("assets/shaders/sky.frag.spv");
+        const auto& vertShaderCode = pipelineCache.Shader("assets/shaders/sky.vert.spv");
+        const auto& fragShaderCode = pipelineCache.Shader("assets/shaders/sky.frag.spv");
             
         // The Skybox MUST have an empty vertex input!
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
@@ -2881,8 +3003,8 @@ namespace Crescendo {
         newMesh.name = "GPU_Chunk";
         newMesh.indexCount = indexCount;
         newMesh.textureID = 0;
-        newMesh.vertexBuffer = VulkanBuffer(allocator, vertSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
-        newMesh.indexBuffer = VulkanBuffer(allocator, indSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+        newMesh.bounds = MeshBounds::FromBox(pushData.chunkOrigin, pushData.chunkOrigin + glm::vec3(pushData.chunkSize));   // Vertices never come back to the CPU
+        newMesh.geometry = geometryArena.Allocate(vertexCount, indexCount);
 
         // Exact-Size Dynamic Staging Buffers
         VkBuffer tempVertBuf = VK_NULL_HANDLE, tempIndBuf = VK_NULL_HANDLE;
@@ -2907,10 +3029,12 @@ namespace Crescendo {
         // 4. Data Transfer AND Counter Reset
         cmd = beginAsyncCommands(localPool);
 
-        // Copy the geometry to GPU memory
+        // Copy the geometry into its arena range, indices stay relative to the chunk's first vertex
         VkBufferCopy vCopy{0, 0, vertSize}, iCopy{0, 0, indSize};
-        vkCmdCopyBuffer(cmd, computeVertexBuffer.handle, newMesh.vertexBuffer.handle, 1, &vCopy);
-        vkCmdCopyBuffer(cmd, computeIndexBuffer.handle, newMesh.indexBuffer.handle, 1, &iCopy);
+        VkBufferCopy vArenaCopy{0, newMesh.geometry.vertexOffset * sizeof(Vertex), vertSize};
+        VkBufferCopy iArenaCopy{0, newMesh.geometry.firstIndex * sizeof(uint32_t), indSize};
+        vkCmdCopyBuffer(cmd, computeVertexBuffer.handle, geometryArena.VertexBuffer(newMesh.geometry.page), 1, &vArenaCopy);
+        vkCmdCopyBuffer(cmd, computeIndexBuffer.handle, geometryArena.IndexBuffer(newMesh.geometry.page), 1, &iArenaCopy);
 
         if (needsCollision) {
             // Copy to our exactly-sized temporary staging buffers
@@ -3118,44 +3242,17 @@ namespace Crescendo {
         endAsyncCommands(commandBuffer, localPool);
     }
 
-    VulkanBuffer RenderingServer::createVertexBuffer(const std::vector<Vertex>& vertices) {
-        VkDeviceSize bufferSize = sizeof(Vertex) * vertices.size();
-        
-        // Staging (RAII)
-        VulkanBuffer staging(allocator, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                             VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
-        
-        void* data;
-        vmaMapMemory(allocator, staging.allocation, &data);
-        memcpy(data, vertices.data(), (size_t)bufferSize);
-        vmaUnmapMemory(allocator, staging.allocation);
-
-        // GPU Buffer (RAII)
-        VulkanBuffer buffer(allocator, bufferSize, 
-                            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, 
-                            0);
-
-        copyBuffer(staging.handle, buffer.handle, bufferSize);
-        return buffer;
-    }
-
-    VulkanBuffer RenderingServer::createIndexBuffer(const std::vector<uint32_t>& indices) {
-        VkDeviceSize bufferSize = sizeof(uint32_t) * indices.size();
-        
-        VulkanBuffer staging(allocator, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                             VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
-        
-        void* data;
-        vmaMapMemory(allocator, staging.allocation, &data);
-        memcpy(data, indices.data(), (size_t)bufferSize);
-        vmaUnmapMemory(allocator, staging.allocation);
+    GeometryAllocation RenderingServer::uploadGeometry(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        GeometryAllocation geometry = geometryArena.Allocate(static_cast<uint32_t>(vertices.size()), static_cast<uint32_t>(indices.size()));
+        if (!geometry.IsValid()) return geometry;
 
-        VulkanBuffer buffer(allocator, bufferSize, 
-                            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, 
-                            0);
+        VkDeviceSize vertexSize = sizeof(Vertex) * vertices.size();
+        VkDeviceSize indexSize = sizeof(uint32_t) * indices.size();
 
-        copyBuffer(staging.handle, buffer.handle, bufferSize);
-        return buffer;
+        // Both land before any frame that draws them, the frame submit waits on the batch
+        uploads.UploadBuffer(geometryArena.VertexBuffer(geometry.page), geometry.vertexOffset * sizeof(Vertex), vertices.data(), vertexSize);
+        uploads.UploadBuffer(geometryArena.IndexBuffer(geometry.page), geometry.firstIndex * sizeof(uint32_t), indices.data(), indexSize);
+        return geometry;
     }
 
     void RenderingServer::updateUniformBuffer(uint32_t currentImage, Scene* scene) {
@@ -3184,7 +3281,400 @@ namespace Crescendo {
             if (vmaMapMemory(allocator, entityStorageBuffers[i].allocation, &entityStorageBuffersMapped[i]) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to map Entity Storage Buffer memory!");
             }
+            // The GPU culler reads every row below the high-water mark, never-sent rows must read as empty
+            memset(entityStorageBuffersMapped[i], 0, bufferSize);
+            vmaFlushAllocation(allocator, entityStorageBuffers[i].allocation, 0, VK_WHOLE_SIZE);
+            pendingSlots[i].clear();
+            slotPending[i].assign(MAX_ENTITIES, 0);
+
+            // Batched rows first, then a block per GPU-culled view
+            VkDeviceSize instanceBytes = sizeof(uint32_t) * (static_cast<VkDeviceSize>(MAX_CPU_INSTANCES) + GPU_CULL_VIEWS * MAX_ENTITIES);
+            instanceBuffers[i] = VulkanBuffer(allocator, instanceBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, 0);
+            instanceStaging[i] = VulkanBuffer(allocator, sizeof(uint32_t) * MAX_CPU_INSTANCES, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+            if (vmaMapMemory(allocator, instanceStaging[i].allocation, &instanceStagingMapped[i]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to map Instance Staging Buffer memory!");
+            }
+
+            // Clustered lights, rewritten whole by every packet
+            auto createMapped = [&](VulkanBuffer& buffer, void*& mapped, VkDeviceSize size) {
+                buffer = VulkanBuffer(allocator, size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+                if (vmaMapMemory(allocator, buffer.allocation, &mapped) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to map Light Cluster Buffer memory!");
+                }
+                memset(mapped, 0, size);
+                vmaFlushAllocation(allocator, buffer.allocation, 0, VK_WHOLE_SIZE);
+            };
+            createMapped(lightBuffers[i], lightBuffersMapped[i], sizeof(PointLight) * MAX_POINT_LIGHTS);
+            createMapped(clusterRangeBuffers[i], clusterRangeBuffersMapped[i], sizeof(glm::uvec2) * CLUSTER_COUNT);
+            createMapped(clusterLightBuffers[i], clusterLightBuffersMapped[i], sizeof(uint32_t) * MAX_CLUSTER_LIGHT_INDICES);
+        }
+
+        entitySlots.assign(MAX_ENTITIES, EntityData{});
+        slotBlended.assign(MAX_ENTITIES, 0);
+        slotTexture.assign(MAX_ENTITIES, -1);
+        slotMesh.assign(MAX_ENTITIES, -1);
+        slotSpheres.assign(MAX_ENTITIES, glm::vec4(0.0f));
+        slotFlags.assign(MAX_ENTITIES, 0);
+        slotSeen.assign(MAX_ENTITIES, 0);
+        slotOutlined.assign(MAX_ENTITIES, 0);
+        outlineSlots.clear();
+        meshInstances.clear();
+        slotHighWater = 0;
+        gpuOpaqueRows = 0;
+        gpuDynamicCasterRows = 0;
+        slotShadow.assign(MAX_ENTITIES, SLOT_SHADOW_NONE);
+        slotMovedFrame.assign(MAX_ENTITIES, 0);
+        for (uint32_t& rows : shadowRows) rows = 0;
+        shadowCache.InvalidateAll();
+    }
+
+    void RenderingServer::uploadLightClusters(uint32_t frame, const RenderPacket& packet) {
+        // A packet built before the first bin (or without a scene) has no grid, every cluster reads as empty
+        if (packet.clusterRanges.size() != CLUSTER_COUNT) {
+            memset(clusterRangeBuffersMapped[frame], 0, sizeof(glm::uvec2) * CLUSTER_COUNT);
+            vmaFlushAllocation(allocator, clusterRangeBuffers[frame].allocation, 0, VK_WHOLE_SIZE);
+            return;
+        }
+
+        VkDeviceSize lightBytes = sizeof(PointLight) * packet.lights.size();
+        VkDeviceSize indexBytes = sizeof(uint32_t) * packet.clusterLights.size();
+        if (lightBytes > 0) {
+            memcpy(lightBuffersMapped[frame], packet.lights.data(), lightBytes);
+            vmaFlushAllocation(allocator, lightBuffers[frame].allocation, 0, lightBytes);
+        }
+        if (indexBytes > 0) {
+            memcpy(clusterLightBuffersMapped[frame], packet.clusterLights.data(), indexBytes);
+            vmaFlushAllocation(allocator, clusterLightBuffers[frame].allocation, 0, indexBytes);
+        }
+        memcpy(clusterRangeBuffersMapped[frame], packet.clusterRanges.data(), sizeof(glm::uvec2) * CLUSTER_COUNT);
+        vmaFlushAllocation(allocator, clusterRangeBuffers[frame].allocation, 0, VK_WHOLE_SIZE);
+    }
+
+    void RenderingServer::uploadEntitySlots(uint32_t frame) {
+        std::vector<uint32_t>& pending = pendingSlots[frame];
+        if (pending.empty()) return;
+
+        std::sort(pending.begin(), pending.end());
+        EntityData* mapped = static_cast<EntityData*>(entityStorageBuffersMapped[frame]);
+
+        size_t runStart = 0;
+        for (size_t i = 1; i <= pending.size(); i++) {
+            if (i < pending.size() && pending[i] == pending[i - 1] + 1) continue;
+
+            uint32_t first = pending[runStart];
+            uint32_t count = pending[i - 1] - first + 1;
+            memcpy(mapped + first, entitySlots.data() + first, count * sizeof(EntityData));
+            vmaFlushAllocation(allocator, entityStorageBuffers[frame].allocation, first * sizeof(EntityData), count * sizeof(EntityData));
+            runStart = i;
+        }
+
+        for (uint32_t slot : pending) slotPending[frame][slot] = 0;
+        pending.clear();
+    }
+
+    // --------------------------------------------------------------------
+    // GPU-DRIVEN CULLING
+    // One compute pass tests every entity row against the camera (plus
+    // last frame's depth pyramid), each shadow cascade and the selection
+    // outline, and writes the indirect commands and draw counts those
+    // passes then draw with: one vkCmdDrawIndexedIndirectCount per mesh.
+    // --------------------------------------------------------------------
+    bool RenderingServer::createGpuCullingPipelines() {
+        if (!gpuCullingSupported) return true;
+
+        // 1. Cull set: entity rows, mesh blocks, commands, counts, params, pyramid, instances
+        std::array<VkDescriptorSetLayoutBinding, 7> bindings{};
+        for (uint32_t i = 0; i < bindings.size(); i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &cullDescriptorLayout) != VK_SUCCESS) return false;
+
+        // 2. Pyramid set: scene depth in, every level out
+        std::array<VkDescriptorSetLayoutBinding, 2> pyramidBindings{};
+        pyramidBindings[0].binding = 0;
+        pyramidBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        pyramidBindings[0].descriptorCount = 1;
+        pyramidBindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pyramidBindings[1].binding = 1;
+        pyramidBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        pyramidBindings[1].descriptorCount = 1;
+        pyramidBindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        layoutInfo.bindingCount = static_cast<uint32_t>(pyramidBindings.size());
+        layoutInfo.pBindings = pyramidBindings.data();
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &pyramidDescriptorLayout) != VK_SUCCESS) return false;
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &cullDescriptorLayout;
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &cullPipelineLayout) != VK_SUCCESS) return false;
+
+        VkPushConstantRange pyramidPush{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PyramidPush)};
+        pipelineLayoutInfo.pSetLayouts = &pyramidDescriptorLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pyramidPush;
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pyramidPipelineLayout) != VK_SUCCESS) return false;
+
+        // 3. Compute pipelines
+        auto createCompute = [&](const char* path, VkPipelineLayout layout, VkPipeline& pipeline) {
+            const auto& code = pipelineCache.Shader(path);
+            VkShaderModule module = createShaderModule(code);
+
+            VkComputePipelineCreateInfo computeInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+            computeInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            computeInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            computeInfo.stage.module = module;
+            computeInfo.stage.pName = "main";
+            computeInfo.layout = layout;
+
+            VkResult result = vkCreateComputePipelines(device, pipelineCache.Handle(), 1, &computeInfo, nullptr, &pipeline);
+            vkDestroyShaderModule(device, module, nullptr);
+            return result == VK_SUCCESS;
+        };
+        if (!createCompute("assets/shaders/cull.comp.spv", cullPipelineLayout, cullPipeline)) return false;
+        if (!createCompute("assets/shaders/depth_pyramid.comp.spv", pyramidPipelineLayout, pyramidPipeline)) return false;
+
+        // 4. Descriptor sets, one cull set per frame in flight
+        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, cullDescriptorLayout);
+        VkDescriptorSetAllocateInfo allocInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+        allocInfo.pSetLayouts = layouts.data();
+        if (vkAllocateDescriptorSets(device, &allocInfo, cullDescriptorSets) != VK_SUCCESS) return false;
+
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &pyramidDescriptorLayout;
+        if (vkAllocateDescriptorSets(device, &allocInfo, &pyramidDescriptorSet) != VK_SUCCESS) return false;
+
+        // 5. Per-frame buffers, grown later as the scene needs
+        for (uint32_t f = 0; f < MAX_FRAMES_IN_FLIGHT; f++) {
+            cullParamBuffers[f] = VulkanBuffer(allocator, sizeof(GpuCullParams), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+            vmaMapMemory(allocator, cullParamBuffers[f].allocation, &cullParamMapped[f]);
+            ensureGpuCullBuffers(f, 256, 4096);
+        }
+        createDepthPyramid();
+
+        std::cout << "[RenderingServer] GPU culling ready." << std::endl;
+        return true;
+    }
+
+    void RenderingServer::createDepthPyramid() {
+        if (pyramidPipeline == VK_NULL_HANDLE) return;
+
+        // Level 0 is half the viewport, each level halves again (rounding up) down to 1x1
+        pyramidLevels.clear();
+        uint32_t width = std::max(1u, (swapChainExtent.width + 1) / 2);
+        uint32_t height = std::max(1u, (swapChainExtent.height + 1) / 2);
+        uint32_t texels = 0;
+        while (pyramidLevels.size() < MAX_PYRAMID_LEVELS) {
+            pyramidLevels.push_back(glm::uvec4(width, height, texels, 0));
+            texels += width * height;
+            if (width == 1 && height == 1) break;
+            width = std::max(1u, (width + 1) / 2);
+            height = std::max(1u, (height + 1) / 2);
+        }
+
+        depthPyramid = VulkanBuffer(allocator, sizeof(float) * texels, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 0);
+        depthHasFrame = false;      // The new depth image holds nothing yet
+
+        VkDescriptorImageInfo depthInfo{};
+        depthInfo.sampler = viewportSampler;
+        depthInfo.imageView = viewportDepthImage.view;
+        depthInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        VkDescriptorBufferInfo pyramidInfo{depthPyramid.handle, 0, VK_WHOLE_SIZE};
+
+        std::array<VkWriteDescriptorSet, 2 + MAX_FRAMES_IN_FLIGHT> writes{};
+        for (VkWriteDescriptorSet& write : writes) {
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.pBufferInfo = &pyramidInfo;
+        }
+        writes[0].dstSet = pyramidDescriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pBufferInfo = nullptr;
+        writes[0].pImageInfo = &depthInfo;
+        writes[1].dstSet = pyramidDescriptorSet;
+        writes[1].dstBinding = 1;
+        for (int f = 0; f < MAX_FRAMES_IN_FLIGHT; f++) {
+            writes[2 + f].dstSet = cullDescriptorSets[f];
+            writes[2 + f].dstBinding = 5;
+        }
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void RenderingServer::ensureGpuCullBuffers(uint32_t frame, uint32_t meshCount, uint32_t commandsPerView) {
+        bool meshesFit = meshCount <= cullMeshCapacity[frame];
+        bool commandsFit = commandsPerView <= cullCommandCapacity[frame];
+        if (meshesFit && commandsFit) return;
+
+        // Only ever touched after this frame's fence wait, the GPU is done with the old buffers.
+        // Grown by doubling so a scene that keeps spawning doesn't reallocate every frame.
+        if (!meshesFit) {
+            cullMeshCapacity[frame] = std::max(meshCount, cullMeshCapacity[frame] * 2);
+            uint32_t capacity = cullMeshCapacity[frame];
+
+            meshDrawBuffers[frame] = VulkanBuffer(allocator, sizeof(MeshDrawRange) * capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+            vmaMapMemory(allocator, meshDrawBuffers[frame].allocation, &meshDrawMapped[frame]);
+
+            VkDeviceSize countSize = sizeof(uint32_t) * GPU_CULL_VIEWS * capacity;
+            drawCountBuffers[frame] = VulkanBuffer(allocator, countSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 0);
+            drawCountReadback[frame] = VulkanBuffer(allocator, countSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT);
+            vmaMapMemory(allocator, drawCountReadback[frame].allocation, &drawCountReadbackMapped[frame]);
+            cullReadbackMeshes[frame] = 0;
+        }
+
+        if (!commandsFit) {
+            cullCommandCapacity[frame] = std::max(commandsPerView, cullCommandCapacity[frame] * 2);
+            VkDeviceSize commandSize = sizeof(VkDrawIndexedIndirectCommand) * GPU_CULL_VIEWS * cullCommandCapacity[frame];
+            indirectBuffers[frame] = VulkanBuffer(allocator, commandSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, 0);
+        }
+
+        // Bindings 0-4 and 6, the pyramid (5) is written by createDepthPyramid
+        std::array<VkDescriptorBufferInfo, 6> infos = {{
+            { entityStorageBuffers[frame].handle, 0, VK_WHOLE_SIZE },
+            { meshDrawBuffers[frame].handle, 0, VK_WHOLE_SIZE },
+            { indirectBuffers[frame].handle, 0, VK_WHOLE_SIZE },
+            { drawCountBuffers[frame].handle, 0, VK_WHOLE_SIZE },
+            { cullParamBuffers[frame].handle, 0, sizeof(GpuCullParams) },
+            { instanceBuffers[frame].handle, 0, VK_WHOLE_SIZE }
+        }};
+
+        std::array<VkWriteDescriptorSet, 6> writes{};
+        for (uint32_t i = 0; i < writes.size(); i++) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = cullDescriptorSets[frame];
+            writes[i].dstBinding = i < 5 ? i : 6;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = i == 4 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &infos[i];
+        }
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void RenderingServer::readGpuCullCounts(uint32_t frame) {
+        uint32_t meshCount = cullReadbackMeshes[frame];
+        if (meshCount == 0) return;
+
+        vmaInvalidateAllocation(allocator, drawCountReadback[frame].allocation, 0, VK_WHOLE_SIZE);
+        const uint32_t* counts = static_cast<const uint32_t*>(drawCountReadbackMapped[frame]);
+        for (uint32_t view = 0; view < GPU_CULL_VIEWS; view++) {
+            uint32_t drawn = 0;
+            for (uint32_t m = 0; m < meshCount; m++) drawn += counts[view * meshCount + m];
+            gpuViewDrawn[view].store(drawn, std::memory_order_relaxed);
+        }
+        cullReadbackMeshes[frame] = 0;
+    }
+
+    void RenderingServer::recordGpuCulling(VkCommandBuffer cmd, const RenderPacket& packet) {
+        uint32_t frame = currentFrame;
+        uint32_t meshCount = static_cast<uint32_t>(packet.meshDraws.size());
+
+        // --- 1. Depth pyramid of the last frame ---
+        bool occlusion = depthHasFrame && packet.settings.frustumCulling;
+        if (occlusion) {
+            // Last frame's depth (and MSAA resolve) written, last frame's pyramid reads done
+            VkMemoryBarrier depthBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+            depthBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            depthBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &depthBarrier, 0, nullptr, 0, nullptr);
+
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pyramidPipeline);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pyramidPipelineLayout, 0, 1, &pyramidDescriptorSet, 0, nullptr);
+
+            VkMemoryBarrier levelBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+            levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            PyramidPush push{};
+            push.srcSize = glm::uvec2(swapChainExtent.width, swapChainExtent.height);
+            push.fromDepth = 1;
+            for (const glm::uvec4& level : pyramidLevels) {
+                push.dstSize = glm::uvec2(level);
+                push.dstOffset = level.z;
+                vkCmdPushConstants(cmd, pyramidPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PyramidPush), &push);
+                vkCmdDispatch(cmd, (level.x + 7) / 8, (level.y + 7) / 8, 1);
+                vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &levelBarrier, 0, nullptr, 0, nullptr);
+
+                push.srcSize = push.dstSize;
+                push.srcOffset = push.dstOffset;
+                push.fromDepth = 0;
+            }
+        }
+
+        // --- 2. This frame's views and mesh blocks ---
+        // Arena offsets are filled in here, under the resource lock: a compaction may have moved them since the packet was built
+        MeshDrawRange* ranges = static_cast<MeshDrawRange*>(meshDrawMapped[frame]);
+        for (uint32_t m = 0; m < meshCount; m++) {
+            MeshDrawRange range = packet.meshDraws[m];
+            if (m < meshes.size()) {
+                range.firstIndex = meshes[m].geometry.firstIndex;
+                range.vertexOffset = static_cast<int32_t>(meshes[m].geometry.vertexOffset);
+            }
+            ranges[m] = range;
         }
+        vmaFlushAllocation(allocator, meshDrawBuffers[frame].allocation, 0, sizeof(MeshDrawRange) * meshCount);
+
+        GpuCullParams params{};
+        Frustum camera = Frustum::FromMatrix(packet.globals.viewProj);
+        for (int p = 0; p < 6; p++) params.cameraPlanes[p] = camera.planes[p];
+        for (uint32_t c = 0; c < SHADOW_CASCADES; c++) {
+            Frustum cascade = Frustum::FromMatrix(packet.globals.lightSpaceMatrices[c], true);
+            for (int p = 0; p < 4; p++) params.cascadePlanes[c * 4 + p] = cascade.planes[p];
+        }
+        params.pyramidViewProj = lastViewProj;
+        params.pyramid = glm::uvec4(static_cast<uint32_t>(pyramidLevels.size()), occlusion ? 1u : 0u, swapChainExtent.width, swapChainExtent.height);
+        params.limits = glm::uvec4(packet.gpuRowCount, meshCount, packet.gpuCommandsPerView, packet.settings.frustumCulling ? 1u : 0u);
+        params.instances = glm::uvec4(MAX_CPU_INSTANCES, 0u, 0u, 0u);
+        params.shadows = glm::uvec4(packet.shadowRebuild, 0u, 0u, 0u);
+        for (size_t level = 0; level < pyramidLevels.size(); level++) params.levels[level] = pyramidLevels[level];
+        memcpy(cullParamMapped[frame], &params, sizeof(GpuCullParams));
+        vmaFlushAllocation(allocator, cullParamBuffers[frame].allocation, 0, sizeof(GpuCullParams));
+
+        // Every counter starts the frame at zero
+        VkDeviceSize countBytes = sizeof(uint32_t) * GPU_CULL_VIEWS * meshCount;
+        vkCmdFillBuffer(cmd, drawCountBuffers[frame].handle, 0, countBytes, 0);
+
+        VkMemoryBarrier fillBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        fillBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        fillBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &fillBarrier, 0, nullptr, 0, nullptr);
+
+        // --- 3. Cull, one invocation per row ---
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, 1, &cullDescriptorSets[frame], 0, nullptr);
+        vkCmdDispatch(cmd, (packet.gpuRowCount + 63) / 64, 1, 1);
+
+        // Commands, counts and instance rows to the draws and the stats copy. Also keeps this
+        // frame's depth writes behind the pyramid's reads of the same image.
+        VkMemoryBarrier cullBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                             VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+
+        // --- 4. Counts back to the CPU, read after this frame's fence ---
+        VkBufferCopy copy{0, 0, countBytes};
+        vkCmdCopyBuffer(cmd, drawCountBuffers[frame].handle, drawCountReadback[frame].handle, 1, &copy);
+
+        VkMemoryBarrier hostBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+        cullReadbackMeshes[frame] = meshCount;
     }
 
     // --------------------------------------------------------------------
@@ -3287,26 +3777,46 @@ namespace Crescendo {
     }
 
     VkCommandBuffer RenderingServer::beginAsyncCommands(VkCommandPool& outLocalPool) {
-        // 1. Create a dedicated pool JUST for this specific background thread
-        VkCommandPoolCreateInfo poolInfo{};
-        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; 
-        
-        // Grab the queue family index dynamically so it doesn't crash!
-        QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
-        poolInfo.queueFamilyIndex = indices.graphicsFamily.value();
-
-        vkCreateCommandPool(device, &poolInfo, nullptr, &outLocalPool);
+        // 1. A pool of its own for this background thread, recycled from an earlier submit when one is free
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        {
+            std::lock_guard<std::mutex> lock(asyncCommandMutex);
+            if (!freeAsyncCommandPools.empty()) {
+                outLocalPool = freeAsyncCommandPools.back();
+                freeAsyncCommandPools.pop_back();
+                commandBuffer = asyncCommandContexts[outLocalPool].commandBuffer;
+            }
+        }
 
-        // 2. Allocate the buffer from the new local pool
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = outLocalPool;
-        allocInfo.commandBufferCount = 1;
-
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
+        if (commandBuffer != VK_NULL_HANDLE) {
+            vkResetCommandPool(device, outLocalPool, 0);
+        } else {
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; 
+            
+            // Grab the queue family index dynamically so it doesn't crash!
+            QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
+            poolInfo.queueFamilyIndex = indices.graphicsFamily.value();
+
+            vkCreateCommandPool(device, &poolInfo, nullptr, &outLocalPool);
+
+            // 2. Allocate the buffer (and the fence its submit signals) alongside
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = outLocalPool;
+            allocInfo.commandBufferCount = 1;
+            vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
+
+            VkFenceCreateInfo fenceInfo{};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            VkFence fence;
+            vkCreateFence(device, &fenceInfo, nullptr, &fence);
+
+            std::lock_guard<std::mutex> lock(asyncCommandMutex);
+            asyncCommandContexts[outLocalPool] = AsyncCommandContext{ commandBuffer, fence };
+        }
 
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -3324,10 +3834,11 @@ namespace Crescendo {
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
 
-        VkFenceCreateInfo fenceInfo{};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         VkFence fence;
-        vkCreateFence(device, &fenceInfo, nullptr, &fence);
+        {
+            std::lock_guard<std::mutex> lock(asyncCommandMutex);
+            fence = asyncCommandContexts[localPool].fence;
+        }
 
         {
             // Traffic Light: Protect the actual Queue submission
@@ -3337,95 +3848,210 @@ namespace Crescendo {
 
         // Wait for the background GPU work to finish
         vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
-        vkDestroyFence(device, fence, nullptr);
+        vkResetFences(device, 1, &fence);
 
-        // Clean up the local pool (which automatically frees the command buffer!)
-        vkDestroyCommandPool(device, localPool, nullptr);
+        // Back on the free list, the next beginAsyncCommands resets it
+        std::lock_guard<std::mutex> lock(asyncCommandMutex);
+        freeAsyncCommandPools.push_back(localPool);
     }
 
     // --------------------------------------------------------------------
     // Render() / THE RENDER LOOP
     // --------------------------------------------------------------------
 
-    void RenderingServer::render(Scene* scene, SceneManager* sceneManager, EngineState& engineState) {
+    // =========================================================
+    // FRAME BUILD (simulation thread)
+    // Runs the editor UI and copies everything the frame needs out
+    // of the scene into the packet. Nothing here records or submits
+    // GPU work, so it overlaps the render thread drawing the previous
+    // packet.
+    // =========================================================
+    void RenderingServer::buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) {
+        packet.Reset();
         if (!scene) return;
-                    
-        // --- SAFELY REBUILD PIPELINES BEFORE THE FRAME STARTS ---
-        if (msaaNeedsRebuild) {
-            SetMSAASamples(pendingMsaaSamples);
-            msaaNeedsRebuild = false;
-        }
-            
-        vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
-        
-        uint32_t imageIndex;
-        VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
-        
-        if (result == VK_ERROR_OUT_OF_DATE_KHR) { recreateSwapChain(window); return; }
-        
+
+        packet.frame = ++framesBuilt;
+        packet.swapchainGeneration = swapchainGeneration.load(std::memory_order_acquire);
+
+        PROFILE_SCOPE("RenderingServer::buildPacket");
+        PROFILE_PHASE(phase, "Editor UI");
+
         // Pass the state reference to the UI!
-        editorUI.Prepare(scene, sceneManager, mainCamera, viewportDescriptorSet, engineState);
-        
-        vkResetFences(device, 1, &inFlightFences[currentFrame]);
-        vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+        editorUI.Prepare(scene, sceneManager, camera, viewportDescriptorSet, engineState);
+        packet.ui.Capture(ImGui::GetDrawData());
 
         // ---------------------------------------------------------
-        // PHASE 0: UPLOAD ENTITY DATA TO GPU (SSBO)
+        // ENTITY DATA (uploaded to the SSBO by the render thread)
         // ---------------------------------------------------------
-        EntityData* gpuData = (EntityData*)entityStorageBuffersMapped[currentFrame];
-        int entityCount = 0;
+        phase.Next("Entity Data");
+        // World matrices are as of the last TransformSystem::Update (end of tick, or the editor's
+        // frame); gizmo/inspector edits from Prepare() show next frame
+
+        // GPU-culled rows carry their draw flags, the selection outline is one of them
+        bool gpuCulling = renderSettings.gpuCulling && gpuCullingSupported;
+        for (uint32_t slot : outlineSlots) slotOutlined[slot] = 0;
+        outlineSlots.clear();
+        if (CBaseEntity* selectedEnt = scene->GetEntity(editorUI.GetSelectedEntity()); gpuCulling && selectedEnt && editorUI.GetShowSelectionOutline()) {
+            auto collectOutline = [&](auto& self, const CBaseEntity* ent) -> void {
+                if (ent->index >= 0 && ent->index < static_cast<int>(MAX_ENTITIES)) {
+                    slotOutlined[ent->index] = 1;
+                    outlineSlots.push_back(static_cast<uint32_t>(ent->index));
+                }
+                for (const CBaseEntity* child : ent->children) {
+                    if (child != nullptr) self(self, child);
+                }
+            };
+            collectOutline(collectOutline, selectedEnt);
+        }
 
-        // Map used to link an Entity Pointer to its GPU Index
-        std::map<CBaseEntity*, uint32_t> entityGPUIndices;
+        // Per-mesh row counts follow the flags as rows change, never recounted
+        if (meshInstances.size() < meshes.size()) meshInstances.resize(meshes.size(), 0);
+        auto retireSlot = [&](uint32_t slot) {
+            if (!slotFlags[slot]) return;
+            meshInstances[slotMesh[slot]]--;
+            if (slotFlags[slot] & DRAW_FLAG_OPAQUE) gpuOpaqueRows--;
+            if (slotFlags[slot] & DRAW_FLAG_SHADOW) gpuDynamicCasterRows--;
+        };
+        auto enlistSlot = [&](uint32_t slot, int mesh, uint8_t flags) {
+            slotFlags[slot] = flags;
+            if (!flags) return;
+            if (static_cast<size_t>(mesh) >= meshInstances.size()) meshInstances.resize(mesh + 1, 0);
+            meshInstances[mesh]++;
+            if (flags & DRAW_FLAG_OPAQUE) gpuOpaqueRows++;
+            if (flags & DRAW_FLAG_SHADOW) gpuDynamicCasterRows++;
+            slotHighWater = std::max(slotHighWater, slot + 1);
+        };
 
-        for (auto* ent : scene->entities) {
-            if (!ent || entityCount >= MAX_ENTITIES) continue;
+        // The cached shadow layers hold the static casters: every layer a row's sphere reaches is
+        // redrawn when it joins the static set, and the ones its old sphere reached when it leaves
+        auto setSlotShadow = [&](uint32_t slot, uint8_t shadow, const glm::vec4& sphere) {
+            uint8_t previous = slotShadow[slot];
+            if (previous == shadow) return;
+            if (previous == SLOT_SHADOW_STATIC) shadowCache.Invalidate(slotSpheres[slot]);
+            if (shadow == SLOT_SHADOW_STATIC) shadowCache.Invalidate(sphere);
+            if (previous) shadowRows[previous]--;
+            if (shadow) shadowRows[shadow]++;
+            slotShadow[slot] = shadow;
+            if (shadow) slotHighWater = std::max(slotHighWater, slot + 1);
+        };
 
-            // DIRECT UPLOAD: No Matrix Math on CPU!
-            // We send Radians so the GPU doesn't have to convert.
-            EntityData& data = gpuData[entityCount];
+        // The entity's scene index is its SSBO row, so a lookup is the index itself and a
+        // row is only sent when its world matrix or material changed (or it is mid-blend).
+        // A static scene sends nothing.
+        // Walk the archetype chunks column by column instead of chasing every entity object
+        std::as_const(scene->storage).ForEachChunk(GROUP_DEFAULT, [&](const EntityChunk& chunk) {
+            for (uint32_t i = 0; i < chunk.count; i++) {
+                CBaseEntity* ent = chunk.owners[i];
+                if (ent->index < 0 || ent->index >= static_cast<int>(MAX_ENTITIES)) continue;
+                uint32_t slot = static_cast<uint32_t>(ent->index);
+                const MaterialData& mat = chunk.material[i];
+
+                int texID = (mat.textureID > 0) ? mat.textureID : 0;
+                if (texID == 0 && ent->modelIndex < meshes.size() && meshes[ent->modelIndex].textureID > 0) {
+                    texID = meshes[ent->modelIndex].textureID;
+                }
 
-            data.pos   = glm::vec4(ent->origin, 1.0f);
-            data.rot   = glm::vec4(glm::radians(ent->angles), 0.0f); // Convert to radians here
-            data.scale = glm::vec4(ent->scale, 1.0f);
+                // Same split as the draw lists below: water and transmissive materials stay on the CPU path.
+                // Opaque rows cast shadows, into the cached layers once they have stood still long enough.
+                uint8_t drawFlags = 0;
+                bool hasMesh = ent->modelIndex >= 0 && static_cast<size_t>(ent->modelIndex) < meshes.size();
+                bool opaque = hasMesh && ent->classID != CLASS_PROP_WATER && mat.transmission <= 0.0f;
+                bool settled = packet.frame >= slotMovedFrame[slot] + SHADOW_SETTLE_PACKETS;
+                uint8_t shadow = opaque ? (settled ? SLOT_SHADOW_STATIC : SLOT_SHADOW_DYNAMIC) : SLOT_SHADOW_NONE;
+                if (gpuCulling && hasMesh) {
+                    if (opaque) drawFlags |= DRAW_FLAG_OPAQUE | (settled ? DRAW_FLAG_STATIC_SHADOW : DRAW_FLAG_SHADOW);
+                    if (slotOutlined[slot]) drawFlags |= DRAW_FLAG_OUTLINE;
+                }
+                slotSeen[slot] = packet.frame;
+
+                // Movers are blended every frame of the tick they moved on, then settled once
+                bool blending = chunk.worldTick[i] == scene->time.tick && scene->time.alpha < 1.0f;
+                if (!chunk.renderDirty[i] && !blending && !slotBlended[slot] && slotTexture[slot] == texID && slotMesh[slot] == ent->modelIndex && slotFlags[slot] == drawFlags) {
+                    // CPU culling has no flag to re-send the row for, a caster settles here
+                    setSlotShadow(slot, shadow, slotSpheres[slot]);
+                    continue;
+                }
 
-            // Material & Volume logic remains the same...
-            int texID = (ent->textureID > 0) ? ent->textureID : 0;
-            if (texID == 0 && ent->modelIndex < meshes.size() && meshes[ent->modelIndex].textureID > 0) {
-                texID = meshes[ent->modelIndex].textureID;
-            }
-        
-            data.albedoTint   = glm::vec4(ent->albedoColor, (float)texID);
-            data.sphereBounds = glm::vec4(0.0f); // Placeholder if you aren't using culling yet
-            data.pbrParams    = glm::vec4(ent->roughness, ent->metallic, ent->emission, ent->normalStrength);
-            data.volumeParams = glm::vec4(ent->transmission, ent->thickness, ent->attenuationDistance, ent->ior);
-            data.volumeColor  = glm::vec4(ent->attenuationColor, 0.0f);
-            data.volumeParams = glm::vec4(ent->transmission, ent->thickness, ent->attenuationDistance, ent->ior);
-            data.volumeColor  = glm::vec4(ent->attenuationColor, (float)ent->normalTextureID); 
-            data.advancedPbr = glm::vec4(ent->clearcoat, ent->clearcoatRoughness, ent->sheen, (float)ent->ormTextureID);       
-            data.extendedPbr = glm::vec4(ent->subsurface, ent->specular, ent->specularTint, ent->anisotropic);
-            data.padding1 = glm::vec4(0.0f);
-            data.padding2 = glm::vec4(0.0f);
+                // World matrices are already cached by TransformSystem, only movers are blended between ticks
+                glm::mat4 model = TransformSystem::RenderMatrix(chunk, i, scene->time);
 
-            entityGPUIndices[ent] = entityCount;
-            entityCount++;
+                // The mesh's own bounds when it has them, the entity's local sphere otherwise
+                glm::vec4 localSphere = chunk.bounds[i];
+                if (hasMesh && meshes[ent->modelIndex].bounds.IsValid()) {
+                    localSphere = meshes[ent->modelIndex].bounds.sphere;
+                }
+                glm::vec4 sphere = EntityChunk::WorldSphere(model, localSphere);
+
+                // A caster that moved is drawn every frame again until it settles. A new row hasn't moved.
+                if (slotMesh[slot] != -1 && (slotMesh[slot] != ent->modelIndex || sphere != slotSpheres[slot])) {
+                    slotMovedFrame[slot] = packet.frame;
+                    if (shadow == SLOT_SHADOW_STATIC) shadow = SLOT_SHADOW_DYNAMIC;
+                    if (drawFlags & DRAW_FLAG_STATIC_SHADOW) drawFlags ^= DRAW_FLAG_STATIC_SHADOW | DRAW_FLAG_SHADOW;
+                }
+                setSlotShadow(slot, shadow, sphere);
+
+                retireSlot(slot);
+                slotBlended[slot] = blending;
+                slotTexture[slot] = texID;
+                slotMesh[slot] = ent->modelIndex;
+                enlistSlot(slot, ent->modelIndex, drawFlags);
+                if (chunk.renderDirty[i]) ent->ClearRenderDirty();
+
+                EntityUpdate& update = packet.entityUpdates.emplace_back();
+                update.slot = slot;
+                EntityData& data = update.data;
+                data.model = model;
+                slotSpheres[slot] = sphere;
+
+                // Material & Volume logic remains the same...
+                data.albedoTint   = glm::vec4(mat.albedoColor, (float)texID);
+                data.sphereBounds = slotSpheres[slot];
+                data.pbrParams    = glm::vec4(mat.roughness, mat.metallic, mat.emission, mat.normalStrength);
+                data.volumeParams = glm::vec4(mat.transmission, mat.thickness, mat.attenuationDistance, mat.ior);
+                data.volumeColor  = glm::vec4(mat.attenuationColor, (float)mat.normalTextureID); 
+                data.advancedPbr  = glm::vec4(mat.clearcoat, mat.clearcoatRoughness, mat.sheen, (float)mat.ormTextureID);       
+                data.extendedPbr  = glm::vec4(mat.subsurface, mat.specular, mat.specularTint, mat.anisotropic);
+                data.drawParams   = glm::vec4(static_cast<float>(ent->modelIndex), static_cast<float>(drawFlags), 0.0f, 0.0f);
+            }
+        });
+
+        // Rows whose entity is gone are cleared, the GPU culler would keep drawing them otherwise
+        for (uint32_t slot = 0; slot < slotHighWater; slot++) {
+            if ((!slotFlags[slot] && !slotShadow[slot]) || slotSeen[slot] == packet.frame) continue;
+            setSlotShadow(slot, SLOT_SHADOW_NONE, slotSpheres[slot]);
+            retireSlot(slot);
+            slotFlags[slot] = 0;
+            slotMesh[slot] = -1;
+            slotMovedFrame[slot] = 0;
+
+            EntityUpdate& update = packet.entityUpdates.emplace_back();
+            update.slot = slot;
+            memset(&update.data, 0, sizeof(EntityData));
         }
 
+        auto gpuIndex = [](const CBaseEntity* ent) -> uint32_t {
+            return ent->index >= 0 && ent->index < static_cast<int>(MAX_ENTITIES) ? static_cast<uint32_t>(ent->index) : 0;
+        };
+
         // ---------------------------------------------------------
-        // RENDER COMMANDS
+        // CAMERA
         // ---------------------------------------------------------
-
-        VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-        vkBeginCommandBuffer(commandBuffers[currentFrame], &beginInfo);
-
+        phase.Next("Camera & Lights");
         float aspectRatio = 1.0f;
         glm::vec2 viewportSize = editorUI.GetViewportSize();
         if (viewportSize.x > 0 && viewportSize.y > 0) aspectRatio = viewportSize.x / viewportSize.y;
         
-        glm::mat4 view = mainCamera.GetViewMatrix();
-        glm::mat4 proj = mainCamera.GetProjectionMatrix(aspectRatio);
+        glm::mat4 view = camera.GetViewMatrix();
+        glm::mat4 proj = camera.GetProjectionMatrix(aspectRatio);
         
         glm::mat4 vp = proj * view;
+        glm::vec3 camPos = camera.GetPosition();
+
+        packet.view = view;
+        packet.proj = proj;
+        packet.cameraPosition = camPos;
+        packet.cameraRight = camera.Right;
+        packet.cameraUp = camera.Up;
 
         // 2. Sun Logic (Grab defaults from EditorUI/Scene Environment)
         // strip this for the new refactor 
@@ -3434,28 +4060,26 @@ namespace Crescendo {
         float sunIntensity = scene->environment.sunIntensity;
         
         // Look for our environment entity to sync settings
-        for (auto* ent : scene->entities) {
-            if (ent && ent->className == "env_sky") {
-                // Sync GI Colors
-                scene->environment.skyColor = ent->albedoColor; 
-                scene->environment.groundColor = ent->attenuationColor; 
-                
-                // Update Sun from this entity's rotation
-                glm::mat4 rotMat = glm::mat4_cast(glm::quat(glm::radians(ent->angles)));
-                sunDirection = glm::normalize(glm::vec3(rotMat * glm::vec4(0, 0, 1, 0)));
-                scene->environment.sunDirection = sunDirection; 
-                break;
-            }
+        if (const CBaseEntity* ent = scene->FirstOfClass(CLASS_ENV_SKY)) {
+            // Sync GI Colors
+            scene->environment.skyColor = ent->Material().albedoColor; 
+            scene->environment.groundColor = ent->Material().attenuationColor; 
+            
+            // Update Sun from this entity's rotation
+            glm::mat4 rotMat = glm::mat4_cast(glm::quat(glm::radians(ent->Angles())));
+            sunDirection = glm::normalize(glm::vec3(rotMat * glm::vec4(0, 0, 1, 0)));
+            scene->environment.sunDirection = sunDirection; 
         }
 
         // =========================================================
-        // 2. UPDATE GLOBAL UNIFORMS (GUB)
+        // 2. GLOBAL UNIFORMS (GUB)
         // =========================================================
-        GlobalUniforms globalData{};
+        GlobalUniforms& globalData = packet.globals;
+        globalData = GlobalUniforms{};
         globalData.viewProj = vp;
         globalData.view = view;
         globalData.proj = proj;
-        globalData.cameraPos = glm::vec4(mainCamera.GetPosition(), 1.0f);
+        globalData.cameraPos = glm::vec4(camPos, 1.0f);
         
         // Now the sliders will perfectly push into the shader!
         globalData.sunDirection = glm::vec4(sunDirection, sunIntensity);
@@ -3471,51 +4095,600 @@ namespace Crescendo {
         globalData.skyColor    = glm::vec4(scene->environment.skyColor, 1.0f);
         globalData.groundColor = glm::vec4(scene->environment.groundColor, 1.0f);
         
-        // --- EXTRACT POINT LIGHTS ---
-        globalData.pointLightParams.x = 0; // Reset count
-        for (auto* ent : scene->entities) {
-            if (ent && ent->className == "light_point" && globalData.pointLightParams.x < 16) {
-                int idx = globalData.pointLightParams.x; // Current array index
-                globalData.pointLights[idx].positionAndRadius = glm::vec4(ent->origin, ent->scale.x);
-                globalData.pointLights[idx].colorAndIntensity = glm::vec4(ent->albedoColor, ent->emission);
-                globalData.pointLightParams.x++;
+        // --- POINT LIGHTS ---
+        // Light entities and Point Light components alike, binned into the froxel grid. Only the
+        // visible ones reach the packet, each fragment shades just the lights of its cluster.
+        lightClusters.Clear();
+        for (const CBaseEntity* ent : scene->EntitiesOfClass(CLASS_LIGHT_POINT)) {
+            lightClusters.Add(PointLight{ glm::vec4(ent->WorldPosition(), ent->Scale().x),
+                                          glm::vec4(ent->Material().albedoColor, ent->Material().emission) });
+        }
+        for (const PointLightComponent* light : scene->storage.Components<PointLightComponent>()) {
+            if (!light->enabled || !light->owner) continue;
+            lightClusters.Add(PointLight{ glm::vec4(light->owner->WorldPosition(), light->radius), glm::vec4(light->color, light->intensity) });
+        }
+
+        lightStats = lightClusters.Build(view, proj, camera.nearClip, packet.lights, packet.clusterRanges, packet.clusterLights);
+        if (lightStats.truncated && !lightOverflowWarned) {
+            std::cerr << "[RenderingServer] Point lights past the cluster caps (" << MAX_POINT_LIGHTS << " lights, "
+                      << MAX_CLUSTER_LIGHT_INDICES << " cluster entries), the rest are not shaded!" << std::endl;
+            lightOverflowWarned = true;
+        }
+
+        glm::vec2 slices = LightClusterBuilder::SliceParams(camera.nearClip);
+        globalData.clusterParams = glm::vec4(slices.x, slices.y, static_cast<float>(packet.lights.size()), 0.0f);
+        globalData.clusterGrid = glm::uvec4(CLUSTER_X, CLUSTER_Y, CLUSTER_Z, 0);
+
+        calculateCascades(scene, camera, aspectRatio, globalData);
+
+        packet.shadowBiasConstant = scene->environment.shadowBiasConstant;
+        packet.shadowBiasSlope = scene->environment.shadowBiasSlope;
+
+        // Cached layers this packet redraws: moved cascades, changed static casters, a new bias,
+        // a dropped packet's rebuilds, or all of them every frame when the cache is switched off
+        shadowCache.SetBias(packet.shadowBiasConstant, packet.shadowBiasSlope);
+        if (shadowCacheLost.exchange(false, std::memory_order_relaxed) || !renderSettings.shadowCache) shadowCache.InvalidateAll();
+        packet.shadowRebuild = shadowCache.TakeRebuildMask();
+
+        ShadowCacheStats& shadows = shadowStats;
+        shadows.staticCasters = shadowRows[SLOT_SHADOW_STATIC];
+        shadows.dynamicCasters = shadowRows[SLOT_SHADOW_DYNAMIC];
+        shadows.refit = shadowCache.TakeRefitCount();
+        shadows.rebuilt = 0;
+        for (uint32_t c = 0; c < SHADOW_CASCADES; c++) shadows.rebuilt += (packet.shadowRebuild >> c) & 1u;
+        shadows.totalRebuilds += shadows.rebuilt;
+        shadows.composited = shadowLayersComposited.load(std::memory_order_relaxed);
+
+        // --- SKY ---
+        {
+            // Deep Space defaults
+            float skySunIntensity = 20.0f; 
+            glm::vec3 zenith = glm::vec3(0.01f, 0.01f, 0.02f); // Pitch black/blue space
+            glm::vec3 horizon = glm::vec3(0.05f, 0.10f, 0.20f); // Faint background glow
+
+            // (Optional) Dynamically pull colors from your Editor UI if the entity exists!
+            for (const CBaseEntity* ent : scene->entities) {
+                if (ent && ent->targetName == "Procedural Sky") {
+                    zenith = ent->Material().albedoColor;
+                    horizon = ent->Material().attenuationColor; 
+                    skySunIntensity = ent->Material().emission;
+                    break;
+                }
+            }
+
+            packet.skySun = glm::vec4(scene->environment.sunDirection, skySunIntensity);
+            packet.skyZenith = glm::vec4(zenith, 1.0f);
+            packet.skyHorizon = glm::vec4(horizon, 1.0f);
+        }
+
+        // ---------------------------------------------------------
+        // DRAW LISTS
+        // ---------------------------------------------------------
+        phase.Next("Draw Lists");
+        drawQueue.clear();
+
+        // Every mesh entity's world sphere goes into one batch, tested against the camera and
+        // against the sides of each cascade's light frustum. The shadow pipeline clamps depth,
+        // so casters between the sun and a cascade still land in it: no near/far test there.
+        // Survivors are queued with their draw key, the whole queue is sorted once at the end.
+        enum class DrawKind : uint8_t { Opaque, Transparent, Water };
+        struct DrawCandidate {
+            DrawItem item;
+            DrawKind kind;
+            int material;                       // Albedo texture
+            float distSq;                       // To the camera, the key's depth
+            bool staticCaster = false;          // Shadows from the cached layers
+        };
+        std::vector<DrawCandidate> candidates;
+        cullSpheres.Clear();
+
+        for (const CBaseEntity* ent : scene->entities) {
+            if (!ent || ent->modelIndex >= meshes.size()) continue;
+            glm::vec3 toEntity = ent->WorldPosition() - camPos;
+            DrawCandidate candidate{ DrawItem{ static_cast<uint32_t>(ent->modelIndex), gpuIndex(ent) }, DrawKind::Opaque,
+                                     ent->Material().textureID, glm::dot(toEntity, toEntity) };
+
+            if (ent->classID == CLASS_PROP_WATER) {
+                candidate.kind = DrawKind::Water;
+            } else if (ent->Material().transmission > 0.0f) {
+                candidate.kind = DrawKind::Transparent;
             }
+
+            // Flagged opaque rows are culled and drawn by the GPU
+            bool hasSlot = ent->index >= 0 && ent->index < static_cast<int>(MAX_ENTITIES);
+            if (candidate.kind == DrawKind::Opaque && hasSlot && (slotFlags[ent->index] & DRAW_FLAG_OPAQUE)) continue;
+            candidate.staticCaster = hasSlot && slotShadow[ent->index] == SLOT_SHADOW_STATIC;
+            candidates.push_back(candidate);
+
+            // Rows past the SSBO have no sphere, never cull them
+            cullSpheres.Add(hasSlot ? slotSpheres[ent->index] : glm::vec4(ent->WorldPosition(), std::numeric_limits<float>::max()));
+        }
+
+        CullStats stats;
+
+        // One view over the whole batch, or everything passes when culling is switched off
+        auto cullView = [&](const Frustum& frustum) {
+            auto start = std::chrono::steady_clock::now();
+            if (renderSettings.frustumCulling) cullSpheres.Cull(frustum, cullVisible);
+            else cullVisible.assign(cullSpheres.Size(), 1);
+            stats.cullMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        cullView(Frustum::FromMatrix(vp));
+        for (size_t i = 0; i < candidates.size(); i++) {
+            stats.camera.Add(1, cullVisible[i]);
+            if (!cullVisible[i]) continue;
+
+            // Opaque near to far for early-Z, blended water and glass far to near
+            const DrawCandidate& candidate = candidates[i];
+            const DrawItem& item = candidate.item;
+            uint64_t key;
+            if (candidate.kind == DrawKind::Water) key = DrawKey::Transparent(DrawPass::Water, DrawPipeline::Water, item.meshID, candidate.material, candidate.distSq);
+            else if (candidate.kind == DrawKind::Transparent) key = DrawKey::Transparent(DrawPass::Transparent, DrawPipeline::Transparent, item.meshID, candidate.material, candidate.distSq);
+            else key = DrawKey::Opaque(DrawPass::Opaque, DrawPipeline::Opaque, item.meshID, candidate.material, candidate.distSq);
+            drawQueue.push_back(SortedDraw{ key, item });
+        }
+
+        // Static casters only while their cascade's cached layer is redrawn, dynamic ones every frame
+        for (uint32_t c = 0; c < SHADOW_CASCADES; c++) {
+            bool rebuild = (packet.shadowRebuild >> c) & 1u;
+            cullView(Frustum::FromMatrix(globalData.lightSpaceMatrices[c], true));
+            for (size_t i = 0; i < candidates.size(); i++) {
+                if (candidates[i].kind != DrawKind::Opaque || (candidates[i].staticCaster && !rebuild)) continue;
+                stats.cascades[c].Add(1, cullVisible[i]);
+                if (!cullVisible[i]) continue;
+
+                // Depth-only, textures make no difference to a caster
+                const DrawItem& item = candidates[i].item;
+                DrawPass first = candidates[i].staticCaster ? DrawPass::StaticShadow : DrawPass::Shadow;
+                DrawPass pass = static_cast<DrawPass>(static_cast<uint32_t>(first) + c);
+                drawQueue.push_back(SortedDraw{ DrawKey::Opaque(pass, DrawPipeline::Shadow, item.meshID, -1, 0.0f), item });
+            }
+        }
+
+        // One block of commands per mesh, sized by its flagged rows. The culler fills the blocks,
+        // so recording costs one indirect draw per mesh whatever the entity count.
+        if (gpuCulling && gpuOpaqueRows + outlineSlots.size() > 0) {
+            packet.gpuCulling = true;
+            packet.gpuOutline = !outlineSlots.empty();
+            packet.gpuDynamicShadows = gpuDynamicCasterRows > 0;
+            packet.gpuRowCount = slotHighWater;
+            packet.meshDraws.resize(meshInstances.size());
+
+            uint32_t firstCommand = 0;
+            for (size_t m = 0; m < meshInstances.size(); m++) {
+                packet.meshDraws[m] = MeshDrawRange{ meshes[m].indexCount, firstCommand, meshInstances[m] };
+                firstCommand += meshInstances[m];
+            }
+            packet.gpuCommandsPerView = firstCommand;
+
+            // Counts of the frame the render thread last read back
+            stats.gpu = true;
+            stats.camera.Add(gpuOpaqueRows, gpuViewDrawn[GPU_VIEW_CAMERA].load(std::memory_order_relaxed));
+            for (uint32_t c = 0; c < SHADOW_CASCADES; c++) {
+                uint32_t drawn = gpuViewDrawn[GPU_VIEW_CASCADE + c].load(std::memory_order_relaxed) +
+                                 gpuViewDrawn[GPU_VIEW_STATIC_CASCADE + c].load(std::memory_order_relaxed);
+                stats.cascades[c].Add(gpuOpaqueRows, drawn);
+            }
+        }
+
+        // Procedural Planets: atmosphere shells and baked terrain chunks
+        phase.Next("Planets");
+        candidates.clear();
+        cullSpheres.Clear();
+        for (ProceduralPlanetComponent* planet : scene->storage.Components<ProceduralPlanetComponent>()) {
+            const CBaseEntity* ent = planet->owner;
+            if (!ent) continue;
+
+            // Atmosphere shell, drawn in the read-only transparent pass
+            if (planet->atmosphereMeshID != -1) {
+                // W components act as the Floor and Ceiling for the raymarcher
+                // Calculate explicit inner and outer bounds
+                float innerRadius = planet->settings.radius + planet->atmosphereFloor;
+                float outerRadius = planet->settings.radius * planet->atmosphereCeiling;
+
+                AtmosphereDraw atmo{};
+                atmo.push.vp = vp; 
+                atmo.push.sunDirection_planetRadius = glm::vec4(sunDirection, innerRadius);
+                atmo.push.planetCenter_atmosphereRadius = glm::vec4(ent->WorldPosition(), outerRadius);
+                atmo.push.cameraPos_sunIntensity = glm::vec4(camera.Position, planet->atmosphereIntensity);
+                atmo.push.rayleigh_mie = glm::vec4(planet->rayleigh, planet->mie);
+                atmo.meshID = static_cast<uint32_t>(planet->atmosphereMeshID);
+                packet.atmospheres.push_back(atmo);
+            }
+
+            if (!planet->rootNode) continue;
+
+            // Recursive Octree Streaming Lambda
+            // The engine streamed the octree before this frame was built, only baked chunks are collected here
+            uint32_t planetIndex = gpuIndex(ent);
+            int planetMaterial = ent->Material().textureID;
+            glm::mat4 planetWorld = ent->WorldMatrix();
+            auto collectOctree = [&](auto& self, Crescendo::Terrain::OctreeNode* node) -> void {
+                if (!node) return;
+                if (!node->isVisible) return; // Cull the dark side only
+
+                // 1. Check if the high-res children are fully baked yet
+                bool childrenReady = false;
+                if (!node->isLeaf) {
+                    childrenReady = true;
+                    for (auto& child : node->children) {
+                        // If even one child is missing its mesh, they aren't ready!
+                        if (child && child->meshID == -1) { 
+                            childrenReady = false;
+                            break;
+                        }
+                    }
+                }
+
+                // 2. DRAW THE PARENT IF: It is a leaf, OR its children are still generating in the background!
+                if ((node->isLeaf || !childrenReady) && node->meshID >= 0) {
+                    // Chunk box in planet space, from the bake
+                    const MeshResource& chunkMesh = meshes[node->meshID];
+                    glm::vec4 localSphere = chunkMesh.bounds.IsValid() ? chunkMesh.bounds.sphere : glm::vec4(0.0f, 0.0f, 0.0f, std::numeric_limits<float>::max());
+                    glm::vec4 worldSphere = EntityChunk::WorldSphere(planetWorld, localSphere);
+                    cullSpheres.Add(worldSphere);
+
+                    glm::vec3 toChunk = glm::vec3(worldSphere) - camPos;
+                    candidates.push_back(DrawCandidate{ DrawItem{ static_cast<uint32_t>(node->meshID), planetIndex }, DrawKind::Opaque,
+                                                        planetMaterial, glm::dot(toChunk, toChunk) });
+                } 
+                
+                // 3. ONLY recurse and draw the children if they are all 100% ready to go
+                if (childrenReady && !node->isLeaf) {
+                    for (auto& child : node->children) {
+                        self(self, child.get());
+                    }
+                }
+            };
+            collectOctree(collectOctree, planet->rootNode.get());
         }
 
-        calculateCascades(scene, mainCamera, aspectRatio, globalData);
+        // Baked chunks against the camera, near to far after the opaque entities
+        cullView(Frustum::FromMatrix(vp));
+        uint32_t keptChunks = 0;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (!cullVisible[i]) continue;
+            const DrawCandidate& chunk = candidates[i];
+            drawQueue.push_back(SortedDraw{ DrawKey::Opaque(DrawPass::Terrain, DrawPipeline::Opaque, chunk.item.meshID, chunk.material, chunk.distSq), chunk.item });
+            keptChunks++;
+        }
+        stats.camera.Add(static_cast<uint32_t>(candidates.size()), keptChunks);
+        cullStats = stats;
+
+        // --- EDITOR SELECTION OUTLINE ---
+        // A stale handle (entity deleted since it was selected) resolves to nullptr
+        // On the GPU path it went out as a draw flag with the rows
+        if (CBaseEntity* selectedEnt = scene->GetEntity(editorUI.GetSelectedEntity()); !packet.gpuCulling && selectedEnt && editorUI.GetShowSelectionOutline()) {
+            // A recursive lambda to dig through the entity and all its children
+            auto collectOutline = [&](auto& self, const CBaseEntity* ent) -> void {
+                if (ent->modelIndex < meshes.size()) {
+                    DrawItem item{ static_cast<uint32_t>(ent->modelIndex), gpuIndex(ent) };
+                    drawQueue.push_back(SortedDraw{ DrawKey::Opaque(DrawPass::Outline, DrawPipeline::Outline, item.meshID, -1, 0.0f), item });
+                }
+                for (const CBaseEntity* child : ent->children) {
+                    if (child != nullptr) self(self, child);
+                }
+            };
+            collectOutline(collectOutline, selectedEnt);
+        }
+
+        batchDrawQueue(packet);
+
+        // --- SETTINGS ---
+        // The editor edits these on this thread, the render thread only sees the copy
+        packet.settings = renderSettings;
+        packet.postProcess = postProcessSettings;
+        packet.postProcess.ssaoUVScale = renderSettings.halfResSSAO ? 0.5f : 1.0f;
+        packet.postProcess.ssrUVScale = renderSettings.halfResSSR ? 0.5f : 1.0f;
+    }
+
+    // =========================================================
+    // DRAW QUEUE (simulation thread)
+    // The queue is radix sorted once on its keys, which leaves every
+    // pass contiguous, its draws grouped by pipeline and mesh and in
+    // depth order inside each group. Walking it, consecutive draws of
+    // one mesh become one instanced draw: their rows are written side
+    // by side into the packet's instances and the batch points at the run.
+    // =========================================================
+    void RenderingServer::batchDrawQueue(RenderPacket& packet) {
+        PROFILE_SCOPE("RenderingServer::batchDrawQueue");
+
+        DrawCallStats stats;
+        bool overflowed = false;
+
+        auto start = std::chrono::steady_clock::now();
+        RadixSortDraws(drawQueue, drawQueueScratch);
+        stats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        auto batchesOf = [&](DrawPass pass) -> std::vector<DrawBatch>& {
+            switch (pass) {
+                case DrawPass::Opaque:      return packet.opaqueBatches;
+                case DrawPass::Terrain:     return packet.terrainBatches;
+                case DrawPass::Transparent: return packet.transparentBatches;
+                case DrawPass::Water:       return packet.waterBatches;
+                case DrawPass::Outline:     return packet.outlineBatches;
+                default: {
+                    uint32_t cascade = static_cast<uint32_t>(pass) - static_cast<uint32_t>(DrawPass::Shadow);
+                    return cascade < SHADOW_CASCADES ? packet.shadowBatches[cascade] : packet.staticShadowBatches[cascade - SHADOW_CASCADES];
+                }
+            }
+        };
+
+        for (const SortedDraw& draw : drawQueue) {
+            stats.items++;
+            if (packet.instances.size() >= MAX_CPU_INSTANCES) {
+                overflowed = true;
+                break;
+            }
+
+            // Each glass item refracts the ones drawn before it, so it stays a draw of its own
+            DrawPass pass = DrawKey::Pass(draw.key);
+            std::vector<DrawBatch>& batches = batchesOf(pass);
+            bool merge = pass != DrawPass::Transparent;
+            if (!merge || batches.empty() || batches.back().meshID != draw.item.meshID) {
+                batches.push_back(DrawBatch{ draw.item.meshID, static_cast<uint32_t>(packet.instances.size()), 0 });
+            }
+            packet.instances.push_back(draw.item.entityIndex);
+            batches.back().instanceCount++;
+        }
+        if (overflowed) stats.items = static_cast<uint32_t>(drawQueue.size());
+
+        stats.drawCalls = static_cast<uint32_t>(packet.opaqueBatches.size() + packet.terrainBatches.size() + packet.waterBatches.size() +
+                                                packet.outlineBatches.size() + packet.transparentBatches.size());
+        for (const std::vector<DrawBatch>& batches : packet.shadowBatches) stats.drawCalls += static_cast<uint32_t>(batches.size());
+        for (const std::vector<DrawBatch>& batches : packet.staticShadowBatches) stats.drawCalls += static_cast<uint32_t>(batches.size());
+
+        if (packet.gpuCulling) {
+            uint32_t blocks = 0;
+            for (const MeshDrawRange& range : packet.meshDraws) blocks += range.capacity > 0 ? 1 : 0;
+            uint32_t shadowViews = shadowStats.rebuilt + (packet.gpuDynamicShadows ? SHADOW_CASCADES : 0);
+            stats.indirectDraws = blocks * (1 + shadowViews + (packet.gpuOutline ? 1 : 0));
+        }
+
+        // What the render thread bound for the last packet it recorded
+        for (uint32_t p = 0; p < STATE_PASS_COUNT; p++) {
+            stats.passes[p].pipelines = passStateCounts[p][0].load(std::memory_order_relaxed);
+            stats.passes[p].descriptorSets = passStateCounts[p][1].load(std::memory_order_relaxed);
+            stats.passes[p].geometry = passStateCounts[p][2].load(std::memory_order_relaxed);
+            stats.passes[p].draws = passStateCounts[p][3].load(std::memory_order_relaxed);
+        }
+        drawStats = stats;
+
+        if (overflowed && !instanceOverflowWarned) {
+            std::cerr << "[RenderingServer] More than " << MAX_CPU_INSTANCES << " instances in one frame, the rest are not drawn!" << std::endl;
+            instanceOverflowWarned = true;
+        }
+    }
+
+    // =========================================================
+    // FRAME RECORD (render thread)
+    // Uploads the packet, records every pass and presents. Reads
+    // nothing from the scene, only the packet and GPU resources.
+    // =========================================================
+    void RenderingServer::renderPacket(RenderPacket& packet) {
+        PROFILE_SCOPE("RenderingServer::renderPacket");
+
+        // Mesh/texture creation on the simulation side waits while a frame is recorded and submitted,
+        // never through the fence wait, acquire or present (those can take a whole vsync interval)
+        std::unique_lock<std::mutex> resources(resourceMutex, std::defer_lock);
+
+        // Swapchain rebuilds rewrite descriptor sets the simulation side updates too (skybox)
+        auto rebuildSwapchain = [&]() {
+            std::lock_guard<std::mutex> rebuild(resourceMutex);
+            recreateSwapChain(window);
+        };
+
+        // --- RETIRED GEOMETRY ---
+        // Released meshes whose last possible frame in flight has been waited on
+        {
+            std::lock_guard<std::mutex> retire(resourceMutex);
+            renderedFrames++;
+            retiredGeometry.erase(std::remove_if(retiredGeometry.begin(), retiredGeometry.end(), [&](const std::pair<uint64_t, GeometryAllocation>& retired) {
+                if (renderedFrames <= retired.first + MAX_FRAMES_IN_FLIGHT) return false;
+                geometryArena.Free(retired.second);
+                return true;
+            }), retiredGeometry.end());
+        }
+
+        // --- ENTITY SLOTS ---
+        // Taken in before anything below can drop this packet, the next one only carries what changed after it
+        for (const EntityUpdate& update : packet.entityUpdates) {
+            entitySlots[update.slot] = update.data;
+            for (int f = 0; f < MAX_FRAMES_IN_FLIGHT; f++) {
+                if (slotPending[f][update.slot]) continue;
+                slotPending[f][update.slot] = 1;
+                pendingSlots[f].push_back(update.slot);
+            }
+        }
+
+        // A packet dropped below never redraws the shadow layers it asked for, the next one is told to
+        auto dropShadowRebuild = [&]() {
+            if (packet.shadowRebuild) shadowCacheLost.store(true, std::memory_order_relaxed);
+        };
+
+        // --- SAFELY REBUILD PIPELINES BEFORE THE FRAME STARTS ---
+        if (msaaNeedsRebuild.exchange(false)) {
+            std::lock_guard<std::mutex> rebuild(resourceMutex);
+            SetMSAASamples(pendingMsaaSamples);
+        }
+
+        // Minimized: nothing to draw into until the window comes back
+        if (swapchainStale) {
+            rebuildSwapchain();
+            if (swapchainStale) {
+                dropShadowRebuild();
+                std::this_thread::sleep_for(std::chrono::milliseconds(16));
+                return;
+            }
+        }
+
+        // The UI in a packet built before a resize points at the old viewport image
+        if (packet.swapchainGeneration != swapchainGeneration.load(std::memory_order_relaxed)) {
+            dropShadowRebuild();
+            return;
+        }
+
+        PROFILE_PHASE(phase, "Wait & Acquire");
+        vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+        
+        uint32_t imageIndex;
+        VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+        
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            dropShadowRebuild();
+            rebuildSwapchain();
+            return;
+        }
+        
+        vkResetFences(device, 1, &inFlightFences[currentFrame]);
+        vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+
+        // From here to the submit the frame reads meshes, textures and the geometry pages
+        phase.Next("Resource Lock");
+        resources.lock();
+
+        // ---------------------------------------------------------
+        // PHASE 0: UPLOAD ENTITY DATA TO GPU (SSBO)
+        // ---------------------------------------------------------
+        phase.Next("Upload");
+        // Only the rows this frame's buffer missed while it was in flight
+        uploadEntitySlots(currentFrame);
+        uploadLightClusters(currentFrame, packet);
+
+        // This frame's last culling results are done, then room for the new packet's blocks
+        readGpuCullCounts(currentFrame);
+        if (packet.gpuCulling) ensureGpuCullBuffers(currentFrame, static_cast<uint32_t>(packet.meshDraws.size()), packet.gpuCommandsPerView);
 
         // Upload to GPU (Binding 3)
-        memcpy(globalUniformBuffersMapped[currentFrame], &globalData, sizeof(GlobalUniforms));
-
-        // ---> 2. THE PASTED ENTITY SORTING BLOCK <---
-        std::vector<CBaseEntity*> opaqueList;
-        std::vector<std::pair<float, CBaseEntity*>> transPairs;
-        glm::vec3 camPos = mainCamera.GetPosition();
-
-        for (auto* ent : scene->entities) {
-            if (!ent || ent->modelIndex >= meshes.size() || ent->className == "prop_water") continue;
-            if (ent->transmission > 0.0f) {
-                float distSq = glm::dot(ent->origin - camPos, ent->origin - camPos);
-                transPairs.push_back({distSq, ent});
-            } else {
-                opaqueList.push_back(ent);
+        memcpy(globalUniformBuffersMapped[currentFrame], &packet.globals, sizeof(GlobalUniforms));
+
+        const GlobalUniforms& globalData = packet.globals;
+        const glm::mat4& view = packet.view;
+        const glm::mat4& proj = packet.proj;
+
+        // ---------------------------------------------------------
+        // RENDER COMMANDS
+        // ---------------------------------------------------------
+
+        VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        vkBeginCommandBuffer(commandBuffers[currentFrame], &beginInfo);
+
+        // --- State tracking ---
+        // The scene passes bind through these: a pipeline, descriptor set or geometry page the command
+        // buffer already holds is skipped, the binds that go through are counted per pass. Bindings
+        // survive render pass changes, and nothing else binds graphics state until the symbols draw,
+        // so the tracking runs from the shadow pass to the outline.
+        PassStateStats passStats[STATE_PASS_COUNT];
+        StatePass statePass = STATE_PASS_SHADOW;
+        VkPipeline boundPipeline = VK_NULL_HANDLE;
+        VkPipelineLayout boundSetLayout = VK_NULL_HANDLE;
+        uint32_t boundGeometryPage = RangeAllocator::INVALID;
+
+        auto BindPipeline = [&](VkPipeline pipeline) {
+            if (pipeline == boundPipeline) return;
+            boundPipeline = pipeline;
+            vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            passStats[statePass].pipelines++;
+        };
+
+        // Every scene pass reads the frame's one set, it only needs binding again through another layout
+        auto BindFrameSet = [&](VkPipelineLayout layout) {
+            if (layout == boundSetLayout) return;
+            boundSetLayout = layout;
+            vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+            passStats[statePass].descriptorSets++;
+        };
+
+        // Geometry arena page, only arena geometry is bound here, so this usually binds once a frame
+        auto BindGeometry = [&](uint32_t page) {
+            if (page == boundGeometryPage) return;
+            boundGeometryPage = page;
+
+            VkBuffer vBuffers[] = { geometryArena.VertexBuffer(page) };
+            VkDeviceSize offsets[] = {0};
+            vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vBuffers, offsets);
+            vkCmdBindIndexBuffer(commandBuffers[currentFrame], geometryArena.IndexBuffer(page), 0, VK_INDEX_TYPE_UINT32);
+            passStats[statePass].geometry++;
+        };
+
+        // Generic Draw Helper: one instanced call per batch, the shaders look the entity rows up by gl_InstanceIndex
+        auto Draw = [&](const DrawBatch& batch) {
+            MeshResource& mesh = meshes[batch.meshID];
+            if (!mesh.geometry.IsValid()) return;
+
+            BindGeometry(mesh.geometry.page);
+            vkCmdDrawIndexed(commandBuffers[currentFrame], mesh.indexCount, batch.instanceCount, mesh.geometry.firstIndex,
+                             static_cast<int32_t>(mesh.geometry.vertexOffset), batch.firstInstance);
+            passStats[statePass].draws++;
+        };
+        auto DrawList = [&](const std::vector<DrawBatch>& batches) {
+            for (const DrawBatch& batch : batches) Draw(batch);
+        };
+
+        // GPU-culled view: one indirect draw per mesh block, the culler wrote the commands and the count.
+        // Each command's firstInstance points at the instance buffer slot the culler stored its row in.
+        auto DrawIndirect = [&](uint32_t view) {
+            uint32_t meshCount = static_cast<uint32_t>(packet.meshDraws.size());
+            for (uint32_t m = 0; m < meshCount; m++) {
+                const MeshDrawRange& range = packet.meshDraws[m];
+                MeshResource& mesh = meshes[m];
+                if (range.capacity == 0 || !mesh.geometry.IsValid()) continue;
+
+                // The commands carry the mesh's firstIndex and vertexOffset, only the page is bound
+                BindGeometry(mesh.geometry.page);
+
+                VkDeviceSize commandOffset = (static_cast<VkDeviceSize>(view) * packet.gpuCommandsPerView + range.firstCommand) * sizeof(VkDrawIndexedIndirectCommand);
+                VkDeviceSize countOffset = (static_cast<VkDeviceSize>(view) * meshCount + m) * sizeof(uint32_t);
+                vkCmdDrawIndexedIndirectCount(commandBuffers[currentFrame], indirectBuffers[currentFrame].handle, commandOffset,
+                                              drawCountBuffers[currentFrame].handle, countOffset, range.capacity, sizeof(VkDrawIndexedIndirectCommand));
+                passStats[statePass].draws++;
             }
+        };
+
+        // --- Instance rows ---
+        // The CPU batches' rows go to the front of this frame's instance buffer, the GPU culler writes behind them
+        if (!packet.instances.empty()) {
+            VkDeviceSize instanceBytes = packet.instances.size() * sizeof(uint32_t);
+            std::memcpy(instanceStagingMapped[currentFrame], packet.instances.data(), instanceBytes);
+            vmaFlushAllocation(allocator, instanceStaging[currentFrame].allocation, 0, instanceBytes);
+
+            VkBufferCopy copy{0, 0, instanceBytes};
+            vkCmdCopyBuffer(commandBuffers[currentFrame], instanceStaging[currentFrame].handle, instanceBuffers[currentFrame].handle, 1, &copy);
+
+            VkBufferMemoryBarrier instanceBarrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            instanceBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            instanceBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            instanceBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            instanceBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            instanceBarrier.buffer = instanceBuffers[currentFrame].handle;
+            instanceBarrier.offset = 0;
+            instanceBarrier.size = instanceBytes;
+            vkCmdPipelineBarrier(commandBuffers[currentFrame], VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                                 0, 0, nullptr, 1, &instanceBarrier, 0, nullptr);
+        }
+
+        // =========================================================
+        // PASS -1: GPU CULLING (Compute)
+        // =========================================================
+        if (packet.gpuCulling) {
+            phase.Next("GPU Culling");
+            recordGpuCulling(commandBuffers[currentFrame], packet);
         }
-        std::sort(transPairs.begin(), transPairs.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
-        std::vector<CBaseEntity*> transparentList;
-        for (auto& p : transPairs) transparentList.push_back(p.second);
 
         // =========================================================
         // PASS 0: CASCADED SHADOW MAPS (Depth Only)
         // =========================================================
-        vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipeline);
-        vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+        phase.Next("Shadow Pass");
+        statePass = STATE_PASS_SHADOW;
+        BindPipeline(shadowPipeline);
+        BindFrameSet(shadowPipelineLayout);
 
-        // Loop through all 4 shadow slices
-        for (uint32_t i = 0; i < SHADOW_CASCADES; i++) {
+        // One cascade layer through one of the (compatible) depth passes, static or dynamic casters
+        auto RecordCascade = [&](VkRenderPass pass, VkFramebuffer framebuffer, uint32_t i, bool staticCasters) {
             VkRenderPassBeginInfo shadowPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
-            shadowPassInfo.renderPass = shadowRenderPass;
-            shadowPassInfo.framebuffer = shadowFramebuffers[i];
+            shadowPassInfo.renderPass = pass;
+            shadowPassInfo.framebuffer = framebuffer;
             shadowPassInfo.renderArea.extent = {SHADOW_DIM, SHADOW_DIM};
             
             VkClearValue clearDepth;
@@ -3532,34 +4705,80 @@ namespace Crescendo {
             vkCmdSetScissor(commandBuffers[currentFrame], 0, 1, &scissor);
 
             // Lower the multiplier so the UI sliders don't rip the shadows off the models
-            float scaledConstantBias = scene->environment.shadowBiasConstant * 100.0f;
+            float scaledConstantBias = packet.shadowBiasConstant * 100.0f;
             
-            vkCmdSetDepthBias(commandBuffers[currentFrame], scaledConstantBias, 0.0f, scene->environment.shadowBiasSlope);
-
-            // Draw all OPAQUE entities into the shadow map
-            for (auto* ent : opaqueList) {
-                MeshResource& mesh = meshes[ent->modelIndex];
-                if (mesh.vertexBuffer.handle == VK_NULL_HANDLE) continue;
-
-                VkBuffer vBuffers[] = { mesh.vertexBuffer.handle };
-                VkDeviceSize offsets[] = {0};
-                vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vBuffers, offsets);
-                vkCmdBindIndexBuffer(commandBuffers[currentFrame], mesh.indexBuffer.handle, 0, VK_INDEX_TYPE_UINT32);
-                                    
-                ShadowPushConsts push{};
-                push.lightSpaceMatrix = globalData.lightSpaceMatrices[i]; // The specific math for this slice!
-                push.entityIndex = entityGPUIndices[ent];
-                
-                vkCmdPushConstants(commandBuffers[currentFrame], shadowPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConsts), &push);
-                vkCmdDrawIndexed(commandBuffers[currentFrame], mesh.indexCount, 1, 0, 0, 0);
+            vkCmdSetDepthBias(commandBuffers[currentFrame], scaledConstantBias, 0.0f, packet.shadowBiasSlope);
+
+            ShadowPushConsts push{};
+            push.lightSpaceMatrix = globalData.lightSpaceMatrices[i]; // The specific math for this slice!
+            vkCmdPushConstants(commandBuffers[currentFrame], shadowPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConsts), &push);
+
+            // Opaque entities whose bounds reach this cascade, one instanced draw per mesh
+            if (staticCasters) {
+                DrawList(packet.staticShadowBatches[i]);
+                if (packet.gpuCulling) DrawIndirect(GPU_VIEW_STATIC_CASCADE + i);
+            } else {
+                DrawList(packet.shadowBatches[i]);
+                if (packet.gpuCulling && packet.gpuDynamicShadows) DrawIndirect(GPU_VIEW_CASCADE + i);
             }
 
             vkCmdEndRenderPass(commandBuffers[currentFrame]);
+        };
+
+        // Each cascade: its cached static layer redrawn if asked, then copied into the shadow layer with the
+        // dynamic casters drawn over it. A layer that neither changed nor holds dynamic casters is left alone.
+        uint32_t composited = 0;
+        for (uint32_t i = 0; i < SHADOW_CASCADES; i++) {
+            uint32_t bit = 1u << i;
+            bool rebuild = packet.shadowRebuild & bit;
+            bool dynamic = !packet.shadowBatches[i].empty() || (packet.gpuCulling && packet.gpuDynamicShadows);
+
+            if (rebuild) {
+                RecordCascade(shadowCacheRenderPass, shadowCacheFramebuffers[i], i, true);
+                shadowCacheReady |= bit;
+            }
+            if (!rebuild && !dynamic && !(shadowLayerDynamic & bit) && (shadowLayerValid & bit)) continue;
+            composited++;
+
+            // Never drawn (its rebuild was in a dropped packet): the dynamic casters alone until the next one
+            if (!(shadowCacheReady & bit)) {
+                RecordCascade(shadowRenderPass, shadowFramebuffers[i], i, false);
+                shadowLayerValid |= bit;
+                shadowLayerDynamic |= bit;
+                continue;
+            }
+
+            // Last frame's shadow reads of the layer are done before the copy overwrites it
+            VkImageMemoryBarrier toCopy{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            toCopy.srcAccessMask = 0;
+            toCopy.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            toCopy.oldLayout = (shadowLayerValid & bit) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+            toCopy.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toCopy.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toCopy.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toCopy.image = shadowImage.handle;
+            toCopy.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, i, 1 };
+            vkCmdPipelineBarrier(commandBuffers[currentFrame], VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &toCopy);
+
+            VkImageCopy copy{};
+            copy.srcSubresource = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, i, 1 };
+            copy.dstSubresource = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, i, 1 };
+            copy.extent = { SHADOW_DIM, SHADOW_DIM, 1 };
+            vkCmdCopyImage(commandBuffers[currentFrame], shadowCacheImage.handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           shadowImage.handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+
+            RecordCascade(shadowComposeRenderPass, shadowFramebuffers[i], i, false);
+            shadowLayerValid |= bit;
+            if (dynamic) shadowLayerDynamic |= bit;
+            else shadowLayerDynamic &= ~bit;
         }
+        shadowLayersComposited.store(composited, std::memory_order_relaxed);
 
         // =========================================================
         // PASS 1: OFFSCREEN SCENE (HDR) -> viewportFramebuffer
         // =========================================================
+        phase.Next("Scene Passes");
         VkRenderPassBeginInfo viewportPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
         viewportPassInfo.renderPass = viewportRenderPass;
         viewportPassInfo.framebuffer = viewportFramebuffer;
@@ -3596,8 +4815,9 @@ namespace Crescendo {
             // -----------------------------------------------------------------
             // DRAW SKYBOX
             // -----------------------------------------------------------------
-            vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, skyPipeline);
-            vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+            statePass = STATE_PASS_OPAQUE;
+            BindPipeline(skyPipeline);
+            BindFrameSet(pipelineLayout);
             {
                 // 1. The new 112-Byte struct (Perfectly aligned with vec4, no padding needed!)
                 struct SkyboxPush {
@@ -3610,237 +4830,63 @@ namespace Crescendo {
                 glm::mat4 viewNoTrans = glm::mat4(glm::mat3(view));
                 skyPush.invViewProj = glm::inverse(proj * viewNoTrans);
 
-                // 2. Set beautiful Deep Space defaults
-                glm::vec3 sunDir = scene->environment.sunDirection;
-                float sunIntensity = 20.0f; 
-                glm::vec3 zenith = glm::vec3(0.01f, 0.01f, 0.02f); // Pitch black/blue space
-                glm::vec3 horizon = glm::vec3(0.05f, 0.10f, 0.20f); // Faint background glow
-
-                // (Optional) Dynamically pull colors from your Editor UI if the entity exists!
-                for (auto* ent : scene->entities) {
-                    if (ent && ent->targetName == "Procedural Sky") {
-                        zenith = ent->albedoColor;
-                        
-                        // --- THE FIX: Add the Horizon color sync! ---
-                        horizon = ent->attenuationColor; 
-                        
-                        sunIntensity = ent->emission;
-                        break;
-                    }
-                }
-
-                // 3. Pack everything into the struct
-                skyPush.sunDirection = glm::vec4(sunDir, sunIntensity);
-                skyPush.zenithColor = glm::vec4(zenith, 1.0f);
-                skyPush.horizonColor = glm::vec4(horizon, 1.0f);
+                // 2. Sun and sky colors were resolved when the packet was built
+                skyPush.sunDirection = packet.skySun;
+                skyPush.zenithColor = packet.skyZenith;
+                skyPush.horizonColor = packet.skyHorizon;
                 
                 vkCmdPushConstants(commandBuffers[currentFrame], pipelineLayout, 
                                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
                                    0, sizeof(SkyboxPush), &skyPush);
             }
             vkCmdDraw(commandBuffers[currentFrame], 3, 1, 0, 0);
-                    
-            // -----------------------------------------------------------------
-            // DRAW ENTITIES (OPAQUE & TRANSPARENT)
-            // -----------------------------------------------------------------
-            vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-            vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, 
-                                    pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+            passStats[statePass].draws++;
             
-            // Generic Draw Helper
-            auto DrawList = [&](const std::vector<CBaseEntity*>& list) {
-                for (auto* ent : list) {
-                    MeshResource& mesh = meshes[ent->modelIndex];
-                    if (mesh.vertexBuffer.handle == VK_NULL_HANDLE) continue;
-
-                    VkBuffer vBuffers[] = { mesh.vertexBuffer.handle };
-                    VkDeviceSize offsets[] = {0};
-                    vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vBuffers, offsets);
-                    vkCmdBindIndexBuffer(commandBuffers[currentFrame], mesh.indexBuffer.handle, 0, VK_INDEX_TYPE_UINT32);
-                                        
-                    PushConsts push{};
-                    push.entityIndex = entityGPUIndices[ent];
-                    vkCmdPushConstants(commandBuffers[currentFrame], pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConsts), &push);
-                    vkCmdDrawIndexed(commandBuffers[currentFrame], mesh.indexCount, 1, 0, 0, 0);
-                }
-            };
-
             // -----------------------------------------------------------------
             // 2. DRAW OPAQUE & OCTREES
             // -----------------------------------------------------------------
-            vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, opaquePipeline);
-            vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+            BindPipeline(opaquePipeline);
+            BindFrameSet(pipelineLayout);
             
             // First, draw standard opaque models (like the player, ships, etc)
-            DrawList(opaqueList);
-
-            // Traverse and stream the Procedural Planets! [Updated GPU method]
-            for (auto* ent : scene->entities) {
-                if (ent && ent->HasComponent<ProceduralPlanetComponent>()) {
-                    auto planet = ent->GetComponent<ProceduralPlanetComponent>();
-                    if (!planet->rootNode) continue;
-
-                    // 1. Cull the tree and queue up missing chunks
-                    planet->rootNode->Update(camPos - ent->origin, planet->lodSplitThreshold, planet->chunkManager.get());
-
-                    // 2. Sort the queue so chunks closest to the camera generate FIRST
-                    auto& queue = planet->chunkManager->chunkQueue;
-                    std::sort(queue.begin(), queue.end(), [&](Crescendo::Terrain::OctreeNode* a, Crescendo::Terrain::OctreeNode* b) {
-                        float distA = glm::length((camPos - ent->origin) - a->center);
-                        float distB = glm::length((camPos - ent->origin) - b->center);
-                        return distA > distB; // > Descending order: Furthest at front, Closest at back
-                    });
-
-                    // 3. Process the Bake Queue (Launch Async Threads!)
-                    int chunksLaunched = 0;
-                    while (!queue.empty() && chunksLaunched < 1) { 
-                        auto* node = queue.back(); // Grab the closest chunk (O(1) fast!)
-                        queue.pop_back();          // Instantly remove it from the back
-
-                        // Mark as generating so we don't accidentally queue it again
-                        node->isGenerating = true; 
-
-                        TerrainComputePush pushData{}; 
-                        pushData.chunkOrigin = node->center - glm::vec3(node->size / 2.0f);
-                        pushData.chunkSize = node->size;
-                        pushData.planetCenter = glm::vec3(0.0f);
-                        pushData.planetRadius = planet->settings.radius;
-                        pushData.amplitude = planet->settings.amplitude;
-                        pushData.frequency = planet->settings.frequency;
-                        pushData.octaves = planet->settings.octaves;
-                        pushData.resolution = 32;
-                        pushData.lod = node->lod;
-
-                        bool needsCollision = (node->lod <= 1);
-                        
-                        // --- THE TRULY ASYNC LAUNCH ---
-                        auto* physicsServer = scene->physics; // Grab the pointer for the background thread
-
-                        // Notice the variables added inside the [ ] brackets!
-                        node->pendingBakeResult = std::async(std::launch::async, [this, pushData, needsCollision, physicsServer]() -> Crescendo::ChunkBakeResult {
-                            
-                            // 1. GPU Compute (Runs in background)
-                            ChunkBakeResult result = this->buildChunkMesh(pushData, needsCollision);
-                            
-                            // 2. Jolt Physics (Runs in background!)
-                            if (needsCollision && result.hasMesh && physicsServer) {
-                                int stride = sizeof(Vertex) / sizeof(float);
-                                result.physicsBodyID = physicsServer->CreateTerrainCollider(result.collisionVerts, result.collisionIndices, pushData.chunkOrigin, stride);
-                                
-                                // OPTIMIZATION: Clear the heavy RAM arrays since Jolt has the data now!
-                                result.collisionVerts.clear();
-                                result.collisionIndices.clear();
-                            }
-                            
-                            return result; // Hand the completely finished package back
-                        });
-                        
-                        chunksLaunched++;
-                    }
-
-                    // 4. Check for ANY finished background threads and integrate them!
-                    planet->rootNode->CheckForFinishedMeshes(this, scene, planet->rootNode->center - glm::vec3(planet->rootNode->size / 2.0f));
-
-                    // 4. Recursive Octree Streaming Lambda
-                    auto drawOctree = [&](auto& self, Crescendo::Terrain::OctreeNode* node) -> void {
-                        if (!node) return;
-                        if (!node->isVisible) return; // Cull the dark side only
-
-                        // 1. Check if the high-res children are fully baked yet
-                        bool childrenReady = false;
-                        if (!node->isLeaf) {
-                            childrenReady = true;
-                            for (auto& child : node->children) {
-                                // If even one child is missing its mesh, they aren't ready!
-                                if (child && child->meshID == -1) { 
-                                    childrenReady = false;
-                                    break;
-                                }
-                            }
-                        }
-
-                        // 2. DRAW THE PARENT IF: It is a leaf, OR its children are still generating in the background!
-                        if (node->isLeaf || !childrenReady) {
-                            if (node->meshID >= 0) { 
-                                MeshResource& mesh = meshes[node->meshID];
-                                if (mesh.vertexBuffer.handle != VK_NULL_HANDLE) {
-                                    VkBuffer vBuffers[] = { mesh.vertexBuffer.handle };
-                                    VkDeviceSize offsets[] = {0};
-                                    vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vBuffers, offsets);
-                                    vkCmdBindIndexBuffer(commandBuffers[currentFrame], mesh.indexBuffer.handle, 0, VK_INDEX_TYPE_UINT32);
-                                    
-                                    PushConsts push{};
-                                    push.entityIndex = entityGPUIndices[ent];
-                                    vkCmdPushConstants(commandBuffers[currentFrame], pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConsts), &push);
-                                    
-                                    vkCmdDrawIndexed(commandBuffers[currentFrame], mesh.indexCount, 1, 0, 0, 0);
-                                }
-                            }
-                        } 
-                        
-                        // 3. ONLY recurse and draw the children if they are all 100% ready to go
-                        if (childrenReady && !node->isLeaf) {
-                            for (auto& child : node->children) {
-                                self(self, child.get());
-                            }
-                        }
-                    };
+            DrawList(packet.opaqueBatches);
+            if (packet.gpuCulling) DrawIndirect(GPU_VIEW_CAMERA);
 
-                    // 5. Fire the draw calls!
-                    drawOctree(drawOctree, planet->rootNode.get());
-
-                    
-                }
-            }
+            // Then the streamed Procedural Planet chunks
+            DrawList(packet.terrainBatches);
 
             // Close the opaque pass so the depth buffer transitions to READ_ONLY
             vkCmdEndRenderPass(commandBuffers[currentFrame]);
 
+            // Next frame's occlusion test reads this depth through its pyramid
+            lastViewProj = globalData.viewProj;
+            depthHasFrame = true;
+
             // -----------------------------------------------------------------
             // 2.5 DRAW VOLUMETRIC ATMOSPHERE (In the Read-Only Transparent Pass!)
             // -----------------------------------------------------------------
-            for (auto* ent : scene->entities) {
-                if (ent && ent->HasComponent<ProceduralPlanetComponent>()) {
-                    auto planet = ent->GetComponent<ProceduralPlanetComponent>();
-                    if (planet->atmosphereMeshID != -1) {
-                        
-                        VkRenderPassBeginInfo transPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
-                        transPassInfo.renderPass = transparentRenderPass; 
-                        transPassInfo.framebuffer = viewportFramebuffer; 
-                        transPassInfo.renderArea.extent = swapChainExtent;
-                        
-                        vkCmdBeginRenderPass(commandBuffers[currentFrame], &transPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-                        
-                        vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, atmospherePipeline);
-                        
-                        AtmospherePush atmoPush{};
-                        atmoPush.vp = proj * view; 
-                        // W components act as the Floor and Ceiling for the raymarcher
-                        // Calculate explicit inner and outer bounds
-                        float innerRadius = planet->settings.radius + planet->atmosphereFloor;
-                        float outerRadius = planet->settings.radius * planet->atmosphereCeiling;
-
-                        atmoPush.sunDirection_planetRadius = glm::vec4(sunDirection, innerRadius);
-                        atmoPush.planetCenter_atmosphereRadius = glm::vec4(ent->origin, outerRadius);
-                        atmoPush.cameraPos_sunIntensity = glm::vec4(mainCamera.Position, planet->atmosphereIntensity);
-                        atmoPush.rayleigh_mie = glm::vec4(planet->rayleigh, planet->mie);
-
-                        vkCmdPushConstants(commandBuffers[currentFrame], pipelineLayout, 
-                                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                                           0, sizeof(AtmospherePush), &atmoPush);
-
-                        MeshResource& atmoMesh = meshes[planet->atmosphereMeshID];
-                        if (atmoMesh.vertexBuffer.handle != VK_NULL_HANDLE) {
-                            VkBuffer vBuffers[] = { atmoMesh.vertexBuffer.handle };
-                            VkDeviceSize offsets[] = {0};
-                            vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vBuffers, offsets);
-                            vkCmdBindIndexBuffer(commandBuffers[currentFrame], atmoMesh.indexBuffer.handle, 0, VK_INDEX_TYPE_UINT32);
-                            vkCmdDrawIndexed(commandBuffers[currentFrame], atmoMesh.indexCount, 1, 0, 0, 0);
-                        }
-                        
-                        vkCmdEndRenderPass(commandBuffers[currentFrame]);
-                    }
+            statePass = STATE_PASS_TRANSPARENT;
+            for (const AtmosphereDraw& atmo : packet.atmospheres) {
+                VkRenderPassBeginInfo transPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+                transPassInfo.renderPass = transparentRenderPass; 
+                transPassInfo.framebuffer = viewportFramebuffer; 
+                transPassInfo.renderArea.extent = swapChainExtent;
+                
+                vkCmdBeginRenderPass(commandBuffers[currentFrame], &transPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+                
+                BindPipeline(atmospherePipeline);
+                vkCmdPushConstants(commandBuffers[currentFrame], pipelineLayout, 
+                                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
+                                   0, sizeof(AtmospherePush), &atmo.push);
+
+                MeshResource& atmoMesh = meshes[atmo.meshID];
+                if (atmoMesh.geometry.IsValid()) {
+                    BindGeometry(atmoMesh.geometry.page);
+                    vkCmdDrawIndexed(commandBuffers[currentFrame], atmoMesh.indexCount, 1, atmoMesh.geometry.firstIndex, static_cast<int32_t>(atmoMesh.geometry.vertexOffset), 0);
+                    passStats[statePass].draws++;
                 }
+                
+                vkCmdEndRenderPass(commandBuffers[currentFrame]);
             }
             
             // -----------------------------------------------------------------
@@ -3948,7 +4994,7 @@ namespace Crescendo {
 
             // --- THE MAGIC LOOP ---
             // Draw glass objects one by one, snapshotting the screen between them!
-            for (auto* transEnt : transparentList) {
+            for (const DrawBatch& transBatch : packet.transparentBatches) {
                 // 1. Snapshot the screen (including any previously drawn glass!)
                 UpdateRefractionTexture();
 
@@ -3959,12 +5005,10 @@ namespace Crescendo {
                 transPassInfo.renderArea.extent = swapChainExtent;
                 vkCmdBeginRenderPass(commandBuffers[currentFrame], &transPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-                // 3. Draw exactly ONE transparent entity
-                vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, transparentPipeline);
-                vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
-                
-                std::vector<CBaseEntity*> singleList = { transEnt };
-                DrawList(singleList);
+                // 3. Draw exactly ONE transparent entity, the pipeline and set stay bound across the passes
+                BindPipeline(transparentPipeline);
+                BindFrameSet(pipelineLayout);
+                Draw(transBatch);
 
                 // 4. Close the pass so the next object can snapshot it
                 vkCmdEndRenderPass(commandBuffers[currentFrame]);
@@ -3974,16 +5018,7 @@ namespace Crescendo {
             // 4. WATER OBJECTS
             // -----------------------------------------------------------------
             // If we have water, we need to do one last snapshot so water refracts the glass!
-            bool hasWater = false;
-            std::vector<CBaseEntity*> waterList;
-            for (auto* ent : scene->entities) {
-                if (ent && ent->className == "prop_water") {
-                    waterList.push_back(ent);
-                    hasWater = true;
-                }
-            }
-
-            if (hasWater) {
+            if (!packet.waterBatches.empty()) {
                 UpdateRefractionTexture();
 
                 VkRenderPassBeginInfo waterPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
@@ -3992,10 +5027,10 @@ namespace Crescendo {
                 waterPassInfo.renderArea.extent = swapChainExtent;
                 vkCmdBeginRenderPass(commandBuffers[currentFrame], &waterPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-                vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, waterPipeline);
-                vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
-
-                DrawList(waterList);
+                statePass = STATE_PASS_WATER;
+                BindPipeline(waterPipeline);
+                BindFrameSet(pipelineLayout);
+                DrawList(packet.waterBatches);
                 vkCmdEndRenderPass(commandBuffers[currentFrame]);
             }
 
@@ -4016,56 +5051,31 @@ namespace Crescendo {
         vkCmdSetScissor(commandBuffers[currentFrame], 0, 1, &symbolScissor);
 
         // --- THE OUTLINE DRAW CALL ---
-        int selectedIndex = editorUI.GetSelectedObjectIndex();
-
-        // MASSIVE SAFETY CHECK: Ensure index is valid AND the pointer isn't null!
-        if (editorUI.GetShowSelectionOutline() && selectedIndex >= 0 && selectedIndex < scene->entities.size() && scene->entities[selectedIndex] != nullptr) {
-            
-            vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, outlinePipeline);
-            vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
-
-            // A recursive lambda to dig through the entity and all its children
-            auto drawOutline = [&](auto& self, CBaseEntity* ent) -> void {
-                if (!ent) return; // ASan caught this previously failing because ent was a dangling pointer
-                
-                // If this specific node has a mesh, draw it!
-                if (ent->modelIndex >= 0 && ent->modelIndex < meshes.size()) {
-                    MeshResource& mesh = meshes[ent->modelIndex];
-                    if (mesh.vertexBuffer.handle != VK_NULL_HANDLE) {
-                        VkBuffer vBuffers[] = { mesh.vertexBuffer.handle };
-                        VkDeviceSize offsets[] = {0};
-                        vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vBuffers, offsets);
-                        vkCmdBindIndexBuffer(commandBuffers[currentFrame], mesh.indexBuffer.handle, 0, VK_INDEX_TYPE_UINT32);
-
-                        PushConsts push{};
-                        push.entityIndex = entityGPUIndices[ent]; // <--- If ent is freed memory, this crashes!
-                        vkCmdPushConstants(commandBuffers[currentFrame], pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConsts), &push);
-
-                        vkCmdDrawIndexed(commandBuffers[currentFrame], mesh.indexCount, 1, 0, 0, 0);
-                    }
-                }
-                
-                // Recursively check all children
-                for (CBaseEntity* child : ent->children) {
-                    // One more safety check just in case the scene graph got mangled
-                    if (child != nullptr) {
-                        self(self, child);
-                    }
-                }
-            };
+        if (!packet.outlineBatches.empty() || packet.gpuOutline) {
+            statePass = STATE_PASS_OUTLINE;
+            BindPipeline(outlinePipeline);
+            BindFrameSet(pipelineLayout);
+            DrawList(packet.outlineBatches);
+            if (packet.gpuOutline) DrawIndirect(GPU_VIEW_OUTLINE);
+        }
 
-            // Fire the laser!
-            drawOutline(drawOutline, scene->entities[selectedIndex]);
+        // The symbols bind their own state, the tracking ends here
+        for (uint32_t p = 0; p < STATE_PASS_COUNT; p++) {
+            passStateCounts[p][0].store(passStats[p].pipelines, std::memory_order_relaxed);
+            passStateCounts[p][1].store(passStats[p].descriptorSets, std::memory_order_relaxed);
+            passStateCounts[p][2].store(passStats[p].geometry, std::memory_order_relaxed);
+            passStateCounts[p][3].store(passStats[p].draws, std::memory_order_relaxed);
         }
 
         // --- DRAW SYMBOLS ---
-        symbolServer.DrawSymbols(commandBuffers[currentFrame], mainCamera.Right, mainCamera.Up, descriptorSets[currentFrame], symbolTextureSet);
+        symbolServer.DrawSymbols(commandBuffers[currentFrame], packet.cameraRight, packet.cameraUp, descriptorSets[currentFrame], symbolTextureSet);
         
         vkCmdEndRenderPass(commandBuffers[currentFrame]);
 
         // =========================================================
         // PASS 2: SCREEN SPACE REFLECTIONS (SSR)
         // =========================================================
+        phase.Next("Post Process");
         {
             VkRenderPassBeginInfo ssrPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
             ssrPassInfo.renderPass = ssrRenderPass;
@@ -4079,9 +5089,9 @@ namespace Crescendo {
 
             vkCmdBeginRenderPass(commandBuffers[currentFrame], &ssrPassInfo, VK_SUBPASS_CONTENTS_INLINE);
             
-            if (renderSettings.enableSSR) {
+            if (packet.settings.enableSSR) {
                 // Determine resolution scale
-                float scale = renderSettings.halfResSSR ? 0.5f : 1.0f;
+                float scale = packet.settings.halfResSSR ? 0.5f : 1.0f;
                 uint32_t currentWidth = static_cast<uint32_t>(swapChainExtent.width * scale);
                 uint32_t currentHeight = static_cast<uint32_t>(swapChainExtent.height * scale);
 
@@ -4152,17 +5162,15 @@ namespace Crescendo {
             vkCmdBindDescriptorSets(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS,
                                     compositePipelineLayout, 0, 1, &compositeDescriptorSet, 0, nullptr);
             
-            postProcessSettings.ssaoUVScale = renderSettings.halfResSSAO ? 0.5f : 1.0f;
-            postProcessSettings.ssrUVScale = renderSettings.halfResSSR ? 0.5f : 1.0f;
-
             vkCmdPushConstants(commandBuffers[currentFrame], compositePipelineLayout,
-                                VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PostProcessPushConstants), &postProcessSettings);
+                                VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PostProcessPushConstants), &packet.postProcess);
             vkCmdDraw(commandBuffers[currentFrame], 3, 1, 0, 0);
         vkCmdEndRenderPass(commandBuffers[currentFrame]);
             
         // ---------------------------------------------------------
         // UI & SWAPCHAIN
         // ---------------------------------------------------------
+        phase.Next("UI");
         VkRenderPassBeginInfo swapChainPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
         swapChainPassInfo.renderPass = renderPass; 
         swapChainPassInfo.framebuffer = swapChainFramebuffers[imageIndex]; 
@@ -4172,21 +5180,32 @@ namespace Crescendo {
         swapChainPassInfo.pClearValues = clearValues.data();
             
         vkCmdBeginRenderPass(commandBuffers[currentFrame], &swapChainPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-            editorUI.Render(commandBuffers[currentFrame]);
+            editorUI.Render(commandBuffers[currentFrame], packet.ui.Get());
         vkCmdEndRenderPass(commandBuffers[currentFrame]);
-            
+
+        phase.Next("Submit & Present");
         if (vkEndCommandBuffer(commandBuffers[currentFrame]) != VK_SUCCESS) {
             throw std::runtime_error("failed to record command buffer!");
         }
     
+        // This frame's uploads go out now; it waits on them and takes over what the transfer queue released
+        UploadManager::FrameSync uploadSync = uploads.PrepareFrame(currentFrame);
+        VkCommandBuffer submitBuffers[] = {uploadSync.acquire, commandBuffers[currentFrame]};
+        bool hasAcquire = uploadSync.acquire != VK_NULL_HANDLE;
+
         VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
-        VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-        VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submitInfo.waitSemaphoreCount = 1;
+        VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame], uploadSync.timeline};
+        VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+        uint64_t waitValues[] = {0, uploadSync.waitValue};
+        VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+        timelineInfo.waitSemaphoreValueCount = uploadSync.waitValue > 0 ? 2 : 1;
+        timelineInfo.pWaitSemaphoreValues = waitValues;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = uploadSync.waitValue > 0 ? 2 : 1;
         submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.pWaitDstStageMask = waitStages;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+        submitInfo.commandBufferCount = hasAcquire ? 2 : 1;
+        submitInfo.pCommandBuffers = hasAcquire ? submitBuffers : &submitBuffers[1];
         VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[imageIndex]};
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores = signalSemaphores;
@@ -4196,6 +5215,9 @@ namespace Crescendo {
             if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
                 throw std::runtime_error("failed to submit draw command buffer!");
             } 
+
+        // Submitted: compaction and skybox swaps wait on the queue from here, the present doesn't need the lock
+        resources.unlock();
         
     
         VkPresentInfoKHR presentInfo{VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
@@ -4210,7 +5232,7 @@ namespace Crescendo {
         }
     
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-            recreateSwapChain(window);
+            rebuildSwapchain();
         }
         symbolServer.ClearSymbols();
         currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
@@ -4242,8 +5264,12 @@ namespace Crescendo {
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
 
-        vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(graphicsQueue);
+        {
+            // Terrain bakes submit from the workers, uploads from the simulation thread
+            std::lock_guard<std::mutex> lock(queueMutex);
+            vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+            vkQueueWaitIdle(graphicsQueue);
+        }
 
         vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
     }
@@ -4620,6 +5646,7 @@ namespace Crescendo {
         QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
         std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+        if (indices.transferFamily) uniqueQueueFamilies.insert(indices.transferFamily.value());
 
         float queuePriority = 1.0f;
         for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -4641,8 +5668,27 @@ namespace Crescendo {
         // [CRITICAL] Enable this so shaders can use "texSampler[textureID]"
         deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE; 
 
+        // GPU-driven culling: indirect draws with a GPU-written count, the entity row as firstInstance
+        VkPhysicalDeviceVulkan12Features supported12{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+        VkPhysicalDeviceFeatures2 supported{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+        supported.pNext = &supported12;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &supported);
+        gpuCullingSupported = supported.features.multiDrawIndirect && supported.features.drawIndirectFirstInstance && supported12.drawIndirectCount;
+
+        VkPhysicalDeviceVulkan12Features enabled12{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+        // Core in 1.2, the upload manager tracks its batches with one
+        enabled12.timelineSemaphore = VK_TRUE;
+        if (gpuCullingSupported) {
+            deviceFeatures.multiDrawIndirect = VK_TRUE;
+            deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+            enabled12.drawIndirectCount = VK_TRUE;
+        } else {
+            std::cout << "[Vulkan] No indirect count draws on this device, culling stays on the CPU." << std::endl;
+        }
+
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = &enabled12;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
@@ -4662,6 +5708,8 @@ namespace Crescendo {
 
         vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
         vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+        if (indices.transferFamily) vkGetDeviceQueue(device, indices.transferFamily.value(), 0, &transferQueue);
+        else transferQueue = graphicsQueue;
         return true;
     }
 
@@ -4681,6 +5729,13 @@ namespace Crescendo {
             if (indices.isComplete()) break;
             i++;
         }
+
+        // Uploads go on a transfer-only family; one without compute too is the DMA engine itself
+        for (uint32_t f = 0; f < queueFamilyCount; f++) {
+            VkQueueFlags flags = queueFamilies[f].queueFlags;
+            if (!(flags & VK_QUEUE_TRANSFER_BIT) || (flags & VK_QUEUE_GRAPHICS_BIT)) continue;
+            if (!indices.transferFamily || !(flags & VK_QUEUE_COMPUTE_BIT)) indices.transferFamily = f;
+        }
         return indices;
     }
 
@@ -5162,11 +6217,10 @@ namespace Crescendo {
         int width = 0, height = 0;
         SDL_Vulkan_GetDrawableSize(window, &width, &height);
         
-        // 1. Handle Minimization (Pause until window is visible again)
-        while (width == 0 || height == 0) {
-            SDL_Vulkan_GetDrawableSize(window, &width, &height);
-            SDL_WaitEvent(nullptr);
-        }
+        // 1. Handle Minimization. This may run on the render thread, which can't pump SDL events,
+        // so frames are skipped until the window is visible again instead of blocking here.
+        swapchainStale = (width == 0 || height == 0);
+        if (swapchainStale) return;
 
         vkDeviceWaitIdle(device);
 
@@ -5182,6 +6236,7 @@ namespace Crescendo {
 
         // 4. Recreate Custom Offscreen Resources (HDR, Bloom, Final)
         createViewportResources();
+        createDepthPyramid();
         createSSRResources();    
         createBloomResources();  
         updateSSRDescriptors();       
@@ -5196,6 +6251,7 @@ namespace Crescendo {
                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
             );
         }
+        swapchainGeneration.fetch_add(1, std::memory_order_release);
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             VkDescriptorImageInfo refInfo{};
@@ -5274,29 +6330,50 @@ namespace Crescendo {
         if (ssrRenderPass != VK_NULL_HANDLE) { vkDestroyRenderPass(device, ssrRenderPass, nullptr); ssrRenderPass = VK_NULL_HANDLE; } 
     }
 
-    void RenderingServer::SetMSAASamples(VkSampleCountFlagBits newSamples) {
+    bool RenderingServer::SetMSAASamples(VkSampleCountFlagBits newSamples) {
 
-        if (msaaSamples == newSamples) return;
+        if (msaaSamples == newSamples) return true;
 
         vkDeviceWaitIdle(device);
-        msaaSamples = newSamples;
+        VkSampleCountFlagBits previousSamples = msaaSamples;
 
-        if (graphicsPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, graphicsPipeline,nullptr); graphicsPipeline = VK_NULL_HANDLE; }
-        if (skyPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, skyPipeline, nullptr); skyPipeline = VK_NULL_HANDLE; }
-        if (opaquePipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, opaquePipeline, nullptr);opaquePipeline = VK_NULL_HANDLE; }
-        if (transparentPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, transparentPipeline, nullptr); transparentPipeline = VK_NULL_HANDLE; }
-        if (waterPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, waterPipeline, nullptr); waterPipeline = VK_NULL_HANDLE; }
-        if (atmospherePipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, atmospherePipeline, nullptr); atmospherePipeline = VK_NULL_HANDLE; }
+        // Everything that renders into the multisampled targets, rebuilt for 'samples'
+        auto rebuild = [&](VkSampleCountFlagBits samples) {
+            msaaSamples = samples;
 
-        recreateSwapChain(window);
+            if (graphicsPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, graphicsPipeline,nullptr); graphicsPipeline = VK_NULL_HANDLE; }
+            if (skyPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, skyPipeline, nullptr); skyPipeline = VK_NULL_HANDLE; }
+            if (opaquePipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, opaquePipeline, nullptr);opaquePipeline = VK_NULL_HANDLE; }
+            if (transparentPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, transparentPipeline, nullptr); transparentPipeline = VK_NULL_HANDLE; }
+            if (waterPipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, waterPipeline, nullptr); waterPipeline = VK_NULL_HANDLE; }
+            if (atmospherePipeline != VK_NULL_HANDLE) { vkDestroyPipeline(device, atmospherePipeline, nullptr); atmospherePipeline = VK_NULL_HANDLE; }
 
-        createGraphicsPipeline();
-        createOpaquePipeline();
-        createTransparentPipeline();
-        createWaterPipeline();
-        createAtmospherePipeline();
+            recreateSwapChain(window);
 
-        std::cout << "[Engine] MSAA successfully changed to " << newSamples << " samples." << std::endl;
+            return buildPipelines({
+                { "Graphics", &RenderingServer::createGraphicsPipeline },
+                { "Opaque", &RenderingServer::createOpaquePipeline },
+                { "Transparent", &RenderingServer::createTransparentPipeline },
+                { "Water", &RenderingServer::createWaterPipeline },
+                { "Atmosphere", &RenderingServer::createAtmospherePipeline },
+            });
+        };
+
+        auto rebuildStart = std::chrono::steady_clock::now();
+        if (!rebuild(newSamples)) {
+            // Half a set of pipelines can't draw a frame: go back to the sample count that worked
+            std::cerr << "[Engine] MSAA change to " << newSamples << " samples failed, reverting to " << previousSamples << "." << std::endl;
+            pendingMsaaSamples = previousSamples;
+            if (!rebuild(previousSamples)) {
+                // Same outcome as a failed build at startup, there is nothing left to render with
+                throw std::runtime_error("failed to rebuild pipelines after an MSAA change!");
+            }
+            return false;
+        }
+        double rebuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rebuildStart).count();
+
+        std::cout << "[Engine] MSAA successfully changed to " << newSamples << " samples, pipelines rebuilt in " << rebuildMs << " ms." << std::endl;
+        return true;
     }
 
     void RenderingServer::shutdown() {
@@ -5307,6 +6384,10 @@ namespace Crescendo {
             // 1. DESTROY TOP LEVEL
             symbolServer.Cleanup(device);
             editorUI.Shutdown(device);
+
+            // Picks up what was compiled after startup, e.g. another MSAA level
+            pipelineCache.Save();
+            pipelineCache.Destroy();
                     
             // 2. DESTROY PIPELINES (With Null Checks!)
             if (skyPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, skyPipeline, nullptr);
@@ -5341,6 +6422,13 @@ namespace Crescendo {
             if (marchingCubesComputePipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, marchingCubesComputePipeline, nullptr);
             if (terrainComputePipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, terrainComputePipelineLayout, nullptr);
             if (terrainComputeDescriptorLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, terrainComputeDescriptorLayout, nullptr);
+
+            if (cullPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, cullPipeline, nullptr);
+            if (pyramidPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, pyramidPipeline, nullptr);
+            if (cullPipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, cullPipelineLayout, nullptr);
+            if (pyramidPipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, pyramidPipelineLayout, nullptr);
+            if (cullDescriptorLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, cullDescriptorLayout, nullptr);
+            if (pyramidDescriptorLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, pyramidDescriptorLayout, nullptr);
         
             // 3. DESTROY SHADOWS
             for (auto fb : shadowFramebuffers) {
@@ -5354,6 +6442,17 @@ namespace Crescendo {
             if (shadowImageView != VK_NULL_HANDLE) vkDestroyImageView(device, shadowImageView, nullptr);
             if (shadowSampler != VK_NULL_HANDLE) vkDestroySampler(device, shadowSampler, nullptr);
             shadowImage.destroy();
+            for (auto fb : shadowCacheFramebuffers) {
+                if (fb != VK_NULL_HANDLE) vkDestroyFramebuffer(device, fb, nullptr);
+            }
+            shadowCacheFramebuffers.clear();
+            for (auto view : shadowCacheViews) {
+                if (view != VK_NULL_HANDLE) vkDestroyImageView(device, view, nullptr);
+            }
+            shadowCacheViews.clear();
+            if (shadowCacheRenderPass != VK_NULL_HANDLE) vkDestroyRenderPass(device, shadowCacheRenderPass, nullptr);
+            if (shadowComposeRenderPass != VK_NULL_HANDLE) vkDestroyRenderPass(device, shadowComposeRenderPass, nullptr);
+            shadowCacheImage.destroy();
             
             // --- ADD THESE MISSING RENDER PASSES & FRAMEBUFFERS ---
             if (bloomRenderPass != VK_NULL_HANDLE) vkDestroyRenderPass(device, bloomRenderPass, nullptr);
@@ -5399,8 +6498,20 @@ namespace Crescendo {
             counterBuffer.destroy();
             stagingVertBuffer.destroy();
             stagingIndexBuffer.destroy();
+
+            for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+                cullParamBuffers[i].destroy();
+                meshDrawBuffers[i].destroy();
+                indirectBuffers[i].destroy();
+                drawCountBuffers[i].destroy();
+                drawCountReadback[i].destroy();
+            }
+            depthPyramid.destroy();
         
             meshes.clear(); 
+            retiredGeometry.clear();
+            geometryArena.Shutdown();
+            uploads.Shutdown();
             for (auto& tex : textureBank) tex.image.destroy();
             textureBank.clear();
             textureMap.clear();
@@ -5416,6 +6527,13 @@ namespace Crescendo {
             
             for (auto& buf : entityStorageBuffers) buf.destroy();
             entityStorageBuffers.clear();
+            for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+                instanceBuffers[i].destroy();
+                instanceStaging[i].destroy();
+                lightBuffers[i].destroy();
+                clusterRangeBuffers[i].destroy();
+                clusterLightBuffers[i].destroy();
+            }
 
             for (auto& buf : globalUniformBuffers) buf.destroy();
             globalUniformBuffers.clear();
@@ -5430,6 +6548,12 @@ namespace Crescendo {
                 if (inFlightFences[i] != VK_NULL_HANDLE) vkDestroyFence(device, inFlightFences[i], nullptr);
             }
             
+            for (auto& [pool, context] : asyncCommandContexts) {
+                vkDestroyFence(device, context.fence, nullptr);
+                vkDestroyCommandPool(device, pool, nullptr);
+            }
+            asyncCommandContexts.clear();
+            freeAsyncCommandPools.clear();
             if (asyncCommandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, asyncCommandPool, nullptr);
             if (commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, commandPool, nullptr);
         
@@ -1,9 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 
 #include "servers/rendering/IRenderer.hpp"
 #include "servers/rendering/Vertex.hpp"
+#include "servers/rendering/RenderPacket.hpp"
+#include "servers/rendering/FrustumCuller.hpp"
+#include "servers/rendering/DrawKey.hpp"
+#include "servers/rendering/LightClusters.hpp"
+#include "servers/rendering/ShadowCascades.hpp"
+#include "servers/rendering/GeometryArena.hpp"
+#include "servers/rendering/PipelineCache.hpp"
+#include "servers/rendering/UploadManager.hpp"
 #include "Material.hpp"
 #include "tiny_obj_loader.h"
 #include <map>
@@ -55,6 +64,7 @@ namespace Crescendo {
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        std::optional<uint32_t> transferFamily;     // Transfer without graphics, when the device has one
         bool isComplete() { return graphicsFamily.has_value() && presentFamily.has_value(); }
     };
 
@@ -63,26 +73,6 @@ namespace Crescendo {
        std::vector<VkSurfaceFormatKHR> formats;
        std::vector<VkPresentModeKHR> presentModes; 
     };
-    
-    struct EntityData {
-        glm::vec4 pos;                          // .w can be used for uniform scale or flags later
-        glm::vec4 rot;                          // .xyz = Euler Angles (Radians), .w = unused
-        glm::vec4 scale;                        // .xyz = Scale, .w = unused
-        glm::vec4 sphereBounds; 
-        glm::vec4 albedoTint;
-        glm::vec4 pbrParams;
-        glm::vec4 volumeParams;
-        glm::vec4 volumeColor;
-        glm::vec4 advancedPbr;                  // x = Clearcoat, y = CoatRough, z = Sheen, w = ormTexID
-        glm::vec4 extendedPbr;                  // x = Subsurface, y = Specular, z = SpecularTint, w = Anisotropic
-        glm::vec4 padding1;
-        glm::vec4 padding2;
-    };
-
-    struct PointLight {
-        glm::vec4 positionAndRadius;
-        glm::vec4 colorAndIntensity;
-    };
 
     struct AreaLight {
 
@@ -92,33 +82,8 @@ namespace Crescendo {
 
     };
 
-    struct GlobalUniforms {
-        glm::mat4 viewProj;
-        glm::mat4 view;
-        glm::mat4 proj;
-        glm::mat4 lightSpaceMatrices[4];
-        glm::vec4 cascadeSplits;
-        glm::vec4 cameraPos;
-        glm::vec4 sunDirection; 
-        glm::vec4 sunColor;
-        glm::vec4 params;
-        glm::vec4 fogColor;
-        glm::vec4 fogParams;
-        glm::vec4 skyColor;
-        glm::vec4 groundColor;
-        
-        // --- POINT LIGHTS ---
-        glm::vec4 pointLightParams; 
-        PointLight pointLights[16]; 
-    };
-
-    struct PushConsts {
-        uint32_t entityIndex;   
-    };
-
     struct ShadowPushConsts {
         glm::mat4 lightSpaceMatrix;
-        uint32_t entityIndex;
     };
 
     struct SSRPushConstants {
@@ -131,31 +96,6 @@ namespace Crescendo {
     struct SkyboxPushConsts {
         glm::mat4 invViewProj;  
     };
-
-    struct AtmospherePush {
-        glm::mat4 vp;                              // 64 bytes
-        glm::vec4 sunDirection_planetRadius;       // 16 bytes
-        glm::vec4 planetCenter_atmosphereRadius;   // 16 bytes
-        glm::vec4 cameraPos_sunIntensity;          // 16 bytes
-        glm::vec4 rayleigh_mie;                    // 16 bytes
-    }; 
-
-    struct PostProcessPushConstants {
-       float exposure;
-       float gamma;
-       float bloomStrength;
-       float bloomThreshold;
-       float blurRadius;
-       float ssaoUVScale;
-       float ssrUVScale;  
-    };
-
-    struct RenderSettings {
-        bool enableSSAO = true;
-        bool halfResSSAO = false;
-        bool enableSSR = true;
-        bool halfResSSR = false;
-    };
     
     class RenderingServer : public IRenderer {   
     friend class KtxLoader;
@@ -166,24 +106,46 @@ namespace Crescendo {
         RenderingServer();
 
         std::mutex queueMutex;
+
+        // Held by the render thread while it records a frame, and by anything on the simulation
+        // side that creates GPU resources (asset loads, terrain hand-off, editor tools): both
+        // grow the mesh/texture tables and use the main command pool.
+        std::mutex resourceMutex;
         VkCommandPool asyncCommandPool = VK_NULL_HANDLE;
         VkCommandBuffer beginAsyncCommands(VkCommandPool& outLocalPool);
         void endAsyncCommands(VkCommandBuffer commandBuffer, VkCommandPool localPool);
+
+        // Pools handed out by beginAsyncCommands, each with its command buffer and fence; reset and
+        // reused rather than created per submit (guarded by asyncCommandMutex)
+        struct AsyncCommandContext {
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            VkFence fence = VK_NULL_HANDLE;
+        };
+        std::mutex asyncCommandMutex;
+        std::unordered_map<VkCommandPool, AsyncCommandContext> asyncCommandContexts;
+        std::vector<VkCommandPool> freeAsyncCommandPools;
         
         bool initialize(DisplayServer* display) override;
         void shutdown() override;
 
-        void render(Scene* scene, SceneManager* sceneManager, EngineState& engineState) override;
+        void buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) override;
+        void renderPacket(RenderPacket& packet) override;
         ChunkBakeResult buildChunkMesh(const TerrainComputePush& pushData, bool needsCollision) override;
+        int adoptMesh(MeshResource&& mesh) override;
         void calculateCascades(Scene* scene, Camera& camera, float aspectRatio, GlobalUniforms& globalData);
-        void SetMSAASamples(VkSampleCountFlagBits newSamples);
+        // False if the pipelines wouldn't build, the previous sample count is back in place then
+        bool SetMSAASamples(VkSampleCountFlagBits newSamples);
 
         VkSampleCountFlagBits pendingMsaaSamples = VK_SAMPLE_COUNT_4_BIT;
-        bool msaaNeedsRebuild = false;
+        std::atomic<bool> msaaNeedsRebuild{ false };   // Set by the editor, picked up by the render thread
 
         // Asset Management
 
         int acquireMesh(const std::string& path, const std::string& name, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+        void releaseMesh(int meshID);          // Geometry back to the arena, the ID draws nothing afterwards
+        void compactGeometry();                // Packs the arena's pages, stalls the GPU
+        GeometryArenaStats geometryStats() { return geometryArena.Stats(); }
+        UploadStats uploadStats() { return uploads.Stats(); }
         int acquireTexture(const std::string& path);
         VkDescriptorSet getImGuiTextureID(const std::string& path);
        
@@ -222,9 +184,13 @@ namespace Crescendo {
         VulkanImage depthImageMSAA;
 
         RenderSettings renderSettings;
+        CullStats cullStats;                // Of the last packet built, simulation thread
+        DrawCallStats drawStats;            // Same packet, mesh draws before and after instancing
+        LightClusterStats lightStats;       // Same packet, point lights binned into the clusters
+        ShadowCacheStats shadowStats;       // Same packet, static and dynamic casters and the layers redrawn
+        bool gpuCullingSupported = false;   // multiDrawIndirect, drawIndirectFirstInstance and drawIndirectCount
         EngineConfig config;
         
-        Camera mainCamera;
         std::vector<MeshResource> meshes;
         int waterTextureID = 0;
 
@@ -258,23 +224,46 @@ namespace Crescendo {
         VkDevice device = VK_NULL_HANDLE;
         VkQueue graphicsQueue = VK_NULL_HANDLE;
         VkQueue presentQueue = VK_NULL_HANDLE;
+        VkQueue transferQueue = VK_NULL_HANDLE;      // The graphics queue when there is no transfer-only family
         VkSwapchainKHR swapChain = VK_NULL_HANDLE;
 
         VmaAllocator allocator = nullptr;
         
         // --- [SSBO & UBO] RAII ---
-        static constexpr size_t MAX_ENTITIES = 10000;
+        static constexpr size_t MAX_ENTITIES = 131072;
         std::vector<VulkanBuffer> entityStorageBuffers; 
         std::vector<void*> entityStorageBuffersMapped;
         void createStorageBuffers(); 
 
+        // --- INSTANCES ---
+        // Entity row per instance, read by the vertex shaders through gl_InstanceIndex. The packet's
+        // batches fill the front through a staging copy, GPU-culled commands the rest.
+        static constexpr uint32_t MAX_CPU_INSTANCES = MAX_ENTITIES * 8;
+        VulkanBuffer instanceBuffers[MAX_FRAMES_IN_FLIGHT];
+        VulkanBuffer instanceStaging[MAX_FRAMES_IN_FLIGHT];
+        void* instanceStagingMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        bool instanceOverflowWarned = false;
+        void batchDrawQueue(RenderPacket& packet);
+
+        // Binds each pass's mesh draws reached the command buffer with, render thread to stats, a frame late
+        std::atomic<uint32_t> passStateCounts[STATE_PASS_COUNT][4] = {};
+
         std::vector<VulkanBuffer> globalUniformBuffers; 
         std::vector<void*> globalUniformBuffersMapped;
         void createGlobalUniformBuffer();
 
-        // Helpers returning RAII objects
-        VulkanBuffer createVertexBuffer(const std::vector<Vertex>& vertices);
-        VulkanBuffer createIndexBuffer(const std::vector<uint32_t>& indices);
+        // --- GEOMETRY ARENA ---
+        // Every mesh's vertices and indices, bound once per page instead of once per draw
+        GeometryArena geometryArena;
+        GeometryAllocation uploadGeometry(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+        // --- UPLOADS ---
+        // Mesh and texture data on its way to the GPU, batched and sent once per frame
+        UploadManager uploads;
+
+        // Released ranges wait for the frames in flight that may still draw them (guarded by resourceMutex)
+        std::vector<std::pair<uint64_t, GeometryAllocation>> retiredGeometry;
+        uint64_t renderedFrames = 0;
 
         // Swapchain Resources (Keep Raw)
         std::vector<VkImage> swapChainImages;
@@ -292,6 +281,132 @@ namespace Crescendo {
         static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
         uint32_t currentFrame = 0;
 
+        // Bumped on every swapchain rebuild. Packets built against an older one are dropped.
+        std::atomic<uint32_t> swapchainGeneration{ 0 };
+        bool swapchainStale = false;                    // Minimized, nothing to present into
+        uint64_t framesBuilt = 0;
+
+        // --- PERSISTENT ENTITY SLOTS ---
+        // An entity's row in the entity SSBO is its scene index for its whole life.
+        // Simulation side, what the last packet sent for each slot:
+        std::vector<uint8_t> slotBlended;               // Sent mid-interpolation, still owes its settled matrix
+        std::vector<int> slotTexture;                   // Albedo texture the row was built with, mesh textures can arrive late
+        std::vector<int> slotMesh;                      // Mesh whose bounds the sphere was built from
+        std::vector<glm::vec4> slotSpheres;             // World bounding sphere sent with the row, what the culler tests
+        // Render side, every frame in flight catches up on the rows it hasn't seen:
+        std::vector<EntityData> entitySlots;            // Latest data per row
+        std::vector<uint32_t> pendingSlots[MAX_FRAMES_IN_FLIGHT];
+        std::vector<uint8_t> slotPending[MAX_FRAMES_IN_FLIGHT];
+        void uploadEntitySlots(uint32_t frame);         // Pending rows of one frame's SSBO, in contiguous runs
+
+        // --- SHADOW CASTERS (simulation thread) ---
+        // A caster is static once its row has stood still for SHADOW_SETTLE_PACKETS, it is then drawn
+        // into the cascades' cached layers instead of every frame. Joining, moving or leaving the
+        // static set redraws the layers its sphere reaches.
+        enum SlotShadow : uint8_t { SLOT_SHADOW_NONE = 0, SLOT_SHADOW_DYNAMIC, SLOT_SHADOW_STATIC };
+        std::vector<uint8_t> slotShadow;
+        std::vector<uint64_t> slotMovedFrame;           // Last packet the row's sphere or mesh changed on
+        uint32_t shadowRows[3] = {};                    // Rows per SlotShadow
+        ShadowCascadeCache shadowCache;
+        std::atomic<bool> shadowCacheLost{ false };     // A packet asking for layer rebuilds was dropped
+        std::atomic<uint32_t> shadowLayersComposited{ 0 };
+
+        // --- CULLING SCRATCH (simulation thread) ---
+        SphereBatch cullSpheres;
+        std::vector<uint8_t> cullVisible;
+
+        // --- DRAW QUEUE (simulation thread) ---
+        // Every CPU draw of the packet with its key, radix sorted once into the batches
+        std::vector<SortedDraw> drawQueue;
+        std::vector<SortedDraw> drawQueueScratch;
+
+        // --- CLUSTERED LIGHTS ---
+        LightClusterBuilder lightClusters;              // Simulation thread, fills the packet's light lists
+        bool lightOverflowWarned = false;
+        // Render side, host-visible and written straight from the packet (bindings 11-13)
+        VulkanBuffer lightBuffers[MAX_FRAMES_IN_FLIGHT];
+        VulkanBuffer clusterRangeBuffers[MAX_FRAMES_IN_FLIGHT];
+        VulkanBuffer clusterLightBuffers[MAX_FRAMES_IN_FLIGHT];
+        void* lightBuffersMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        void* clusterRangeBuffersMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        void* clusterLightBuffersMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        void uploadLightClusters(uint32_t frame, const RenderPacket& packet);
+
+        // --- GPU-DRIVEN CULLING ---
+        // Simulation side, kept incrementally so a packet costs O(meshes), not O(rows):
+        std::vector<uint8_t> slotFlags;                 // EntityDrawFlags the row was sent with
+        std::vector<uint64_t> slotSeen;                 // Last packet the slot's entity was alive in
+        std::vector<uint32_t> meshInstances;            // Flagged rows per mesh, the size of its command block
+        std::vector<uint32_t> outlineSlots;             // Selection subtree of the last packet
+        std::vector<uint8_t> slotOutlined;
+        uint32_t slotHighWater = 0;                     // One past the highest row ever flagged
+        uint32_t gpuOpaqueRows = 0;
+        uint32_t gpuDynamicCasterRows = 0;              // Rows flagged DRAW_FLAG_SHADOW
+
+        // Render side. Commands and counts are laid out view by view: camera, 4 cascades, outline,
+        // then the 4 cascades' static casters, which only get commands while their layer is redrawn.
+        static constexpr uint32_t GPU_CULL_VIEWS = 10;
+        static constexpr uint32_t GPU_VIEW_CAMERA = 0;
+        static constexpr uint32_t GPU_VIEW_CASCADE = 1;
+        static constexpr uint32_t GPU_VIEW_OUTLINE = 5;
+        static constexpr uint32_t GPU_VIEW_STATIC_CASCADE = 6;
+        static constexpr uint32_t MAX_PYRAMID_LEVELS = 16;
+
+        struct GpuCullParams {
+            glm::vec4 cameraPlanes[6];
+            glm::vec4 cascadePlanes[16];                // 4 side planes per cascade
+            glm::mat4 pyramidViewProj;
+            glm::uvec4 pyramid;                         // x = levels, y = occlusion on, zw = depth resolution
+            glm::uvec4 limits;                          // x = rows, y = meshes, z = commands per view, w = culling on
+            glm::uvec4 instances;                       // x = first instance of the GPU-culled commands
+            glm::uvec4 shadows;                         // x = cascades whose static layer is redrawn, bit per cascade
+            glm::uvec4 levels[MAX_PYRAMID_LEVELS];      // xy = size, z = offset
+        };
+
+        struct PyramidPush {
+            glm::uvec2 srcSize;
+            glm::uvec2 dstSize;
+            uint32_t srcOffset;
+            uint32_t dstOffset;
+            uint32_t fromDepth;
+        };
+
+        VkDescriptorSetLayout cullDescriptorLayout = VK_NULL_HANDLE;
+        VkDescriptorSetLayout pyramidDescriptorLayout = VK_NULL_HANDLE;
+        VkPipelineLayout cullPipelineLayout = VK_NULL_HANDLE;
+        VkPipelineLayout pyramidPipelineLayout = VK_NULL_HANDLE;
+        VkPipeline cullPipeline = VK_NULL_HANDLE;
+        VkPipeline pyramidPipeline = VK_NULL_HANDLE;
+        VkDescriptorSet cullDescriptorSets[MAX_FRAMES_IN_FLIGHT] = {};
+        VkDescriptorSet pyramidDescriptorSet = VK_NULL_HANDLE;
+
+        // Per frame in flight, grown after the frame's fence wait
+        VulkanBuffer cullParamBuffers[MAX_FRAMES_IN_FLIGHT];
+        void* cullParamMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        VulkanBuffer meshDrawBuffers[MAX_FRAMES_IN_FLIGHT];
+        void* meshDrawMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        VulkanBuffer indirectBuffers[MAX_FRAMES_IN_FLIGHT];
+        VulkanBuffer drawCountBuffers[MAX_FRAMES_IN_FLIGHT];
+        VulkanBuffer drawCountReadback[MAX_FRAMES_IN_FLIGHT];
+        void* drawCountReadbackMapped[MAX_FRAMES_IN_FLIGHT] = {};
+        uint32_t cullMeshCapacity[MAX_FRAMES_IN_FLIGHT] = {};
+        uint32_t cullCommandCapacity[MAX_FRAMES_IN_FLIGHT] = {};
+        uint32_t cullReadbackMeshes[MAX_FRAMES_IN_FLIGHT] = {};   // Meshes the frame's counts were written for, 0 = none
+
+        // Farthest-depth pyramid of the last rendered frame, every level in one buffer
+        VulkanBuffer depthPyramid;
+        std::vector<glm::uvec4> pyramidLevels;          // xy = size, z = offset
+        glm::mat4 lastViewProj = glm::mat4(1.0f);       // Camera of the depth image the pyramid reads
+        bool depthHasFrame = false;                     // viewportDepthImage holds a finished frame
+
+        std::atomic<uint32_t> gpuViewDrawn[GPU_CULL_VIEWS] = {};   // Read back a frame late, for the stats
+
+        bool createGpuCullingPipelines();
+        void createDepthPyramid();                      // Sized to the viewport, again on every resize
+        void ensureGpuCullBuffers(uint32_t frame, uint32_t meshCount, uint32_t commandsPerView);
+        void readGpuCullCounts(uint32_t frame);
+        void recordGpuCulling(VkCommandBuffer cmd, const RenderPacket& packet);
+
         // Descriptors
         static constexpr int MAX_TEXTURES = 100;
         VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
@@ -299,6 +414,7 @@ namespace Crescendo {
         std::vector<VkDescriptorSet> descriptorSets; 
 
         // Pipelines
+        PipelineCache pipelineCache;            // Every vkCreate*Pipelines goes through it, saved under cache/
         VkRenderPass renderPass = VK_NULL_HANDLE;
         VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
         VkPipeline graphicsPipeline = VK_NULL_HANDLE;
@@ -364,7 +480,7 @@ namespace Crescendo {
         VkFramebuffer viewportFramebuffer = VK_NULL_HANDLE;
         VkRenderPass viewportRenderPass = VK_NULL_HANDLE;
         VkRenderPass transparentRenderPass = VK_NULL_HANDLE;
-        VkDescriptorSet viewportDescriptorSet = VK_NULL_HANDLE;
+        std::atomic<VkDescriptorSet> viewportDescriptorSet{ VK_NULL_HANDLE };  // Replaced by the render thread on resize
         
         // Viewport Depth
         VulkanImage viewportDepthImage;
@@ -434,6 +550,7 @@ namespace Crescendo {
         bool createDescriptorSetLayout();
         bool createDescriptorPool();
         bool createDescriptorSets();
+        bool createPipelineLayouts();
         bool createGraphicsPipeline();
         bool createSSRResources();
         bool createSSRPipeline();
@@ -451,6 +568,14 @@ namespace Crescendo {
         bool createCompositePipeline();
         bool createOutlinePipeline();
         bool createBillboardPipeline();
+
+        // Builders that only write their own pipelines, run side by side on the job system.
+        // Their layouts and render passes have to exist already.
+        struct PipelineBuild {
+            const char* name;
+            bool (RenderingServer::*create)();
+        };
+        bool buildPipelines(const std::vector<PipelineBuild>& builds);
         bool createHDRImage(const std::string& path, VulkanImage& outImage);
         void updateCompositeDescriptors();
         void recreateSwapChain(SDL_Window* window);
@@ -476,6 +601,16 @@ namespace Crescendo {
         VkPipeline shadowPipeline = VK_NULL_HANDLE;    
         VkPipelineLayout shadowPipelineLayout = VK_NULL_HANDLE;
 
+        // Static casters per cascade, copied into the shadow layer before the dynamic ones draw over it
+        VulkanImage shadowCacheImage;
+        std::vector<VkImageView> shadowCacheViews;
+        std::vector<VkFramebuffer> shadowCacheFramebuffers;
+        VkRenderPass shadowCacheRenderPass = VK_NULL_HANDLE;    // Clears, ends ready to copy from
+        VkRenderPass shadowComposeRenderPass = VK_NULL_HANDLE;  // Loads the copied layer, ends ready to sample
+        uint32_t shadowCacheReady = 0;                  // Render side, bit per cascade: the layer has been drawn
+        uint32_t shadowLayerValid = 0;                  // The shadow layer holds a finished frame
+        uint32_t shadowLayerDynamic = 0;                // ... with dynamic casters in it, refreshed even if none are left
+
         // Compute IBL
         VkDescriptorSetLayout computeDescriptorLayout = VK_NULL_HANDLE;
         VkPipelineLayout computePipelineLayout = VK_NULL_HANDLE;
@@ -0,0 +1,89 @@
+#include "servers/rendering/ShadowCascades.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Crescendo {
+
+    glm::mat4 ShadowCascadeCache::Fit(uint32_t cascade, const glm::mat4& sliceInverse, const glm::vec3& lightDir,
+                                      uint32_t shadowDim, const ShadowCacheSettings& settings) {
+        Cascade& c = cascades[cascade];
+
+        // --- Bounding sphere of the slice ---
+        // Only depends on the slice's shape, not on where the camera looks
+        glm::vec3 corners[8];
+        glm::vec3 center(0.0f);
+        for (int i = 0; i < 8; i++) {
+            glm::vec4 pt = sliceInverse * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : 0.0f, 1.0f);
+            corners[i] = glm::vec3(pt) / pt.w;
+            center += corners[i];
+        }
+        center /= 8.0f;
+
+        float radius = 0.0f;
+        for (const glm::vec3& corner : corners) radius = std::max(radius, glm::length(corner - center));
+        radius *= 1.001f;   // Float noise between frames never reads as growth
+
+        // --- Keep the cached fit while it still covers the slice ---
+        bool sunHeld = c.valid && (c.lightDir == lightDir || glm::dot(c.lightDir, lightDir) >= std::cos(glm::radians(settings.sunAngle)));
+        bool sizeHeld = c.valid && radius <= c.radius && radius >= c.radius * 0.9f && c.extent == c.radius * (1.0f + settings.margin);
+        if (sunHeld && sizeHeld) {
+            // Room left for the slice to drift, less the texel the snap may have moved the center by
+            float slack = c.extent - radius - 2.0f * c.extent / static_cast<float>(shadowDim);
+            glm::vec3 drift = glm::abs(glm::vec3(c.lightView * glm::vec4(center, 1.0f)) - c.center);
+            if (drift.x <= slack && drift.y <= slack && drift.z <= slack) return c.matrix;
+        }
+
+        // --- Refit ---
+        // Rotation only, every cascade shares the origin, so a snapped center is on the same grid for all of them
+        glm::vec3 up = std::abs(lightDir.z) > 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+        c.lightView = glm::lookAt(glm::vec3(0.0f), -lightDir, up);
+        c.lightDir = lightDir;
+        c.radius = radius;
+        c.extent = radius * (1.0f + settings.margin);
+
+        float texel = 2.0f * c.extent / static_cast<float>(shadowDim);
+        glm::vec3 local = glm::vec3(c.lightView * glm::vec4(center, 1.0f));
+        c.center = glm::vec3(std::floor(local.x / texel) * texel, std::floor(local.y / texel) * texel, local.z);
+
+        // Looking down -Z: the sun side is +Z, casters up to SHADOW_CASTER_REACH towards it still land in the map
+        glm::mat4 lightProj = glm::ortho(c.center.x - c.extent, c.center.x + c.extent, c.center.y - c.extent, c.center.y + c.extent,
+                                         -(c.center.z + c.extent + SHADOW_CASTER_REACH), -(c.center.z - c.extent - SHADOW_CASTER_REACH));
+        c.matrix = lightProj * c.lightView;
+        c.sides = Frustum::FromMatrix(c.matrix, true);
+        c.valid = true;
+
+        rebuild |= 1u << cascade;
+        refit++;
+        return c.matrix;
+    }
+
+    void ShadowCascadeCache::SetBias(float constant, float slope) {
+        glm::vec2 next(constant, slope);
+        if (next == bias) return;
+        bias = next;
+        InvalidateAll();
+    }
+
+    void ShadowCascadeCache::Invalidate(const glm::vec4& sphere) {
+        for (uint32_t c = 0; c < SHADOW_CASCADE_COUNT; c++) {
+            if (cascades[c].valid && cascades[c].sides.ContainsSphere(sphere)) rebuild |= 1u << c;
+        }
+    }
+
+    void ShadowCascadeCache::InvalidateAll() {
+        rebuild = (1u << SHADOW_CASCADE_COUNT) - 1u;
+    }
+
+    uint32_t ShadowCascadeCache::TakeRebuildMask() {
+        uint32_t mask = rebuild;
+        rebuild = 0;
+        return mask;
+    }
+
+    uint32_t ShadowCascadeCache::TakeRefitCount() {
+        uint32_t count = refit;
+        refit = 0;
+        return count;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "servers/rendering/FrustumCuller.hpp"
+
+namespace Crescendo {
+
+    // =========================================================
+    // CACHED SHADOW CASCADES
+    // Each cascade is fit to the bounding sphere of its slice of the
+    // camera frustum, so its size doesn't change as the camera turns,
+    // and its center is snapped to whole shadow texels of a light
+    // space with a fixed origin, so the texel grid never slides over
+    // the world. The sphere is padded by a margin and the cascade
+    // stays put until the slice drifts out of it, the sun turns past
+    // a threshold or the bias changes. While it stays, the static
+    // casters already drawn into its cache layer are still right:
+    // only the dynamic ones are drawn over a copy of it each frame.
+    // =========================================================
+
+    static constexpr uint32_t SHADOW_CASCADE_COUNT = 4;
+    static constexpr float SHADOW_CASTER_REACH = 2000.0f;       // Depth past the slice's sphere, towards and away from the sun
+    static constexpr uint64_t SHADOW_SETTLE_PACKETS = 60;       // Packets a caster has to stand still before it joins the cache
+
+    struct ShadowCacheSettings {
+        float margin = 0.15f;                   // Padding around the slice's sphere, a share of its radius
+        float sunAngle = 0.1f;                  // Degrees the sun may turn before every cascade is refit
+    };
+
+    struct ShadowCacheStats {
+        uint32_t staticCasters = 0;             // Drawn into the cache layers
+        uint32_t dynamicCasters = 0;            // Drawn every frame
+        uint32_t refit = 0;                     // Cascades moved this packet
+        uint32_t rebuilt = 0;                   // Cache layers redrawn this packet, refits included
+        uint64_t totalRebuilds = 0;
+        uint32_t composited = 0;                // Layers the render thread refreshed, a frame late
+    };
+
+    class ShadowCascadeCache {
+    public:
+        // Light matrix of one cascade, for the camera slice with this inverse view-projection.
+        // lightDir points at the sun. A cascade that has to move is queued for a rebuild.
+        glm::mat4 Fit(uint32_t cascade, const glm::mat4& sliceInverse, const glm::vec3& lightDir,
+                      uint32_t shadowDim, const ShadowCacheSettings& settings);
+
+        // Depth bias is baked into the cached depth, a change redraws every layer
+        void SetBias(float constant, float slope);
+
+        void Invalidate(const glm::vec4& sphere);   // A static caster appeared, moved or left: every layer it reaches
+        void InvalidateAll();
+
+        // Cascades whose cache layer this packet redraws, bit per cascade. Clears the queue.
+        uint32_t TakeRebuildMask();
+        uint32_t TakeRefitCount();
+
+    private:
+        struct Cascade {
+            glm::mat4 lightView = glm::mat4(1.0f);
+            glm::mat4 matrix = glm::mat4(1.0f);
+            Frustum sides;                      // Side planes of matrix, what a caster's sphere is tested against
+            glm::vec3 lightDir = glm::vec3(0.0f);
+            glm::vec3 center = glm::vec3(0.0f); // Light space, snapped
+            float radius = 0.0f;                // Of the slice it was fit to
+            float extent = 0.0f;                // Half size, radius plus margin
+            bool valid = false;
+        };
+
+        Cascade cascades[SHADOW_CASCADE_COUNT];
+        uint32_t rebuild = 0;
+        uint32_t refit = 0;
+        glm::vec2 bias = glm::vec2(-1.0f);
+    };
+}
@@ -0,0 +1,379 @@
+#include "servers/rendering/UploadManager.hpp"
+
+#ifndef __EMSCRIPTEN__
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace Crescendo {
+
+    // Staging offsets for buffer copies need 4 bytes, image copies the texel size; 16 covers RGBA32F
+    static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+    bool UploadManager::Initialize(VkDevice device, VmaAllocator allocator, VkQueue transferQueue, uint32_t transferFamily,
+                                   uint32_t graphicsFamily, uint32_t framesInFlight, std::mutex* queueMutex) {
+        this->device = device;
+        this->allocator = allocator;
+        this->queue = transferQueue;
+        this->transferFamily = transferFamily;
+        this->graphicsFamily = graphicsFamily;
+        this->queueMutex = queueMutex;
+        dedicated = transferFamily != graphicsFamily;
+
+        VkSemaphoreTypeCreateInfo typeInfo{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+        VkSemaphoreCreateInfo semaphoreInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        semaphoreInfo.pNext = &typeInfo;
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &timeline) != VK_SUCCESS) {
+            std::cerr << "[Upload] Failed to create the timeline semaphore!" << std::endl;
+            return false;
+        }
+
+        // Mapped once for the whole run, VulkanBuffer::destroy unmaps it
+        ring = VulkanBuffer(allocator, RING_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+        if (vmaMapMemory(allocator, ring.allocation, reinterpret_cast<void**>(&ringData)) != VK_SUCCESS) return false;
+
+        for (Batch& batch : batches) {
+            VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = transferFamily;
+            if (vkCreateCommandPool(device, &poolInfo, nullptr, &batch.pool) != VK_SUCCESS) return false;
+
+            VkCommandBufferAllocateInfo allocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+            allocInfo.commandPool = batch.pool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(device, &allocInfo, &batch.cmd) != VK_SUCCESS) return false;
+        }
+
+        VkCommandPoolCreateInfo acquirePoolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        acquirePoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        acquirePoolInfo.queueFamilyIndex = graphicsFamily;
+        if (vkCreateCommandPool(device, &acquirePoolInfo, nullptr, &acquirePool) != VK_SUCCESS) return false;
+
+        acquireCmds.resize(framesInFlight);
+        VkCommandBufferAllocateInfo acquireAllocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        acquireAllocInfo.commandPool = acquirePool;
+        acquireAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        acquireAllocInfo.commandBufferCount = framesInFlight;
+        if (vkAllocateCommandBuffers(device, &acquireAllocInfo, acquireCmds.data()) != VK_SUCCESS) return false;
+
+        stats = UploadStats{};
+        stats.dedicatedQueue = dedicated;
+        stats.ringBytes = RING_SIZE;
+
+        std::cout << "[Upload] " << (RING_SIZE >> 20) << " MB staging ring, "
+                  << (dedicated ? "dedicated transfer queue" : "sharing the graphics queue") << std::endl;
+        return true;
+    }
+
+    void UploadManager::Shutdown() {
+        // The device is idle by now, whatever was in flight is done
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Batch& batch : batches) {
+            if (batch.pool != VK_NULL_HANDLE) vkDestroyCommandPool(device, batch.pool, nullptr);
+            batch = Batch{};
+        }
+        inFlight.clear();
+        if (acquirePool != VK_NULL_HANDLE) vkDestroyCommandPool(device, acquirePool, nullptr);
+        acquirePool = VK_NULL_HANDLE;
+        acquireCmds.clear();
+        pendingBufferAcquires.clear();
+        pendingImageAcquires.clear();
+
+        ring.destroy();
+        ringData = nullptr;
+        if (timeline != VK_NULL_HANDLE) vkDestroySemaphore(device, timeline, nullptr);
+        timeline = VK_NULL_HANDLE;
+    }
+
+    // --- Batches ---
+
+    UploadManager::Batch& UploadManager::OpenBatch() {
+        Batch& batch = batches[openSlot];
+        if (batch.recording) return batch;
+
+        // The slot's last batch went out BATCH_SLOTS submits ago, its commands have to be done before the reset
+        if (batch.value > retired) WaitForValue(batch.value);
+
+        vkResetCommandPool(device, batch.pool, 0);
+        VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(batch.cmd, &beginInfo);
+
+        batch.value = submitted + 1;
+        batch.ringEnd = ringHead;
+        batch.recording = true;
+        return batch;
+    }
+
+    void UploadManager::SubmitOpenBatch() {
+        Batch& batch = batches[openSlot];
+        if (!batch.recording) return;
+        vkEndCommandBuffer(batch.cmd);
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &batch.value;
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &batch.cmd;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &timeline;
+
+        VkResult result;
+        if (queueMutex) {
+            std::lock_guard<std::mutex> queueLock(*queueMutex);
+            result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+        } else {
+            result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+        }
+        if (result != VK_SUCCESS) std::cerr << "[Upload] Batch " << batch.value << " failed to submit (" << result << ")" << std::endl;
+
+        submitted = batch.value;
+        batch.recording = false;
+        pendingBufferAcquires.insert(pendingBufferAcquires.end(), batch.bufferAcquires.begin(), batch.bufferAcquires.end());
+        pendingImageAcquires.insert(pendingImageAcquires.end(), batch.imageAcquires.begin(), batch.imageAcquires.end());
+        batch.bufferAcquires.clear();
+        batch.imageAcquires.clear();
+
+        inFlight.push_back(openSlot);
+        openSlot = (openSlot + 1) % BATCH_SLOTS;
+        stats.batches++;
+    }
+
+    void UploadManager::Retire(uint64_t completed) {
+        while (!inFlight.empty() && batches[inFlight.front()].value <= completed) {
+            Batch& batch = batches[inFlight.front()];
+            ringTail = std::max(ringTail, batch.ringEnd);
+            batch.oversized.clear();
+            retired = batch.value;
+            inFlight.pop_front();
+        }
+    }
+
+    void UploadManager::WaitForValue(uint64_t value) {
+        VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &value;
+        vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+        Retire(value);
+    }
+
+    // --- Staging ---
+
+    void UploadManager::Stage(const void* data, VkDeviceSize size, VkBuffer& src, VkDeviceSize& srcOffset) {
+        // Past half the ring a single upload would keep the ring from overlapping with anything, it gets its own buffer
+        if (size > RING_SIZE / 2) {
+            VulkanBuffer staging(allocator, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+            void* mapped;
+            vmaMapMemory(allocator, staging.allocation, &mapped);
+            memcpy(mapped, data, static_cast<size_t>(size));
+            vmaFlushAllocation(allocator, staging.allocation, 0, size);
+            vmaUnmapMemory(allocator, staging.allocation);
+
+            src = staging.handle;
+            srcOffset = 0;
+            OpenBatch().oversized.push_back(std::move(staging));
+            stats.oversized++;
+            return;
+        }
+
+        uint64_t start = (ringHead + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+        // Never straddles the end, it starts over at the front instead
+        if (start % RING_SIZE + size > RING_SIZE) start += RING_SIZE - start % RING_SIZE;
+
+        if (start + size - ringTail > RING_SIZE) {
+            uint64_t completed = 0;
+            vkGetSemaphoreCounterValue(device, timeline, &completed);
+            Retire(completed);
+        }
+        while (start + size - ringTail > RING_SIZE) {
+            // Oldest batch first; when only the open one still holds the space it goes out now
+            if (inFlight.empty()) SubmitOpenBatch();
+            if (inFlight.empty()) break;
+            stats.ringStalls++;
+            WaitForValue(batches[inFlight.front()].value);
+        }
+
+        VkDeviceSize offset = start % RING_SIZE;
+        memcpy(ringData + offset, data, static_cast<size_t>(size));
+        vmaFlushAllocation(allocator, ring.allocation, offset, size);
+        ringHead = start + size;
+
+        src = ring.handle;
+        srcOffset = offset;
+    }
+
+    UploadTicket UploadManager::UploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size) {
+        if (dst == VK_NULL_HANDLE || size == 0) return UploadTicket{};
+        std::lock_guard<std::mutex> lock(mutex);
+
+        VkBuffer src;
+        VkDeviceSize srcOffset;
+        Stage(data, size, src, srcOffset);
+        Batch& batch = OpenBatch();
+
+        VkBufferCopy region{srcOffset, dstOffset, size};
+        vkCmdCopyBuffer(batch.cmd, src, dst, 1, &region);
+
+        if (dedicated) {
+            VkBufferMemoryBarrier release{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            release.dstAccessMask = 0;
+            release.srcQueueFamilyIndex = transferFamily;
+            release.dstQueueFamilyIndex = graphicsFamily;
+            release.buffer = dst;
+            release.offset = dstOffset;
+            release.size = size;
+            vkCmdPipelineBarrier(batch.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &release, 0, nullptr);
+
+            VkBufferMemoryBarrier acquire = release;
+            acquire.srcAccessMask = 0;
+            acquire.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+            batch.bufferAcquires.push_back(acquire);
+        }
+
+        batch.ringEnd = ringHead;
+        stats.uploads++;
+        stats.bytes += size;
+        return UploadTicket{ batch.value };
+    }
+
+    UploadTicket UploadManager::UploadImage(VkImage dst, uint32_t width, uint32_t height, const void* pixels, VkDeviceSize size) {
+        if (dst == VK_NULL_HANDLE || size == 0) return UploadTicket{};
+        std::lock_guard<std::mutex> lock(mutex);
+
+        VkBuffer src;
+        VkDeviceSize srcOffset;
+        Stage(pixels, size, src, srcOffset);
+        Batch& batch = OpenBatch();
+
+        VkImageMemoryBarrier toTransfer{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = dst;
+        toTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        toTransfer.srcAccessMask = 0;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(batch.cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = srcOffset;
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageExtent = { width, height, 1 };
+        vkCmdCopyBufferToImage(batch.cmd, src, dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        // The layout change rides on the release, the acquire repeats it on the graphics side
+        VkImageMemoryBarrier release = toTransfer;
+        release.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        release.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        release.dstAccessMask = 0;
+        if (dedicated) {
+            release.srcQueueFamilyIndex = transferFamily;
+            release.dstQueueFamilyIndex = graphicsFamily;
+        }
+        vkCmdPipelineBarrier(batch.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &release);
+
+        if (dedicated) {
+            VkImageMemoryBarrier acquire = release;
+            acquire.srcAccessMask = 0;
+            acquire.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            batch.imageAcquires.push_back(acquire);
+        }
+
+        batch.ringEnd = ringHead;
+        stats.uploads++;
+        stats.bytes += size;
+        return UploadTicket{ batch.value };
+    }
+
+    // --- Completion ---
+
+    void UploadManager::Wait(UploadTicket ticket) {
+        if (ticket.value == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ticket.value > submitted) SubmitOpenBatch();
+        }
+
+        // Not under the lock, the other writers carry on meanwhile
+        VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &ticket.value;
+        vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        Retire(ticket.value);
+    }
+
+    void UploadManager::WaitIdle() {
+        uint64_t last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            SubmitOpenBatch();
+            last = submitted;
+        }
+        Wait(UploadTicket{ last });
+    }
+
+    // --- Frame side ---
+
+    UploadManager::FrameSync UploadManager::PrepareFrame(uint32_t frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        SubmitOpenBatch();
+
+        uint64_t completed = 0;
+        vkGetSemaphoreCounterValue(device, timeline, &completed);
+        Retire(completed);
+
+        FrameSync sync;
+        sync.timeline = timeline;
+        sync.waitValue = submitted;
+
+        if (!pendingBufferAcquires.empty() || !pendingImageAcquires.empty()) {
+            VkCommandBuffer cmd = acquireCmds[frame];
+            vkResetCommandBuffer(cmd, 0);
+            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(cmd, &beginInfo);
+            RecordAcquiresLocked(cmd);
+            vkEndCommandBuffer(cmd);
+            sync.acquire = cmd;
+        }
+        return sync;
+    }
+
+    void UploadManager::RecordAcquires(VkCommandBuffer cmd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        RecordAcquiresLocked(cmd);
+    }
+
+    void UploadManager::RecordAcquiresLocked(VkCommandBuffer cmd) {
+        if (pendingBufferAcquires.empty() && pendingImageAcquires.empty()) return;
+
+        // Whatever reads the data next, vertex fetch, sampling or a copy, comes after this
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+                             static_cast<uint32_t>(pendingBufferAcquires.size()), pendingBufferAcquires.data(),
+                             static_cast<uint32_t>(pendingImageAcquires.size()), pendingImageAcquires.data());
+        pendingBufferAcquires.clear();
+        pendingImageAcquires.clear();
+    }
+
+    UploadStats UploadManager::Stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.ringBytesInFlight = ringHead - ringTail;
+        return stats;
+    }
+}
+
+#endif
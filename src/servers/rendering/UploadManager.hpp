@@ -0,0 +1,140 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#ifndef __EMSCRIPTEN__
+    #include "vulkan/VulkanResources.hpp"
+#endif
+
+namespace Crescendo {
+
+    // --- UPLOAD TICKET ---
+    // The timeline value of the batch that carries an upload. The data is on
+    // the GPU once the upload timeline reaches it; 0 means there was nothing
+    // to wait for (headless, or an empty upload).
+    struct UploadTicket {
+        uint64_t value = 0;
+    };
+
+    struct UploadStats {
+        bool dedicatedQueue = false;            // Copies run on a transfer-only queue family
+        uint64_t ringBytes = 0;                 // Staging ring capacity
+        uint64_t ringBytesInFlight = 0;         // Written and not yet retired
+        uint64_t bytes = 0;                     // Totals since start
+        uint64_t uploads = 0;
+        uint64_t batches = 0;
+        uint64_t oversized = 0;                 // Bigger than the ring allows, given their own staging buffer
+        uint64_t ringStalls = 0;                // Times a writer waited for the GPU to free ring space
+    };
+
+#ifndef __EMSCRIPTEN__
+
+    // =========================================================
+    // UPLOAD MANAGER
+    // Every host-to-device copy of mesh and texture data goes through
+    // one persistently mapped staging ring. A write lands in the ring
+    // straight away and its copy is recorded into the open batch; the
+    // batch goes out once per frame (or sooner, when the ring fills up
+    // or somebody waits on it) and signals the next value of a timeline
+    // semaphore. Nothing waits for a copy on the CPU unless it asks to.
+    //
+    // On a device with a transfer-only queue family the batches run
+    // there, beside the frame. The buffers and images they fill belong
+    // to the graphics family, so each copy ends with a queue ownership
+    // release; the matching acquires are recorded into a command buffer
+    // that goes in front of the next frame, which also waits on the
+    // timeline. Without such a family the batches share the graphics
+    // queue and only the wait remains.
+    // =========================================================
+
+    class UploadManager {
+    public:
+        static constexpr VkDeviceSize RING_SIZE = 32ull << 20;
+        static constexpr uint32_t BATCH_SLOTS = 8;                  // Batches in flight before a writer waits on the oldest
+
+        // transferQueue may be the graphics queue itself, then queueMutex guards every submit to it
+        bool Initialize(VkDevice device, VmaAllocator allocator, VkQueue transferQueue, uint32_t transferFamily,
+                        uint32_t graphicsFamily, uint32_t framesInFlight, std::mutex* queueMutex);
+        void Shutdown();
+
+        // Both copy the data before returning, the source can go straight away. Thread-safe.
+        // The destination has to stay alive until the ticket completes.
+        UploadTicket UploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+        // Mip 0, layer 0, the whole extent. The image ends up in SHADER_READ_ONLY_OPTIMAL.
+        UploadTicket UploadImage(VkImage dst, uint32_t width, uint32_t height, const void* pixels, VkDeviceSize size);
+
+        void Wait(UploadTicket ticket);         // Sends the ticket's batch out first if it is still open
+        void WaitIdle();                        // Every upload so far
+
+        // --- Frame side (render thread) ---
+        struct FrameSync {
+            VkCommandBuffer acquire = VK_NULL_HANDLE;   // Submit ahead of the frame's command buffer, when set
+            VkSemaphore timeline = VK_NULL_HANDLE;
+            uint64_t waitValue = 0;                     // The frame waits for the timeline to reach it, 0 = no wait
+        };
+        // Sends the open batch out and records the ownership acquires of everything sent since the last
+        // frame into this frame's command buffer. Call it just before the frame is submitted, with the
+        // frame's fence already waited on.
+        FrameSync PrepareFrame(uint32_t frame);
+
+        // Acquires still owed, for graphics work outside a frame (e.g. geometry compaction). Call after WaitIdle.
+        void RecordAcquires(VkCommandBuffer cmd);
+
+        UploadStats Stats();
+
+    private:
+        struct Batch {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            VkCommandBuffer cmd = VK_NULL_HANDLE;
+            uint64_t value = 0;                 // Timeline value it signals once submitted
+            uint64_t ringEnd = 0;               // Ring position after its last write, the tail moves here on retire
+            bool recording = false;
+            std::vector<VulkanBuffer> oversized;
+            std::vector<VkBufferMemoryBarrier> bufferAcquires;
+            std::vector<VkImageMemoryBarrier> imageAcquires;
+        };
+
+        // All of these expect the lock held. They wait on the GPU with it held too: only a full ring or
+        // every batch slot in flight gets them there, and then no other writer could go ahead anyway.
+        Batch& OpenBatch();
+        void SubmitOpenBatch();
+        void Retire(uint64_t completed);
+        void WaitForValue(uint64_t value);
+        void Stage(const void* data, VkDeviceSize size, VkBuffer& src, VkDeviceSize& srcOffset);
+        void RecordAcquiresLocked(VkCommandBuffer cmd);
+
+        VkDevice device = VK_NULL_HANDLE;
+        VmaAllocator allocator = nullptr;
+        VkQueue queue = VK_NULL_HANDLE;
+        uint32_t transferFamily = 0;
+        uint32_t graphicsFamily = 0;
+        std::mutex* queueMutex = nullptr;
+        bool dedicated = false;
+
+        std::mutex mutex;
+        VkSemaphore timeline = VK_NULL_HANDLE;
+        uint64_t submitted = 0;                 // Last value handed to a submit
+        uint64_t retired = 0;                   // Batches up to here have given their ring space back
+
+        VulkanBuffer ring;
+        char* ringData = nullptr;
+        uint64_t ringHead = 0;                  // Monotonic byte positions, the offset is position % RING_SIZE
+        uint64_t ringTail = 0;
+
+        Batch batches[BATCH_SLOTS];
+        uint32_t openSlot = 0;                  // Where the next batch is recorded
+        std::deque<uint32_t> inFlight;          // Submitted slots, oldest first
+
+        // Owed to the graphics family, recorded into the next frame
+        std::vector<VkBufferMemoryBarrier> pendingBufferAcquires;
+        std::vector<VkImageMemoryBarrier> pendingImageAcquires;
+        VkCommandPool acquirePool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> acquireCmds;  // One per frame in flight
+
+        UploadStats stats;
+    };
+
+#endif
+}
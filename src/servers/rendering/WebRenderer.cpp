@@ -25,7 +25,11 @@ namespace Crescendo {
         std::cout << "[WebRenderer] Shutting down WebGL context." << std::endl;
     }
 
-    void WebRenderer::render(Scene* scene, SceneManager* sceneManager, EngineState& engineState) {
+    void WebRenderer::buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) {
+        packet.Reset();
+    }
+
+    void WebRenderer::renderPacket(RenderPacket& packet) {
 #ifdef __EMSCRIPTEN__
         // For phase 1, just clear the screen so we know it works!
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -38,4 +42,9 @@ namespace Crescendo {
         ChunkBakeResult emptyResult;
         return emptyResult;
     }
+
+    int WebRenderer::adoptMesh(MeshResource&& mesh) {
+        // Nothing is ever baked on the web yet, see buildChunkMesh
+        return -1;
+    }
 }
\ No newline at end of file
@@ -9,7 +9,9 @@ namespace Crescendo {
 
         bool initialize(DisplayServer* display) override;
         void shutdown() override;
-        void render(Scene* scene, SceneManager* sceneManager, EngineState& engineState) override;
+        void buildPacket(Scene* scene, SceneManager* sceneManager, Camera& camera, EngineState& engineState, RenderPacket& packet) override;
+        void renderPacket(RenderPacket& packet) override;
         ChunkBakeResult buildChunkMesh(const TerrainComputePush& pushData, bool needsCollision) override;
+        int adoptMesh(MeshResource&& mesh) override;
     };
 }
\ No newline at end of file